@@ -0,0 +1,263 @@
+#ifndef BL_AABB_HPP
+#define BL_AABB_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blAABB.hpp
+// CLASS:           blAABB
+// BASE CLASS:      None
+//
+// PURPOSE:         An axis aligned bounding box in system coordinates
+//                  used by the broadphase to find bodies that might
+//                  be touching
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blMathAPI::blVector3d
+//                  - blRigidBody
+//
+// NOTES:           - A rigid body's box is built from its size (taken
+//                    as the full dimensions of the body along its
+//                    x,y,z axes) and its current orientation axes
+//                  - Boxes that only touch are considered overlapping
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blAABB
+{
+public: // Public typedefs
+
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blAABB(const blVectorType& lowerBound = blVectorType(0,0,0),
+           const blVectorType& upperBound = blVectorType(0,0,0));
+
+    // Destructor
+
+    ~blAABB()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // set/get the bounds
+
+    void                                                setBounds(const blVectorType& lowerBound,
+                                                                  const blVectorType& upperBound);
+
+    const blVectorType&                                 getLowerBound()const;
+    const blVectorType&                                 getUpperBound()const;
+
+    // Function used to
+    // fit the box around
+    // a rigid body
+
+    void                                                setFromRigidBody(const blRigidBody<blDataType>& rigidBody);
+
+    // Functions used to
+    // test this box against
+    // another box
+
+    bool                                                overlaps(const blAABB<blDataType>& aabb)const;
+    bool                                                contains(const blAABB<blDataType>& aabb)const;
+
+    // Functions used to
+    // grow this box
+
+    void                                                merge(const blAABB<blDataType>& aabb);
+    void                                                fatten(const blDataType& margin);
+
+    // Functions used to
+    // get the box's center,
+    // half extents and
+    // surface area
+
+    blVectorType                                        getCenter()const;
+    blVectorType                                        getHalfExtents()const;
+    blDataType                                          getSurfaceArea()const;
+
+private: // Private variables
+
+    // The box's corners
+
+    blVectorType                                        m_lowerBound;
+    blVectorType                                        m_upperBound;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blAABB<blDataType>::blAABB(const blVectorType& lowerBound,
+                                  const blVectorType& upperBound)
+{
+    setBounds(lowerBound,upperBound);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blAABB<blDataType>::setBounds(const blVectorType& lowerBound,
+                                          const blVectorType& upperBound)
+{
+    m_lowerBound = lowerBound;
+    m_upperBound = upperBound;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const typename blAABB<blDataType>::blVectorType& blAABB<blDataType>::getLowerBound()const
+{
+    return m_lowerBound;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const typename blAABB<blDataType>::blVectorType& blAABB<blDataType>::getUpperBound()const
+{
+    return m_upperBound;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blAABB<blDataType>::setFromRigidBody(const blRigidBody<blDataType>& rigidBody)
+{
+    // Half the size of
+    // the body along its
+    // own axes
+
+    blDataType hx = blDataType(0.5) * rigidBody.getSize().x();
+    blDataType hy = blDataType(0.5) * rigidBody.getSize().y();
+    blDataType hz = blDataType(0.5) * rigidBody.getSize().z();
+
+    const blVectorType& xAxis = rigidBody.getxAxis();
+    const blVectorType& yAxis = rigidBody.getyAxis();
+    const blVectorType& zAxis = rigidBody.getzAxis();
+
+    // Project the oriented
+    // box onto the system
+    // axes
+
+    blVectorType halfExtents(std::abs(xAxis.x()) * hx + std::abs(yAxis.x()) * hy + std::abs(zAxis.x()) * hz,
+                             std::abs(xAxis.y()) * hx + std::abs(yAxis.y()) * hy + std::abs(zAxis.y()) * hz,
+                             std::abs(xAxis.z()) * hx + std::abs(yAxis.z()) * hy + std::abs(zAxis.z()) * hz);
+
+    m_lowerBound = rigidBody.getPosition() - halfExtents;
+    m_upperBound = rigidBody.getPosition() + halfExtents;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blAABB<blDataType>::overlaps(const blAABB<blDataType>& aabb)const
+{
+    return m_lowerBound.x() <= aabb.m_upperBound.x() && aabb.m_lowerBound.x() <= m_upperBound.x() &&
+           m_lowerBound.y() <= aabb.m_upperBound.y() && aabb.m_lowerBound.y() <= m_upperBound.y() &&
+           m_lowerBound.z() <= aabb.m_upperBound.z() && aabb.m_lowerBound.z() <= m_upperBound.z();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blAABB<blDataType>::contains(const blAABB<blDataType>& aabb)const
+{
+    return m_lowerBound.x() <= aabb.m_lowerBound.x() && aabb.m_upperBound.x() <= m_upperBound.x() &&
+           m_lowerBound.y() <= aabb.m_lowerBound.y() && aabb.m_upperBound.y() <= m_upperBound.y() &&
+           m_lowerBound.z() <= aabb.m_lowerBound.z() && aabb.m_upperBound.z() <= m_upperBound.z();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blAABB<blDataType>::merge(const blAABB<blDataType>& aabb)
+{
+    m_lowerBound = blVectorType(std::min(m_lowerBound.x(),aabb.m_lowerBound.x()),
+                                std::min(m_lowerBound.y(),aabb.m_lowerBound.y()),
+                                std::min(m_lowerBound.z(),aabb.m_lowerBound.z()));
+
+    m_upperBound = blVectorType(std::max(m_upperBound.x(),aabb.m_upperBound.x()),
+                                std::max(m_upperBound.y(),aabb.m_upperBound.y()),
+                                std::max(m_upperBound.z(),aabb.m_upperBound.z()));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blAABB<blDataType>::fatten(const blDataType& margin)
+{
+    m_lowerBound -= blVectorType(margin,margin,margin);
+    m_upperBound += blVectorType(margin,margin,margin);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blAABB<blDataType>::blVectorType blAABB<blDataType>::getCenter()const
+{
+    return (m_lowerBound + m_upperBound) * blDataType(0.5);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blAABB<blDataType>::blVectorType blAABB<blDataType>::getHalfExtents()const
+{
+    return (m_upperBound - m_lowerBound) * blDataType(0.5);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blDataType blAABB<blDataType>::getSurfaceArea()const
+{
+    blVectorType dimensions = m_upperBound - m_lowerBound;
+
+    return blDataType(2) * (dimensions.x() * dimensions.y() +
+                            dimensions.y() * dimensions.z() +
+                            dimensions.z() * dimensions.x());
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_AABB_HPP
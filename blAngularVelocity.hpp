@@ -67,6 +67,18 @@ public: // Constructors and destructors
     template<typename blDataType2>
     blAngularVelocity(const blAngularVelocity<blDataType2>& angularVelocity);
 
+    // Copy and move
+    // constructors
+
+    blAngularVelocity(const blAngularVelocity<blDataType>& angularVelocity) = default;
+    blAngularVelocity(blAngularVelocity<blDataType>&& angularVelocity) = default;
+
+    // Copy and move
+    // assignments
+
+    blAngularVelocity<blDataType>&                      operator=(const blAngularVelocity<blDataType>& angularVelocity) = default;
+    blAngularVelocity<blDataType>&                      operator=(blAngularVelocity<blDataType>&& angularVelocity) = default;
+
     // Destructor
 
     ~blAngularVelocity()
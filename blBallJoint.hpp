@@ -0,0 +1,130 @@
+#ifndef BL_BALLJOINT_HPP
+#define BL_BALLJOINT_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blBallJoint.hpp
+// CLASS:           blBallJoint
+// BASE CLASS:      blConnection
+//
+// PURPOSE:         Based on blConnection, a joint that pins the
+//                  connection positions of two rigid bodies together
+//                  while letting them turn freely about that point
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blConnection and all its dependencies
+//
+// NOTES:           - A joint doesn't produce any force, it is held
+//                    together by the impulses of blConstraintSolver,
+//                    which keeps the last step's impulse in the joint
+//                    to start the next step from it
+//                  - The connection positions are in body coordinates
+//                    like every other connection
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blBallJoint : public blConnection<blDataType>
+{
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blBallJoint(const typename blConnection<blDataType>::blBodyHandle& rigidBody1Handle = blRigidBodyTable<blDataType>::getNullHandle(),
+                const typename blConnection<blDataType>::blBodyHandle& rigidBody2Handle = blRigidBodyTable<blDataType>::getNullHandle(),
+                const blMathAPI::blVector3d<blDataType>& rigidBody1ConnectionPosition = blMathAPI::blVector3d<blDataType>(0,0,0),
+                const blMathAPI::blVector3d<blDataType>& rigidBody2ConnectionPosition = blMathAPI::blVector3d<blDataType>(0,0,0))
+                : blConnection<blDataType>(rigidBody1Handle,
+                                           rigidBody2Handle,
+                                           rigidBody1ConnectionPosition,
+                                           rigidBody2ConnectionPosition),
+                  m_accumulatedImpulse(0,0,0)
+    {
+    }
+
+    // Copy constructor
+
+    blBallJoint(const blBallJoint<blDataType>& ballJoint)
+                : blConnection<blDataType>(ballJoint),
+                  m_accumulatedImpulse(ballJoint.getAccumulatedImpulse())
+    {
+    }
+
+    // Move constructor
+
+    blBallJoint(blBallJoint<blDataType>&& ballJoint) = default;
+
+    // Copy and move
+    // assignments
+
+    blBallJoint<blDataType>&                        operator=(const blBallJoint<blDataType>& ballJoint) = default;
+    blBallJoint<blDataType>&                        operator=(blBallJoint<blDataType>&& ballJoint) = default;
+
+    // Destructor
+
+    ~blBallJoint()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // set/get the impulse
+    // applied by the solver
+    // during the last step
+
+    void                                            setAccumulatedImpulse(const blMathAPI::blVector3d<blDataType>& accumulatedImpulse);
+    const blMathAPI::blVector3d<blDataType>&        getAccumulatedImpulse()const;
+
+protected: // Protected variables
+
+    // The impulse applied to
+    // the second body (the first
+    // body gets the opposite)
+
+    blMathAPI::blVector3d<blDataType>               m_accumulatedImpulse;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBallJoint<blDataType>::setAccumulatedImpulse(const blMathAPI::blVector3d<blDataType>& accumulatedImpulse)
+{
+    m_accumulatedImpulse = accumulatedImpulse;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blMathAPI::blVector3d<blDataType>& blBallJoint<blDataType>::getAccumulatedImpulse()const
+{
+    return m_accumulatedImpulse;
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_BALLJOINT_HPP
@@ -0,0 +1,937 @@
+#ifndef BL_BATCHINTEGRATOR_HPP
+#define BL_BATCHINTEGRATOR_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blBatchIntegrator.hpp
+// CLASS:           blBatchIntegrator
+// BASE CLASS:      None
+//
+// PURPOSE:         Batch integration kernels that advance a whole
+//                  range of bodies stored in structure-of-arrays
+//                  form per call, using AVX2/SSE2 registers when
+//                  available and scalar code otherwise
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blSimdPack, blScalarPack
+//                  - blVector3dArray, blQuaternionArray, blMatrix3dArray
+//
+// NOTES:           - Every kernel works on the range [beginIndex,endIndex)
+//                    so that a batch can be split between threads
+//                  - The body of every kernel is written once as a
+//                    template over the pack type, the full registers
+//                    go through blSimdPack and the leftover bodies
+//                    go through blScalarPack
+//                  - The orientation kernel builds the step quaternion
+//                    (cos(h),w*sin(h)/|w|) with h = |w|*dt/2 from the
+//                    power series of cos(h) and sin(h)/h in h*h, so it
+//                    needs neither trig functions nor |w|, and then
+//                    re-normalizes the rotation quaternion
+//                  - With a constant acceleration over the step, the
+//                    four stages of blRigidBody::calculateNewStateUsingRK4
+//                    collapse to p += v*dt + a*dt*dt/2, which is what
+//                    integratePositionsRK4 computes
+//                  - The angular velocity kernel works with inertias
+//                    in system coordinates, calculateWorldInertias
+//                    turns the body inertias into R*I*R^T and
+//                    R*I^-1*R^T for all the bodies in one pass, with R
+//                    built from the (unit) rotation quaternions
+//                  - The damping kernel scales the velocities by
+//                    exp(-c*dt/m) and the angular velocities, along
+//                    the body axes, by exp(-c*dt/I) with I the body's
+//                    moment about each axis (taken from the diagonal
+//                    of its inverse inertia, exact for principal axes),
+//                    exp(-x) is evaluated as (1/P(x/16))^16 with P the
+//                    power series of exp up to x^5, so the factors are
+//                    always within (0,1] and the damping can never
+//                    overshoot, negative coefficients count as zero
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blBatchIntegrator
+{
+public: // Public typedefs
+
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+
+    typedef blSimdPack<blDataType>                      blPackType;
+    typedef blScalarPack<blDataType>                    blTailPackType;
+
+public: // Public functions
+
+    // Function used to
+    // integrate positions
+    // p += v*dt
+
+    static void                                         integratePositions(blVector3dArray<blDataType>& positions,
+                                                                           const blVector3dArray<blDataType>& velocities,
+                                                                           const blDataType& dt,
+                                                                           const std::size_t& beginIndex,
+                                                                           const std::size_t& endIndex);
+
+    // Function used to
+    // integrate positions
+    // with the RK4 method
+    // for a constant
+    // acceleration
+    // p += v*dt + a*dt*dt/2
+
+    static void                                         integratePositionsRK4(blVector3dArray<blDataType>& positions,
+                                                                              const blVector3dArray<blDataType>& velocities,
+                                                                              const blVector3dArray<blDataType>& forces,
+                                                                              const std::vector<blDataType>& inverseMasses,
+                                                                              const blVectorType& accelerationField,
+                                                                              const blDataType& dt,
+                                                                              const std::size_t& beginIndex,
+                                                                              const std::size_t& endIndex);
+
+    // Function used to
+    // integrate velocities
+    // v += (F/m + g)*dt
+
+    static void                                         integrateVelocities(blVector3dArray<blDataType>& velocities,
+                                                                            const blVector3dArray<blDataType>& forces,
+                                                                            const std::vector<blDataType>& inverseMasses,
+                                                                            const blVectorType& accelerationField,
+                                                                            const blDataType& dt,
+                                                                            const std::size_t& beginIndex,
+                                                                            const std::size_t& endIndex);
+
+    // Function used to
+    // rotate the bodies
+    // by their angular
+    // velocities
+
+    static void                                         integrateOrientations(blQuaternionArray<blDataType>& rotQtns,
+                                                                              const blVector3dArray<blDataType>& angularVelocities,
+                                                                              const blDataType& dt,
+                                                                              const std::size_t& beginIndex,
+                                                                              const std::size_t& endIndex);
+
+    // Function used to
+    // calculate the inertias
+    // and inverse inertias in
+    // system coordinates from
+    // the body ones and the
+    // orientations
+
+    static void                                         calculateWorldInertias(const blQuaternionArray<blDataType>& rotQtns,
+                                                                               const blMatrix3dArray<blDataType>& inertias,
+                                                                               const blMatrix3dArray<blDataType>& inertiaInverses,
+                                                                               blMatrix3dArray<blDataType>& worldInertias,
+                                                                               blMatrix3dArray<blDataType>& worldInertiaInverses,
+                                                                               const std::size_t& beginIndex,
+                                                                               const std::size_t& endIndex);
+
+    // Function used to
+    // integrate angular
+    // velocities including
+    // the gyroscopic term
+    // w += Iinv*(T - w x (I*w))*dt,
+    // with the inertias in
+    // system coordinates
+
+    static void                                         integrateAngularVelocities(blVector3dArray<blDataType>& angularVelocities,
+                                                                                   const blVector3dArray<blDataType>& torques,
+                                                                                   const blMatrix3dArray<blDataType>& inertias,
+                                                                                   const blMatrix3dArray<blDataType>& inertiaInverses,
+                                                                                   const blDataType& dt,
+                                                                                   const std::size_t& beginIndex,
+                                                                                   const std::size_t& endIndex);
+
+    // Function used to
+    // damp the velocities
+    // and angular velocities
+    // exactly over a step
+    // v *= exp(-c*dt/m)
+
+    static void                                         integrateDamping(blVector3dArray<blDataType>& velocities,
+                                                                         blVector3dArray<blDataType>& angularVelocities,
+                                                                         const blQuaternionArray<blDataType>& rotQtns,
+                                                                         const std::vector<blDataType>& inverseMasses,
+                                                                         const blMatrix3dArray<blDataType>& inertiaInverses,
+                                                                         const std::vector<blDataType>& dampingCoefficients,
+                                                                         const std::vector<blDataType>& angularDampingCoefficients,
+                                                                         const blDataType& dt,
+                                                                         const std::size_t& beginIndex,
+                                                                         const std::size_t& endIndex);
+
+protected: // Protected functions
+
+    // The kernels written
+    // once for any pack
+    // type, each one
+    // processes the bodies
+    // starting at index i
+
+    template<typename blPack>
+    static void                                         positionsKernel(blDataType* px,blDataType* py,blDataType* pz,
+                                                                        const blDataType* vx,const blDataType* vy,const blDataType* vz,
+                                                                        const blDataType& dt,
+                                                                        const std::size_t& i);
+
+    template<typename blPack>
+    static void                                         positionsRK4Kernel(blDataType* px,blDataType* py,blDataType* pz,
+                                                                           const blDataType* vx,const blDataType* vy,const blDataType* vz,
+                                                                           const blDataType* fx,const blDataType* fy,const blDataType* fz,
+                                                                           const blDataType* invMass,
+                                                                           const blVectorType& g,
+                                                                           const blDataType& dt,
+                                                                           const std::size_t& i);
+
+    template<typename blPack>
+    static void                                         velocitiesKernel(blDataType* vx,blDataType* vy,blDataType* vz,
+                                                                         const blDataType* fx,const blDataType* fy,const blDataType* fz,
+                                                                         const blDataType* invMass,
+                                                                         const blVectorType& g,
+                                                                         const blDataType& dt,
+                                                                         const std::size_t& i);
+
+    template<typename blPack>
+    static void                                         orientationsKernel(blDataType* qw,blDataType* qx,blDataType* qy,blDataType* qz,
+                                                                           const blDataType* wx,const blDataType* wy,const blDataType* wz,
+                                                                           const blDataType& dt,
+                                                                           const std::size_t& i);
+
+    template<typename blPack>
+    static void                                         angularVelocitiesKernel(blDataType* wx,blDataType* wy,blDataType* wz,
+                                                                                const blDataType* tx,const blDataType* ty,const blDataType* tz,
+                                                                                const blDataType* const* I,
+                                                                                const blDataType* const* Iinv,
+                                                                                const blDataType& dt,
+                                                                                const std::size_t& i);
+
+    template<typename blPack>
+    static void                                         dampingKernel(blDataType* vx,blDataType* vy,blDataType* vz,
+                                                                      blDataType* wx,blDataType* wy,blDataType* wz,
+                                                                      const blDataType* qw,const blDataType* qx,const blDataType* qy,const blDataType* qz,
+                                                                      const blDataType* invMass,
+                                                                      const blDataType* const* Iinv,
+                                                                      const blDataType* c,
+                                                                      const blDataType* angularC,
+                                                                      const blDataType& dt,
+                                                                      const std::size_t& i);
+
+    template<typename blPack>
+    static void                                         worldInertiasKernel(const blDataType* qw,const blDataType* qx,const blDataType* qy,const blDataType* qz,
+                                                                            const blDataType* const* I,
+                                                                            const blDataType* const* Iinv,
+                                                                            blDataType* const* worldI,
+                                                                            blDataType* const* worldIinv,
+                                                                            const std::size_t& i);
+
+    // Function used to
+    // build the rotation
+    // matrices of unit
+    // quaternions
+
+    template<typename blPack>
+    static void                                         rotationMatricesKernel(const typename blPack::blRegisterType& w,
+                                                                               const typename blPack::blRegisterType& x,
+                                                                               const typename blPack::blRegisterType& y,
+                                                                               const typename blPack::blRegisterType& z,
+                                                                               typename blPack::blRegisterType (&rotation)[9]);
+
+    // Function used to
+    // calculate exp(-x)
+    // for x >= 0, always
+    // within (0,1]
+
+    template<typename blPack>
+    static typename blPack::blRegisterType              decayKernel(const typename blPack::blRegisterType& x);
+
+    // Function used to
+    // calculate R*A*R^T
+    // for the matrices
+    // starting at index i
+
+    template<typename blPack>
+    static void                                         rotateMatricesKernel(const typename blPack::blRegisterType (&rotation)[9],
+                                                                             const blDataType* const* A,
+                                                                             blDataType* const* rotatedA,
+                                                                             const std::size_t& i);
+
+    // Functions used to
+    // get the nine element
+    // arrays of a matrix
+    // array
+
+    static void                                         getElementPointers(const blMatrix3dArray<blDataType>& matrices,
+                                                                           const blDataType* elements[9]);
+    static void                                         getElementPointers(blMatrix3dArray<blDataType>& matrices,
+                                                                           blDataType* elements[9]);
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBatchIntegrator<blDataType>::getElementPointers(const blMatrix3dArray<blDataType>& matrices,
+                                                              const blDataType* elements[9])
+{
+    for(int row = 0; row < 3; ++row)
+        for(int col = 0; col < 3; ++col)
+            elements[3*row + col] = matrices.element(row,col).data();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBatchIntegrator<blDataType>::getElementPointers(blMatrix3dArray<blDataType>& matrices,
+                                                              blDataType* elements[9])
+{
+    for(int row = 0; row < 3; ++row)
+        for(int col = 0; col < 3; ++col)
+            elements[3*row + col] = matrices.element(row,col).data();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline void blBatchIntegrator<blDataType>::positionsKernel(blDataType* px,blDataType* py,blDataType* pz,
+                                                           const blDataType* vx,const blDataType* vy,const blDataType* vz,
+                                                           const blDataType& dt,
+                                                           const std::size_t& i)
+{
+    typedef typename blPack::blRegisterType R;
+
+    R DT = blPack::set1(dt);
+
+    blPack::store(px + i,blPack::mulAdd(blPack::load(vx + i),DT,blPack::load(px + i)));
+    blPack::store(py + i,blPack::mulAdd(blPack::load(vy + i),DT,blPack::load(py + i)));
+    blPack::store(pz + i,blPack::mulAdd(blPack::load(vz + i),DT,blPack::load(pz + i)));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBatchIntegrator<blDataType>::integratePositions(blVector3dArray<blDataType>& positions,
+                                                              const blVector3dArray<blDataType>& velocities,
+                                                              const blDataType& dt,
+                                                              const std::size_t& beginIndex,
+                                                              const std::size_t& endIndex)
+{
+    blDataType* px = positions.x().data();
+    blDataType* py = positions.y().data();
+    blDataType* pz = positions.z().data();
+
+    const blDataType* vx = velocities.x().data();
+    const blDataType* vy = velocities.y().data();
+    const blDataType* vz = velocities.z().data();
+
+    std::size_t i = beginIndex;
+
+    for(; i + blPackType::width <= endIndex; i += blPackType::width)
+        positionsKernel<blPackType>(px,py,pz,vx,vy,vz,dt,i);
+
+    for(; i < endIndex; ++i)
+        positionsKernel<blTailPackType>(px,py,pz,vx,vy,vz,dt,i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline void blBatchIntegrator<blDataType>::positionsRK4Kernel(blDataType* px,blDataType* py,blDataType* pz,
+                                                              const blDataType* vx,const blDataType* vy,const blDataType* vz,
+                                                              const blDataType* fx,const blDataType* fy,const blDataType* fz,
+                                                              const blDataType* invMass,
+                                                              const blVectorType& g,
+                                                              const blDataType& dt,
+                                                              const std::size_t& i)
+{
+    typedef typename blPack::blRegisterType R;
+
+    R DT = blPack::set1(dt);
+    R HALFDT2 = blPack::set1(blDataType(0.5)*dt*dt);
+    R M = blPack::load(invMass + i);
+
+    // a = F/m + g
+
+    R ax = blPack::mulAdd(blPack::load(fx + i),M,blPack::set1(g.x()));
+    R ay = blPack::mulAdd(blPack::load(fy + i),M,blPack::set1(g.y()));
+    R az = blPack::mulAdd(blPack::load(fz + i),M,blPack::set1(g.z()));
+
+    // p += v*dt + a*dt*dt/2
+
+    blPack::store(px + i,blPack::add(blPack::load(px + i),blPack::mulAdd(blPack::load(vx + i),DT,blPack::mul(ax,HALFDT2))));
+    blPack::store(py + i,blPack::add(blPack::load(py + i),blPack::mulAdd(blPack::load(vy + i),DT,blPack::mul(ay,HALFDT2))));
+    blPack::store(pz + i,blPack::add(blPack::load(pz + i),blPack::mulAdd(blPack::load(vz + i),DT,blPack::mul(az,HALFDT2))));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBatchIntegrator<blDataType>::integratePositionsRK4(blVector3dArray<blDataType>& positions,
+                                                                 const blVector3dArray<blDataType>& velocities,
+                                                                 const blVector3dArray<blDataType>& forces,
+                                                                 const std::vector<blDataType>& inverseMasses,
+                                                                 const blVectorType& accelerationField,
+                                                                 const blDataType& dt,
+                                                                 const std::size_t& beginIndex,
+                                                                 const std::size_t& endIndex)
+{
+    blDataType* px = positions.x().data();
+    blDataType* py = positions.y().data();
+    blDataType* pz = positions.z().data();
+
+    const blDataType* vx = velocities.x().data();
+    const blDataType* vy = velocities.y().data();
+    const blDataType* vz = velocities.z().data();
+
+    const blDataType* fx = forces.x().data();
+    const blDataType* fy = forces.y().data();
+    const blDataType* fz = forces.z().data();
+
+    const blDataType* invMass = inverseMasses.data();
+
+    std::size_t i = beginIndex;
+
+    for(; i + blPackType::width <= endIndex; i += blPackType::width)
+        positionsRK4Kernel<blPackType>(px,py,pz,vx,vy,vz,fx,fy,fz,invMass,accelerationField,dt,i);
+
+    for(; i < endIndex; ++i)
+        positionsRK4Kernel<blTailPackType>(px,py,pz,vx,vy,vz,fx,fy,fz,invMass,accelerationField,dt,i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline void blBatchIntegrator<blDataType>::velocitiesKernel(blDataType* vx,blDataType* vy,blDataType* vz,
+                                                            const blDataType* fx,const blDataType* fy,const blDataType* fz,
+                                                            const blDataType* invMass,
+                                                            const blVectorType& g,
+                                                            const blDataType& dt,
+                                                            const std::size_t& i)
+{
+    typedef typename blPack::blRegisterType R;
+
+    R DT = blPack::set1(dt);
+    R M = blPack::load(invMass + i);
+
+    R ax = blPack::mulAdd(blPack::load(fx + i),M,blPack::set1(g.x()));
+    R ay = blPack::mulAdd(blPack::load(fy + i),M,blPack::set1(g.y()));
+    R az = blPack::mulAdd(blPack::load(fz + i),M,blPack::set1(g.z()));
+
+    blPack::store(vx + i,blPack::mulAdd(ax,DT,blPack::load(vx + i)));
+    blPack::store(vy + i,blPack::mulAdd(ay,DT,blPack::load(vy + i)));
+    blPack::store(vz + i,blPack::mulAdd(az,DT,blPack::load(vz + i)));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBatchIntegrator<blDataType>::integrateVelocities(blVector3dArray<blDataType>& velocities,
+                                                               const blVector3dArray<blDataType>& forces,
+                                                               const std::vector<blDataType>& inverseMasses,
+                                                               const blVectorType& accelerationField,
+                                                               const blDataType& dt,
+                                                               const std::size_t& beginIndex,
+                                                               const std::size_t& endIndex)
+{
+    blDataType* vx = velocities.x().data();
+    blDataType* vy = velocities.y().data();
+    blDataType* vz = velocities.z().data();
+
+    const blDataType* fx = forces.x().data();
+    const blDataType* fy = forces.y().data();
+    const blDataType* fz = forces.z().data();
+
+    const blDataType* invMass = inverseMasses.data();
+
+    std::size_t i = beginIndex;
+
+    for(; i + blPackType::width <= endIndex; i += blPackType::width)
+        velocitiesKernel<blPackType>(vx,vy,vz,fx,fy,fz,invMass,accelerationField,dt,i);
+
+    for(; i < endIndex; ++i)
+        velocitiesKernel<blTailPackType>(vx,vy,vz,fx,fy,fz,invMass,accelerationField,dt,i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline void blBatchIntegrator<blDataType>::orientationsKernel(blDataType* qw,blDataType* qx,blDataType* qy,blDataType* qz,
+                                                              const blDataType* wx,const blDataType* wy,const blDataType* wz,
+                                                              const blDataType& dt,
+                                                              const std::size_t& i)
+{
+    typedef typename blPack::blRegisterType R;
+
+    R Wx = blPack::load(wx + i);
+    R Wy = blPack::load(wy + i);
+    R Wz = blPack::load(wz + i);
+
+    // h^2 = |w|^2 * dt^2 / 4
+
+    R h2 = blPack::mul(blPack::mulAdd(Wx,Wx,blPack::mulAdd(Wy,Wy,blPack::mul(Wz,Wz))),
+                       blPack::set1(blDataType(0.25)*dt*dt));
+
+    // cos(h) and sin(h)/h
+    // evaluated with Horner's
+    // method in h^2
+
+    R cosH = blPack::mulAdd(h2,blPack::set1(blDataType(1.0/40320.0)),blPack::set1(blDataType(-1.0/720.0)));
+    cosH = blPack::mulAdd(h2,cosH,blPack::set1(blDataType(1.0/24.0)));
+    cosH = blPack::mulAdd(h2,cosH,blPack::set1(blDataType(-0.5)));
+    cosH = blPack::mulAdd(h2,cosH,blPack::set1(blDataType(1)));
+
+    R sincH = blPack::mulAdd(h2,blPack::set1(blDataType(1.0/362880.0)),blPack::set1(blDataType(-1.0/5040.0)));
+    sincH = blPack::mulAdd(h2,sincH,blPack::set1(blDataType(1.0/120.0)));
+    sincH = blPack::mulAdd(h2,sincH,blPack::set1(blDataType(-1.0/6.0)));
+    sincH = blPack::mulAdd(h2,sincH,blPack::set1(blDataType(1)));
+
+    // sin(h)/|w| = sinc(h)*dt/2
+
+    R s = blPack::mul(sincH,blPack::set1(blDataType(0.5)*dt));
+
+    R dw = cosH;
+    R dx = blPack::mul(Wx,s);
+    R dy = blPack::mul(Wy,s);
+    R dz = blPack::mul(Wz,s);
+
+    // Pre-multiply the
+    // current rotation
+
+    R Qw = blPack::load(qw + i);
+    R Qx = blPack::load(qx + i);
+    R Qy = blPack::load(qy + i);
+    R Qz = blPack::load(qz + i);
+
+    R nw = blPack::sub(blPack::mul(dw,Qw),blPack::mulAdd(dx,Qx,blPack::mulAdd(dy,Qy,blPack::mul(dz,Qz))));
+    R nx = blPack::sub(blPack::mulAdd(dw,Qx,blPack::mulAdd(dx,Qw,blPack::mul(dy,Qz))),blPack::mul(dz,Qy));
+    R ny = blPack::sub(blPack::mulAdd(dw,Qy,blPack::mulAdd(dy,Qw,blPack::mul(dz,Qx))),blPack::mul(dx,Qz));
+    R nz = blPack::sub(blPack::mulAdd(dw,Qz,blPack::mulAdd(dz,Qw,blPack::mul(dx,Qy))),blPack::mul(dy,Qx));
+
+    // Re-normalize to
+    // avoid drift
+
+    R norm = blPack::sqrt(blPack::mulAdd(nw,nw,blPack::mulAdd(nx,nx,blPack::mulAdd(ny,ny,blPack::mul(nz,nz)))));
+
+    blPack::store(qw + i,blPack::div(nw,norm));
+    blPack::store(qx + i,blPack::div(nx,norm));
+    blPack::store(qy + i,blPack::div(ny,norm));
+    blPack::store(qz + i,blPack::div(nz,norm));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBatchIntegrator<blDataType>::integrateOrientations(blQuaternionArray<blDataType>& rotQtns,
+                                                                 const blVector3dArray<blDataType>& angularVelocities,
+                                                                 const blDataType& dt,
+                                                                 const std::size_t& beginIndex,
+                                                                 const std::size_t& endIndex)
+{
+    blDataType* qw = rotQtns.w().data();
+    blDataType* qx = rotQtns.x().data();
+    blDataType* qy = rotQtns.y().data();
+    blDataType* qz = rotQtns.z().data();
+
+    const blDataType* wx = angularVelocities.x().data();
+    const blDataType* wy = angularVelocities.y().data();
+    const blDataType* wz = angularVelocities.z().data();
+
+    std::size_t i = beginIndex;
+
+    for(; i + blPackType::width <= endIndex; i += blPackType::width)
+        orientationsKernel<blPackType>(qw,qx,qy,qz,wx,wy,wz,dt,i);
+
+    for(; i < endIndex; ++i)
+        orientationsKernel<blTailPackType>(qw,qx,qy,qz,wx,wy,wz,dt,i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline void blBatchIntegrator<blDataType>::rotationMatricesKernel(const typename blPack::blRegisterType& w,
+                                                                  const typename blPack::blRegisterType& x,
+                                                                  const typename blPack::blRegisterType& y,
+                                                                  const typename blPack::blRegisterType& z,
+                                                                  typename blPack::blRegisterType (&rotation)[9])
+{
+    typedef typename blPack::blRegisterType R;
+
+    R one = blPack::set1(1);
+    R two = blPack::set1(2);
+
+    R xx = blPack::mul(x,x);
+    R yy = blPack::mul(y,y);
+    R zz = blPack::mul(z,z);
+    R xy = blPack::mul(x,y);
+    R xz = blPack::mul(x,z);
+    R yz = blPack::mul(y,z);
+    R wx = blPack::mul(w,x);
+    R wy = blPack::mul(w,y);
+    R wz = blPack::mul(w,z);
+
+    rotation[0] = blPack::sub(one,blPack::mul(two,blPack::add(yy,zz)));
+    rotation[1] = blPack::mul(two,blPack::sub(xy,wz));
+    rotation[2] = blPack::mul(two,blPack::add(xz,wy));
+    rotation[3] = blPack::mul(two,blPack::add(xy,wz));
+    rotation[4] = blPack::sub(one,blPack::mul(two,blPack::add(xx,zz)));
+    rotation[5] = blPack::mul(two,blPack::sub(yz,wx));
+    rotation[6] = blPack::mul(two,blPack::sub(xz,wy));
+    rotation[7] = blPack::mul(two,blPack::add(yz,wx));
+    rotation[8] = blPack::sub(one,blPack::mul(two,blPack::add(xx,yy)));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline void blBatchIntegrator<blDataType>::rotateMatricesKernel(const typename blPack::blRegisterType (&rotation)[9],
+                                                                const blDataType* const* A,
+                                                                blDataType* const* rotatedA,
+                                                                const std::size_t& i)
+{
+    typedef typename blPack::blRegisterType R;
+
+    R a[9];
+
+    for(int k = 0; k < 9; ++k)
+        a[k] = blPack::load(A[k] + i);
+
+    // B = A*R^T
+
+    R b[9];
+
+    for(int row = 0; row < 3; ++row)
+        for(int col = 0; col < 3; ++col)
+            b[3*row + col] = blPack::mulAdd(a[3*row],rotation[3*col],
+                             blPack::mulAdd(a[3*row + 1],rotation[3*col + 1],
+                             blPack::mul(a[3*row + 2],rotation[3*col + 2])));
+
+    // R*B
+
+    for(int row = 0; row < 3; ++row)
+        for(int col = 0; col < 3; ++col)
+            blPack::store(rotatedA[3*row + col] + i,
+                          blPack::mulAdd(rotation[3*row],b[col],
+                          blPack::mulAdd(rotation[3*row + 1],b[3 + col],
+                          blPack::mul(rotation[3*row + 2],b[6 + col]))));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline void blBatchIntegrator<blDataType>::worldInertiasKernel(const blDataType* qw,const blDataType* qx,const blDataType* qy,const blDataType* qz,
+                                                               const blDataType* const* I,
+                                                               const blDataType* const* Iinv,
+                                                               blDataType* const* worldI,
+                                                               blDataType* const* worldIinv,
+                                                               const std::size_t& i)
+{
+    typedef typename blPack::blRegisterType R;
+
+    R rotation[9];
+
+    rotationMatricesKernel<blPack>(blPack::load(qw + i),
+                                   blPack::load(qx + i),
+                                   blPack::load(qy + i),
+                                   blPack::load(qz + i),
+                                   rotation);
+
+    rotateMatricesKernel<blPack>(rotation,I,worldI,i);
+    rotateMatricesKernel<blPack>(rotation,Iinv,worldIinv,i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBatchIntegrator<blDataType>::calculateWorldInertias(const blQuaternionArray<blDataType>& rotQtns,
+                                                                 const blMatrix3dArray<blDataType>& inertias,
+                                                                 const blMatrix3dArray<blDataType>& inertiaInverses,
+                                                                 blMatrix3dArray<blDataType>& worldInertias,
+                                                                 blMatrix3dArray<blDataType>& worldInertiaInverses,
+                                                                 const std::size_t& beginIndex,
+                                                                 const std::size_t& endIndex)
+{
+    const blDataType* qw = rotQtns.w().data();
+    const blDataType* qx = rotQtns.x().data();
+    const blDataType* qy = rotQtns.y().data();
+    const blDataType* qz = rotQtns.z().data();
+
+    const blDataType* I[9];
+    const blDataType* Iinv[9];
+    blDataType* worldI[9];
+    blDataType* worldIinv[9];
+
+    getElementPointers(inertias,I);
+    getElementPointers(inertiaInverses,Iinv);
+    getElementPointers(worldInertias,worldI);
+    getElementPointers(worldInertiaInverses,worldIinv);
+
+    std::size_t i = beginIndex;
+
+    for(; i + blPackType::width <= endIndex; i += blPackType::width)
+        worldInertiasKernel<blPackType>(qw,qx,qy,qz,I,Iinv,worldI,worldIinv,i);
+
+    for(; i < endIndex; ++i)
+        worldInertiasKernel<blTailPackType>(qw,qx,qy,qz,I,Iinv,worldI,worldIinv,i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline void blBatchIntegrator<blDataType>::angularVelocitiesKernel(blDataType* wx,blDataType* wy,blDataType* wz,
+                                                                   const blDataType* tx,const blDataType* ty,const blDataType* tz,
+                                                                   const blDataType* const* I,
+                                                                   const blDataType* const* Iinv,
+                                                                   const blDataType& dt,
+                                                                   const std::size_t& i)
+{
+    typedef typename blPack::blRegisterType R;
+
+    R Wx = blPack::load(wx + i);
+    R Wy = blPack::load(wy + i);
+    R Wz = blPack::load(wz + i);
+
+    // Angular momentum
+    // L = I*w
+
+    R Lx = blPack::mulAdd(blPack::load(I[0] + i),Wx,blPack::mulAdd(blPack::load(I[1] + i),Wy,blPack::mul(blPack::load(I[2] + i),Wz)));
+    R Ly = blPack::mulAdd(blPack::load(I[3] + i),Wx,blPack::mulAdd(blPack::load(I[4] + i),Wy,blPack::mul(blPack::load(I[5] + i),Wz)));
+    R Lz = blPack::mulAdd(blPack::load(I[6] + i),Wx,blPack::mulAdd(blPack::load(I[7] + i),Wy,blPack::mul(blPack::load(I[8] + i),Wz)));
+
+    // M = T - w x L
+
+    R Mx = blPack::sub(blPack::load(tx + i),blPack::sub(blPack::mul(Wy,Lz),blPack::mul(Wz,Ly)));
+    R My = blPack::sub(blPack::load(ty + i),blPack::sub(blPack::mul(Wz,Lx),blPack::mul(Wx,Lz)));
+    R Mz = blPack::sub(blPack::load(tz + i),blPack::sub(blPack::mul(Wx,Ly),blPack::mul(Wy,Lx)));
+
+    // w += Iinv*M*dt
+
+    R DT = blPack::set1(dt);
+
+    R ax = blPack::mulAdd(blPack::load(Iinv[0] + i),Mx,blPack::mulAdd(blPack::load(Iinv[1] + i),My,blPack::mul(blPack::load(Iinv[2] + i),Mz)));
+    R ay = blPack::mulAdd(blPack::load(Iinv[3] + i),Mx,blPack::mulAdd(blPack::load(Iinv[4] + i),My,blPack::mul(blPack::load(Iinv[5] + i),Mz)));
+    R az = blPack::mulAdd(blPack::load(Iinv[6] + i),Mx,blPack::mulAdd(blPack::load(Iinv[7] + i),My,blPack::mul(blPack::load(Iinv[8] + i),Mz)));
+
+    blPack::store(wx + i,blPack::mulAdd(ax,DT,Wx));
+    blPack::store(wy + i,blPack::mulAdd(ay,DT,Wy));
+    blPack::store(wz + i,blPack::mulAdd(az,DT,Wz));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBatchIntegrator<blDataType>::integrateAngularVelocities(blVector3dArray<blDataType>& angularVelocities,
+                                                                     const blVector3dArray<blDataType>& torques,
+                                                                     const blMatrix3dArray<blDataType>& inertias,
+                                                                     const blMatrix3dArray<blDataType>& inertiaInverses,
+                                                                     const blDataType& dt,
+                                                                     const std::size_t& beginIndex,
+                                                                     const std::size_t& endIndex)
+{
+    blDataType* wx = angularVelocities.x().data();
+    blDataType* wy = angularVelocities.y().data();
+    blDataType* wz = angularVelocities.z().data();
+
+    const blDataType* tx = torques.x().data();
+    const blDataType* ty = torques.y().data();
+    const blDataType* tz = torques.z().data();
+
+    const blDataType* I[9];
+    const blDataType* Iinv[9];
+
+    getElementPointers(inertias,I);
+    getElementPointers(inertiaInverses,Iinv);
+
+    std::size_t i = beginIndex;
+
+    for(; i + blPackType::width <= endIndex; i += blPackType::width)
+        angularVelocitiesKernel<blPackType>(wx,wy,wz,tx,ty,tz,I,Iinv,dt,i);
+
+    for(; i < endIndex; ++i)
+        angularVelocitiesKernel<blTailPackType>(wx,wy,wz,tx,ty,tz,I,Iinv,dt,i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline typename blPack::blRegisterType blBatchIntegrator<blDataType>::decayKernel(const typename blPack::blRegisterType& x)
+{
+    typedef typename blPack::blRegisterType R;
+
+    // y = x/16
+
+    R y = blPack::mul(blPack::max(x,blPack::set1(0)),blPack::set1(blDataType(1.0/16.0)));
+
+    // P(y) = 1 + y + y^2/2 + ... + y^5/120
+    // evaluated with Horner's method,
+    // P(y) >= 1 so 1/P(y) is within (0,1]
+
+    R P = blPack::mulAdd(y,blPack::set1(blDataType(1.0/120.0)),blPack::set1(blDataType(1.0/24.0)));
+    P = blPack::mulAdd(y,P,blPack::set1(blDataType(1.0/6.0)));
+    P = blPack::mulAdd(y,P,blPack::set1(blDataType(0.5)));
+    P = blPack::mulAdd(y,P,blPack::set1(blDataType(1)));
+    P = blPack::mulAdd(y,P,blPack::set1(blDataType(1)));
+
+    // exp(-x) = (1/P(x/16))^16
+
+    R decay = blPack::div(blPack::set1(blDataType(1)),P);
+
+    for(int k = 0; k < 4; ++k)
+        decay = blPack::mul(decay,decay);
+
+    return decay;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline void blBatchIntegrator<blDataType>::dampingKernel(blDataType* vx,blDataType* vy,blDataType* vz,
+                                                         blDataType* wx,blDataType* wy,blDataType* wz,
+                                                         const blDataType* qw,const blDataType* qx,const blDataType* qy,const blDataType* qz,
+                                                         const blDataType* invMass,
+                                                         const blDataType* const* Iinv,
+                                                         const blDataType* c,
+                                                         const blDataType* angularC,
+                                                         const blDataType& dt,
+                                                         const std::size_t& i)
+{
+    typedef typename blPack::blRegisterType R;
+
+    R DT = blPack::set1(dt);
+
+    // v *= exp(-c*dt/m)
+
+    R decay = decayKernel<blPack>(blPack::mul(blPack::mul(blPack::load(c + i),DT),blPack::load(invMass + i)));
+
+    blPack::store(vx + i,blPack::mul(blPack::load(vx + i),decay));
+    blPack::store(vy + i,blPack::mul(blPack::load(vy + i),decay));
+    blPack::store(vz + i,blPack::mul(blPack::load(vz + i),decay));
+
+    // Take w to body
+    // coordinates, wb = R^T*w
+
+    R rotation[9];
+
+    rotationMatricesKernel<blPack>(blPack::load(qw + i),
+                                   blPack::load(qx + i),
+                                   blPack::load(qy + i),
+                                   blPack::load(qz + i),
+                                   rotation);
+
+    R Wx = blPack::load(wx + i);
+    R Wy = blPack::load(wy + i);
+    R Wz = blPack::load(wz + i);
+
+    R bx = blPack::mulAdd(rotation[0],Wx,blPack::mulAdd(rotation[3],Wy,blPack::mul(rotation[6],Wz)));
+    R by = blPack::mulAdd(rotation[1],Wx,blPack::mulAdd(rotation[4],Wy,blPack::mul(rotation[7],Wz)));
+    R bz = blPack::mulAdd(rotation[2],Wx,blPack::mulAdd(rotation[5],Wy,blPack::mul(rotation[8],Wz)));
+
+    // wb *= exp(-c*dt/I)
+    // along each body axis
+
+    R CDT = blPack::mul(blPack::load(angularC + i),DT);
+
+    bx = blPack::mul(bx,decayKernel<blPack>(blPack::mul(CDT,blPack::load(Iinv[0] + i))));
+    by = blPack::mul(by,decayKernel<blPack>(blPack::mul(CDT,blPack::load(Iinv[4] + i))));
+    bz = blPack::mul(bz,decayKernel<blPack>(blPack::mul(CDT,blPack::load(Iinv[8] + i))));
+
+    // Back to system
+    // coordinates, w = R*wb
+
+    blPack::store(wx + i,blPack::mulAdd(rotation[0],bx,blPack::mulAdd(rotation[1],by,blPack::mul(rotation[2],bz))));
+    blPack::store(wy + i,blPack::mulAdd(rotation[3],bx,blPack::mulAdd(rotation[4],by,blPack::mul(rotation[5],bz))));
+    blPack::store(wz + i,blPack::mulAdd(rotation[6],bx,blPack::mulAdd(rotation[7],by,blPack::mul(rotation[8],bz))));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBatchIntegrator<blDataType>::integrateDamping(blVector3dArray<blDataType>& velocities,
+                                                           blVector3dArray<blDataType>& angularVelocities,
+                                                           const blQuaternionArray<blDataType>& rotQtns,
+                                                           const std::vector<blDataType>& inverseMasses,
+                                                           const blMatrix3dArray<blDataType>& inertiaInverses,
+                                                           const std::vector<blDataType>& dampingCoefficients,
+                                                           const std::vector<blDataType>& angularDampingCoefficients,
+                                                           const blDataType& dt,
+                                                           const std::size_t& beginIndex,
+                                                           const std::size_t& endIndex)
+{
+    blDataType* vx = velocities.x().data();
+    blDataType* vy = velocities.y().data();
+    blDataType* vz = velocities.z().data();
+
+    blDataType* wx = angularVelocities.x().data();
+    blDataType* wy = angularVelocities.y().data();
+    blDataType* wz = angularVelocities.z().data();
+
+    const blDataType* qw = rotQtns.w().data();
+    const blDataType* qx = rotQtns.x().data();
+    const blDataType* qy = rotQtns.y().data();
+    const blDataType* qz = rotQtns.z().data();
+
+    const blDataType* invMass = inverseMasses.data();
+    const blDataType* c = dampingCoefficients.data();
+    const blDataType* angularC = angularDampingCoefficients.data();
+
+    const blDataType* Iinv[9];
+
+    getElementPointers(inertiaInverses,Iinv);
+
+    std::size_t i = beginIndex;
+
+    for(; i + blPackType::width <= endIndex; i += blPackType::width)
+        dampingKernel<blPackType>(vx,vy,vz,wx,wy,wz,qw,qx,qy,qz,invMass,Iinv,c,angularC,dt,i);
+
+    for(; i < endIndex; ++i)
+        dampingKernel<blTailPackType>(vx,vy,vz,wx,wy,wz,qw,qx,qy,qz,invMass,Iinv,c,angularC,dt,i);
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_BATCHINTEGRATOR_HPP
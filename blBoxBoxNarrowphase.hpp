@@ -0,0 +1,879 @@
+#ifndef BL_BOXBOXNARROWPHASE_HPP
+#define BL_BOXBOXNARROWPHASE_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blBoxBoxNarrowphase.hpp
+// CLASS:           blBoxBoxNarrowphase
+// BASE CLASS:      None
+//
+// PURPOSE:         A narrowphase that treats every rigid body as an
+//                  oriented box (its size along its orientation axes)
+//                  and builds contact manifolds for the pairs found
+//                  by the broadphase using the separating axis test
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blRigidBody
+//                  - blContactManifold
+//
+// NOTES:           - The 15 axes are numbered 0-2 for the first
+//                    box's faces, 3-5 for the second box's faces and
+//                    6-14 for the cross products of their edges
+//                  - Face contacts clip the incident face against
+//                    the reference face's sides, edge contacts give
+//                    one point halfway between the closest points of
+//                    the two edges
+//                  - Each pair remembers the axis it used last time,
+//                    which is tried first so separated pairs usually
+//                    exit after one test, and while the two boxes
+//                    barely moved relative to each other the same
+//                    axis is used without testing the other 14
+//                  - A manifold's restitution is the geometric mean
+//                    of the two bodies' restitution coefficients,
+//                    each weighed along the contact normal
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blBoxBoxNarrowphase
+{
+public: // Public typedefs
+
+    typedef std::pair<std::size_t,std::size_t>          blPairType;
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blBoxBoxNarrowphase(const blDataType& linearTolerance = blDataType(0.005),
+                        const blDataType& angularTolerance = blDataType(0.001));
+
+    // Destructor
+
+    ~blBoxBoxNarrowphase()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // set/get how much two
+    // boxes can move relative
+    // to each other before
+    // their cached axis has
+    // to be tested again
+
+    void                                                setCoherenceTolerances(const blDataType& linearTolerance,
+                                                                               const blDataType& angularTolerance);
+
+    const blDataType&                                   getLinearTolerance()const;
+    const blDataType&                                   getAngularTolerance()const;
+
+    // Function used to
+    // build the manifolds of
+    // all the touching pairs,
+    // the pairs index into the
+    // array of rigid bodies
+
+    template<typename blRigidBodyPointerType>
+    void                                                findContacts(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                                     const std::vector<blPairType>& pairs,
+                                                                     std::vector< blContactManifold<blDataType> >& manifolds);
+
+    // Function used to
+    // collide two bodies
+    // without any cached
+    // axis, returns true
+    // if they touch
+
+    bool                                                collide(const blRigidBody<blDataType>& rigidBody1,
+                                                                const blRigidBody<blDataType>& rigidBody2,
+                                                                blContactManifold<blDataType>& manifold);
+
+    // Function used to
+    // forget the cached axes
+
+    void                                                clearCache();
+
+private: // Private types
+
+    // An oriented box
+
+    struct blBox
+    {
+        blVectorType                                    m_center;
+        blVectorType                                    m_axes[3];
+        blDataType                                      m_halfExtents[3];
+    };
+
+    // What a pair remembers
+    // from the last frame its
+    // axes were all tested
+
+    struct blAxisCache
+    {
+        // The axis used,
+        // -1 if none
+
+        int                                             m_axis;
+
+        // The second box's
+        // position and axes as
+        // seen from the first box
+
+        blDataType                                      m_relativePosition[3];
+        blDataType                                      m_relativeRotation[3][3];
+    };
+
+protected: // Protected functions
+
+    // Function used to
+    // build a box from
+    // a rigid body
+
+    void                                                setBox(const blRigidBody<blDataType>& rigidBody,
+                                                               blBox& box)const;
+
+    // Function used to
+    // collide two boxes
+    // using and updating a
+    // pair's cache
+
+    bool                                                collideBoxes(const blBox& box1,
+                                                                     const blBox& box2,
+                                                                     blAxisCache& cache,
+                                                                     blContactManifold<blDataType>& manifold)const;
+
+    // Function used to get
+    // the separation of two
+    // boxes along one of the
+    // 15 axes, and the unit
+    // axis pointing from the
+    // first box to the second,
+    // returns false for edge
+    // axes of parallel edges
+
+    bool                                                getSeparation(const blBox& box1,
+                                                                      const blBox& box2,
+                                                                      const int& axis,
+                                                                      blDataType& separation,
+                                                                      blVectorType& normal)const;
+
+    // Functions used to
+    // build the contact points
+
+    void                                                addFaceContacts(const blBox& referenceBox,
+                                                                        const blBox& incidentBox,
+                                                                        const int& referenceAxis,
+                                                                        const blVectorType& referenceNormal,
+                                                                        blContactManifold<blDataType>& manifold)const;
+
+    void                                                addEdgeContact(const blBox& box1,
+                                                                       const blBox& box2,
+                                                                       const int& axis,
+                                                                       const blVectorType& normal,
+                                                                       const blDataType& depth,
+                                                                       blContactManifold<blDataType>& manifold)const;
+
+    // Function used to
+    // take a snapshot of
+    // the relative pose of
+    // two boxes
+
+    void                                                setRelativePose(const blBox& box1,
+                                                                        const blBox& box2,
+                                                                        blAxisCache& cache)const;
+
+    // Function used to
+    // check whether the two
+    // boxes are still close
+    // to the cached pose
+
+    bool                                                isCoherent(const blBox& box1,
+                                                                   const blBox& box2,
+                                                                   const blAxisCache& cache)const;
+
+    // Function used to
+    // weigh a body's restitution
+    // coefficients along a normal
+
+    blDataType                                          getRestitutionAlong(const blRigidBody<blDataType>& rigidBody,
+                                                                            const blVectorType& normal)const;
+
+private: // Private variables
+
+    // The coherence
+    // tolerances
+
+    blDataType                                          m_linearTolerance;
+    blDataType                                          m_angularTolerance;
+
+    // The pairs sorted, along
+    // with their caches, from
+    // this frame and the last
+
+    std::vector<blPairType>                             m_sortedPairs;
+    std::vector<blPairType>                             m_cachedPairs;
+    std::vector<blAxisCache>                            m_cachedAxes;
+    std::vector<blPairType>                             m_newCachedPairs;
+    std::vector<blAxisCache>                            m_newCachedAxes;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blBoxBoxNarrowphase<blDataType>::blBoxBoxNarrowphase(const blDataType& linearTolerance,
+                                                            const blDataType& angularTolerance)
+{
+    setCoherenceTolerances(linearTolerance,angularTolerance);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBoxBoxNarrowphase<blDataType>::setCoherenceTolerances(const blDataType& linearTolerance,
+                                                                   const blDataType& angularTolerance)
+{
+    m_linearTolerance = std::max(linearTolerance,blDataType(0));
+    m_angularTolerance = std::max(angularTolerance,blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blBoxBoxNarrowphase<blDataType>::getLinearTolerance()const
+{
+    return m_linearTolerance;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blBoxBoxNarrowphase<blDataType>::getAngularTolerance()const
+{
+    return m_angularTolerance;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBoxBoxNarrowphase<blDataType>::clearCache()
+{
+    m_cachedPairs.clear();
+    m_cachedAxes.clear();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBoxBoxNarrowphase<blDataType>::setBox(const blRigidBody<blDataType>& rigidBody,
+                                                    blBox& box)const
+{
+    box.m_center = rigidBody.getPosition();
+
+    box.m_axes[0] = rigidBody.getxAxis();
+    box.m_axes[1] = rigidBody.getyAxis();
+    box.m_axes[2] = rigidBody.getzAxis();
+
+    box.m_halfExtents[0] = blDataType(0.5) * rigidBody.getSize().x();
+    box.m_halfExtents[1] = blDataType(0.5) * rigidBody.getSize().y();
+    box.m_halfExtents[2] = blDataType(0.5) * rigidBody.getSize().z();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blDataType blBoxBoxNarrowphase<blDataType>::getRestitutionAlong(const blRigidBody<blDataType>& rigidBody,
+                                                                       const blVectorType& normal)const
+{
+    const blVectorType& coefficients = rigidBody.getRestitutionCoefficients();
+
+    return normal.x() * normal.x() * coefficients.x() +
+           normal.y() * normal.y() * coefficients.y() +
+           normal.z() * normal.z() * coefficients.z();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blBoxBoxNarrowphase<blDataType>::collide(const blRigidBody<blDataType>& rigidBody1,
+                                                     const blRigidBody<blDataType>& rigidBody2,
+                                                     blContactManifold<blDataType>& manifold)
+{
+    blBox box1;
+    blBox box2;
+
+    setBox(rigidBody1,box1);
+    setBox(rigidBody2,box2);
+
+    blAxisCache cache;
+    cache.m_axis = -1;
+
+    if(!collideBoxes(box1,box2,cache,manifold))
+        return false;
+
+    manifold.setRestitutionCoefficient(std::sqrt(getRestitutionAlong(rigidBody1,manifold.getNormal()) *
+                                                 getRestitutionAlong(rigidBody2,manifold.getNormal())));
+
+    return true;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blRigidBodyPointerType>
+inline void blBoxBoxNarrowphase<blDataType>::findContacts(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                          const std::vector<blPairType>& pairs,
+                                                          std::vector< blContactManifold<blDataType> >& manifolds)
+{
+    manifolds.clear();
+
+    // Step 1:  Sort the pairs
+    //          so that we can walk
+    //          them alongside last
+    //          frame's cache
+
+    m_sortedPairs = pairs;
+    std::sort(m_sortedPairs.begin(),m_sortedPairs.end());
+
+    m_newCachedPairs.clear();
+    m_newCachedAxes.clear();
+
+    std::size_t cacheIndex = 0;
+
+    blBox box1;
+    blBox box2;
+    blContactManifold<blDataType> manifold;
+
+    for(std::size_t i = 0; i < m_sortedPairs.size(); ++i)
+    {
+        const blPairType& pair = m_sortedPairs[i];
+
+        // Step 2:  Find this pair's
+        //          cache, or start a
+        //          new one
+
+        while(cacheIndex < m_cachedPairs.size() && m_cachedPairs[cacheIndex] < pair)
+            ++cacheIndex;
+
+        blAxisCache cache;
+
+        if(cacheIndex < m_cachedPairs.size() && m_cachedPairs[cacheIndex] == pair)
+            cache = m_cachedAxes[cacheIndex];
+        else
+            cache.m_axis = -1;
+
+        // Step 3:  Collide
+        //          the boxes
+
+        const blRigidBody<blDataType>& rigidBody1 = *rigidBodies[pair.first];
+        const blRigidBody<blDataType>& rigidBody2 = *rigidBodies[pair.second];
+
+        setBox(rigidBody1,box1);
+        setBox(rigidBody2,box2);
+
+        manifold.setBodyIndices(pair.first,pair.second);
+
+        if(collideBoxes(box1,box2,cache,manifold))
+        {
+            manifold.setRestitutionCoefficient(std::sqrt(getRestitutionAlong(rigidBody1,manifold.getNormal()) *
+                                                         getRestitutionAlong(rigidBody2,manifold.getNormal())));
+
+            manifolds.push_back(manifold);
+        }
+
+        m_newCachedPairs.push_back(pair);
+        m_newCachedAxes.push_back(cache);
+    }
+
+    // Step 4:  Keep the caches
+    //          of this frame's pairs
+
+    m_cachedPairs.swap(m_newCachedPairs);
+    m_cachedAxes.swap(m_newCachedAxes);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blBoxBoxNarrowphase<blDataType>::getSeparation(const blBox& box1,
+                                                           const blBox& box2,
+                                                           const int& axis,
+                                                           blDataType& separation,
+                                                           blVectorType& normal)const
+{
+    if(axis < 3)
+    {
+        normal = box1.m_axes[axis];
+    }
+    else if(axis < 6)
+    {
+        normal = box2.m_axes[axis - 3];
+    }
+    else
+    {
+        normal = crossProduct(box1.m_axes[(axis - 6) / 3],box2.m_axes[(axis - 6) % 3]);
+
+        blDataType length = std::sqrt(normal * normal);
+
+        // Parallel edges
+        // give no axis, the
+        // face axes cover them
+
+        if(length < blDataType(1e-6))
+            return false;
+
+        normal = normal / length;
+    }
+
+    blVectorType centerOffset = box2.m_center - box1.m_center;
+
+    blDataType distance = centerOffset * normal;
+
+    if(distance < 0)
+    {
+        distance = -distance;
+        normal = -normal;
+    }
+
+    blDataType radius1 = box1.m_halfExtents[0] * std::abs(box1.m_axes[0] * normal) +
+                         box1.m_halfExtents[1] * std::abs(box1.m_axes[1] * normal) +
+                         box1.m_halfExtents[2] * std::abs(box1.m_axes[2] * normal);
+
+    blDataType radius2 = box2.m_halfExtents[0] * std::abs(box2.m_axes[0] * normal) +
+                         box2.m_halfExtents[1] * std::abs(box2.m_axes[1] * normal) +
+                         box2.m_halfExtents[2] * std::abs(box2.m_axes[2] * normal);
+
+    separation = distance - radius1 - radius2;
+
+    return true;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBoxBoxNarrowphase<blDataType>::setRelativePose(const blBox& box1,
+                                                             const blBox& box2,
+                                                             blAxisCache& cache)const
+{
+    blVectorType centerOffset = box2.m_center - box1.m_center;
+
+    for(int i = 0; i < 3; ++i)
+    {
+        cache.m_relativePosition[i] = centerOffset * box1.m_axes[i];
+
+        for(int j = 0; j < 3; ++j)
+            cache.m_relativeRotation[i][j] = box1.m_axes[i] * box2.m_axes[j];
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blBoxBoxNarrowphase<blDataType>::isCoherent(const blBox& box1,
+                                                        const blBox& box2,
+                                                        const blAxisCache& cache)const
+{
+    blVectorType centerOffset = box2.m_center - box1.m_center;
+
+    for(int i = 0; i < 3; ++i)
+    {
+        if(std::abs(centerOffset * box1.m_axes[i] - cache.m_relativePosition[i]) > m_linearTolerance)
+            return false;
+
+        for(int j = 0; j < 3; ++j)
+        {
+            if(std::abs(box1.m_axes[i] * box2.m_axes[j] - cache.m_relativeRotation[i][j]) > m_angularTolerance)
+                return false;
+        }
+    }
+
+    return true;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blBoxBoxNarrowphase<blDataType>::collideBoxes(const blBox& box1,
+                                                          const blBox& box2,
+                                                          blAxisCache& cache,
+                                                          blContactManifold<blDataType>& manifold)const
+{
+    manifold.clearContactPoints();
+
+    blDataType separation;
+    blVectorType normal;
+
+    int bestAxis = -1;
+    blDataType bestSeparation = 0;
+    blVectorType bestNormal;
+
+    // Step 1:  Try the cached
+    //          axis first, a separating
+    //          axis ends the test, and
+    //          if the boxes barely moved
+    //          we keep using it
+
+    if(cache.m_axis >= 0 && getSeparation(box1,box2,cache.m_axis,separation,normal))
+    {
+        if(separation > 0)
+            return false;
+
+        if(isCoherent(box1,box2,cache))
+        {
+            bestAxis = cache.m_axis;
+            bestSeparation = separation;
+            bestNormal = normal;
+        }
+    }
+
+    // Step 2:  Otherwise test all
+    //          15 axes, keeping the one
+    //          with the least penetration
+    //          and favoring faces over
+    //          edges and the first box's
+    //          faces over the second's
+
+    if(bestAxis < 0)
+    {
+        int bestFaceAxis[2] = {-1,-1};
+        blDataType bestFaceSeparation[2] = {0,0};
+        blVectorType bestFaceNormal[2];
+
+        int bestEdgeAxis = -1;
+        blDataType bestEdgeSeparation = 0;
+        blVectorType bestEdgeNormal;
+
+        for(int axis = 0; axis < 15; ++axis)
+        {
+            if(!getSeparation(box1,box2,axis,separation,normal))
+                continue;
+
+            if(separation > 0)
+            {
+                cache.m_axis = axis;
+                setRelativePose(box1,box2,cache);
+                return false;
+            }
+
+            if(axis < 6)
+            {
+                int face = axis / 3;
+
+                if(bestFaceAxis[face] < 0 || separation > bestFaceSeparation[face])
+                {
+                    bestFaceAxis[face] = axis;
+                    bestFaceSeparation[face] = separation;
+                    bestFaceNormal[face] = normal;
+                }
+            }
+            else if(bestEdgeAxis < 0 || separation > bestEdgeSeparation)
+            {
+                bestEdgeAxis = axis;
+                bestEdgeSeparation = separation;
+                bestEdgeNormal = normal;
+            }
+        }
+
+        const blDataType relativeTolerance = blDataType(0.95);
+
+        int face = (bestFaceSeparation[1] > relativeTolerance * bestFaceSeparation[0]) ? 1 : 0;
+
+        bestAxis = bestFaceAxis[face];
+        bestSeparation = bestFaceSeparation[face];
+        bestNormal = bestFaceNormal[face];
+
+        if(bestEdgeAxis >= 0 && bestEdgeSeparation > relativeTolerance * bestSeparation)
+        {
+            bestAxis = bestEdgeAxis;
+            bestSeparation = bestEdgeSeparation;
+            bestNormal = bestEdgeNormal;
+        }
+
+        cache.m_axis = bestAxis;
+        setRelativePose(box1,box2,cache);
+    }
+
+    // Step 3:  Build the
+    //          contact points
+
+    manifold.setNormal(bestNormal);
+
+    if(bestAxis < 3)
+        addFaceContacts(box1,box2,bestAxis,bestNormal,manifold);
+    else if(bestAxis < 6)
+        addFaceContacts(box2,box1,bestAxis - 3,-bestNormal,manifold);
+    else
+        addEdgeContact(box1,box2,bestAxis,bestNormal,-bestSeparation,manifold);
+
+    return manifold.getNumberOfContactPoints() > 0;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBoxBoxNarrowphase<blDataType>::addFaceContacts(const blBox& referenceBox,
+                                                             const blBox& incidentBox,
+                                                             const int& referenceAxis,
+                                                             const blVectorType& referenceNormal,
+                                                             blContactManifold<blDataType>& manifold)const
+{
+    // Step 1:  The incident face
+    //          is the one facing the
+    //          reference face the most
+
+    int incidentAxis = 0;
+    blDataType bestAlignment = -1;
+
+    for(int i = 0; i < 3; ++i)
+    {
+        blDataType alignment = std::abs(incidentBox.m_axes[i] * referenceNormal);
+
+        if(alignment > bestAlignment)
+        {
+            bestAlignment = alignment;
+            incidentAxis = i;
+        }
+    }
+
+    blDataType incidentSign = (incidentBox.m_axes[incidentAxis] * referenceNormal > 0) ? blDataType(-1) : blDataType(1);
+
+    blVectorType faceCenter = incidentBox.m_center + incidentBox.m_axes[incidentAxis] * (incidentSign * incidentBox.m_halfExtents[incidentAxis]);
+
+    int u = (incidentAxis + 1) % 3;
+    int v = (incidentAxis + 2) % 3;
+
+    blVectorType uOffset = incidentBox.m_axes[u] * incidentBox.m_halfExtents[u];
+    blVectorType vOffset = incidentBox.m_axes[v] * incidentBox.m_halfExtents[v];
+
+    // Step 2:  Clip the incident
+    //          face against the four
+    //          sides of the reference
+    //          face, each side can add
+    //          at most one point
+
+    blVectorType polygon[8];
+    blVectorType clippedPolygon[8];
+    int numberOfPoints = 4;
+
+    polygon[0] = faceCenter + uOffset + vOffset;
+    polygon[1] = faceCenter - uOffset + vOffset;
+    polygon[2] = faceCenter - uOffset - vOffset;
+    polygon[3] = faceCenter + uOffset - vOffset;
+
+    for(int side = 0; side < 4 && numberOfPoints > 0; ++side)
+    {
+        int sideAxis = (referenceAxis + 1 + side / 2) % 3;
+
+        blVectorType sideNormal = (side % 2 == 0) ? referenceBox.m_axes[sideAxis] : -referenceBox.m_axes[sideAxis];
+        blDataType sideOffset = sideNormal * referenceBox.m_center + referenceBox.m_halfExtents[sideAxis];
+
+        int numberOfClippedPoints = 0;
+
+        for(int i = 0; i < numberOfPoints; ++i)
+        {
+            const blVectorType& point1 = polygon[i];
+            const blVectorType& point2 = polygon[(i + 1) % numberOfPoints];
+
+            blDataType distance1 = sideNormal * point1 - sideOffset;
+            blDataType distance2 = sideNormal * point2 - sideOffset;
+
+            if(distance1 <= 0)
+                clippedPolygon[numberOfClippedPoints++] = point1;
+
+            if((distance1 < 0 && distance2 > 0) || (distance1 > 0 && distance2 < 0))
+                clippedPolygon[numberOfClippedPoints++] = point1 + (point2 - point1) * (distance1 / (distance1 - distance2));
+        }
+
+        numberOfPoints = numberOfClippedPoints;
+
+        for(int i = 0; i < numberOfPoints; ++i)
+            polygon[i] = clippedPolygon[i];
+    }
+
+    // Step 3:  Keep the points
+    //          below the reference
+    //          face, placed halfway
+    //          between the two faces
+
+    blDataType faceOffset = referenceNormal * referenceBox.m_center + referenceBox.m_halfExtents[referenceAxis];
+
+    blVectorType points[8];
+    blDataType depths[8];
+    int numberOfContacts = 0;
+
+    for(int i = 0; i < numberOfPoints; ++i)
+    {
+        blDataType depth = faceOffset - referenceNormal * polygon[i];
+
+        if(depth >= 0)
+        {
+            points[numberOfContacts] = polygon[i] + referenceNormal * (blDataType(0.5) * depth);
+            depths[numberOfContacts] = depth;
+            ++numberOfContacts;
+        }
+    }
+
+    if(numberOfContacts <= BL_MAX_CONTACT_POINTS)
+    {
+        for(int i = 0; i < numberOfContacts; ++i)
+            manifold.addContactPoint(points[i],depths[i]);
+
+        return;
+    }
+
+    // Step 4:  Too many points, we
+    //          keep the deepest one, the
+    //          one farthest from it, and
+    //          the two spanning the most
+    //          area on either side of the
+    //          line through them
+
+    int chosen[4] = {0,-1,-1,-1};
+
+    for(int i = 1; i < numberOfContacts; ++i)
+    {
+        if(depths[i] > depths[chosen[0]])
+            chosen[0] = i;
+    }
+
+    blDataType bestDistance = -1;
+
+    for(int i = 0; i < numberOfContacts; ++i)
+    {
+        blVectorType offset = points[i] - points[chosen[0]];
+        blDataType distance = offset * offset;
+
+        if(i != chosen[0] && distance > bestDistance)
+        {
+            bestDistance = distance;
+            chosen[1] = i;
+        }
+    }
+
+    blDataType mostPositiveArea = 0;
+    blDataType mostNegativeArea = 0;
+    blVectorType line = points[chosen[1]] - points[chosen[0]];
+
+    for(int i = 0; i < numberOfContacts; ++i)
+    {
+        blDataType area = crossProduct(line,points[i] - points[chosen[0]]) * referenceNormal;
+
+        if(area > mostPositiveArea)
+        {
+            mostPositiveArea = area;
+            chosen[2] = i;
+        }
+        else if(area < mostNegativeArea)
+        {
+            mostNegativeArea = area;
+            chosen[3] = i;
+        }
+    }
+
+    for(int i = 0; i < 4; ++i)
+    {
+        if(chosen[i] >= 0)
+            manifold.addContactPoint(points[chosen[i]],depths[chosen[i]]);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blBoxBoxNarrowphase<blDataType>::addEdgeContact(const blBox& box1,
+                                                            const blBox& box2,
+                                                            const int& axis,
+                                                            const blVectorType& normal,
+                                                            const blDataType& depth,
+                                                            blContactManifold<blDataType>& manifold)const
+{
+    int edge1 = (axis - 6) / 3;
+    int edge2 = (axis - 6) % 3;
+
+    // Step 1:  The first box's
+    //          edge furthest along the
+    //          normal, and the second
+    //          box's edge furthest
+    //          against it
+
+    blVectorType point1 = box1.m_center;
+    blVectorType point2 = box2.m_center;
+
+    for(int i = 0; i < 3; ++i)
+    {
+        if(i != edge1)
+            point1 += box1.m_axes[i] * ((box1.m_axes[i] * normal > 0) ? box1.m_halfExtents[i] : -box1.m_halfExtents[i]);
+
+        if(i != edge2)
+            point2 += box2.m_axes[i] * ((box2.m_axes[i] * normal > 0) ? -box2.m_halfExtents[i] : box2.m_halfExtents[i]);
+    }
+
+    const blVectorType& direction1 = box1.m_axes[edge1];
+    const blVectorType& direction2 = box2.m_axes[edge2];
+
+    // Step 2:  Closest points
+    //          of the two edges
+
+    blVectorType offset = point1 - point2;
+
+    blDataType b = direction1 * direction2;
+    blDataType c = direction1 * offset;
+    blDataType f = direction2 * offset;
+    blDataType denominator = blDataType(1) - b * b;
+
+    blDataType s = (denominator > blDataType(1e-12)) ? (b * f - c) / denominator : blDataType(0);
+
+    s = std::min(std::max(s,-box1.m_halfExtents[edge1]),box1.m_halfExtents[edge1]);
+
+    blDataType t = b * s + f;
+
+    t = std::min(std::max(t,-box2.m_halfExtents[edge2]),box2.m_halfExtents[edge2]);
+
+    blVectorType closestPoint1 = point1 + direction1 * s;
+    blVectorType closestPoint2 = point2 + direction2 * t;
+
+    manifold.addContactPoint((closestPoint1 + closestPoint2) * blDataType(0.5),depth);
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_BOXBOXNARROWPHASE_HPP
@@ -0,0 +1,448 @@
+#ifndef BL_CONJUGATEGRADIENTSOLVER_HPP
+#define BL_CONJUGATEGRADIENTSOLVER_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blConjugateGradientSolver.hpp
+// CLASS:           blConjugateGradientSolver
+// BASE CLASS:      None
+//
+// PURPOSE:         Solves A*x = b for a symmetric positive definite
+//                  blSparseBlockMatrix using the conjugate gradient
+//                  method with a block Jacobi preconditioner
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blSparseBlockMatrix
+//                  - blExecutor -- Used to run the matrix
+//                                  products in parallel
+//
+// NOTES:           - x is used as the starting guess, so passing in
+//                    the last solution warm starts the solver
+//                  - The preconditioner is the inverse of each 3x3
+//                    diagonal block
+//                  - The solver stops when |r| <= tolerance*|b| or
+//                    after the maximum number of iterations, the
+//                    iterations used and the residual left are kept
+//                  - When an executor with more than one thread is
+//                    set, only the matrix products are split across
+//                    its workers, the dot products stay serial so the
+//                    results don't depend on the number of threads
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blConjugateGradientSolver
+{
+public: // Public typedefs
+
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+    typedef typename blSparseBlockMatrix<blDataType>::blBlock   blBlock;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blConjugateGradientSolver(const int& maxNumberOfIterations = 50,
+                              const blDataType& tolerance = blDataType(1e-6));
+
+    // Destructor
+
+    ~blConjugateGradientSolver()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to set/get
+    // when the solver stops
+
+    void                                                setMaxNumberOfIterations(const int& maxNumberOfIterations);
+    const int&                                          getMaxNumberOfIterations()const;
+
+    void                                                setTolerance(const blDataType& tolerance);
+    const blDataType&                                   getTolerance()const;
+
+    // Functions used to
+    // set/get the executor
+    // used to run the matrix
+    // products in parallel
+
+    void                                                setExecutor(const std::shared_ptr<blExecutor>& executor);
+    const std::shared_ptr<blExecutor>&                  getExecutor()const;
+
+    // Functions used to get
+    // how the last solve went
+
+    const int&                                          getNumberOfIterationsUsed()const;
+    const blDataType&                                   getResidual()const;
+
+    // Function used to solve
+    // A*x = b starting from x
+
+    void                                                solve(const blSparseBlockMatrix<blDataType>& A,
+                                                              const std::vector<blVectorType>& b,
+                                                              std::vector<blVectorType>& x);
+
+protected: // Protected functions
+
+    // Function used to
+    // calculate y = A*x,
+    // in parallel when
+    // possible
+
+    void                                                multiply(const blSparseBlockMatrix<blDataType>& A,
+                                                                 const std::vector<blVectorType>& x,
+                                                                 std::vector<blVectorType>& y);
+
+    // Functions used to
+    // build and apply the
+    // block Jacobi
+    // preconditioner
+
+    void                                                buildPreconditioner(const blSparseBlockMatrix<blDataType>& A);
+    void                                                applyPreconditioner(const std::vector<blVectorType>& r,
+                                                                            std::vector<blVectorType>& z)const;
+
+    // Function used to
+    // calculate the dot
+    // product of two
+    // vectors of vectors
+
+    static blDataType                                   dotProduct(const std::vector<blVectorType>& a,
+                                                                   const std::vector<blVectorType>& b);
+
+private: // Private variables
+
+    // When the solver stops
+
+    int                                                 m_maxNumberOfIterations;
+    blDataType                                          m_tolerance;
+
+    // The executor used to
+    // run the matrix products
+
+    std::shared_ptr<blExecutor>                         m_executor;
+
+    // How the last solve went
+
+    int                                                 m_numberOfIterationsUsed;
+    blDataType                                          m_residual;
+
+private: // Private temp variables
+
+    // Temporary buffers kept
+    // around to avoid allocating
+    // them every solve
+
+    std::vector<blBlock>                                m_inverseDiagonalBlocks;
+    std::vector<blVectorType>                           m_r;
+    std::vector<blVectorType>                           m_z;
+    std::vector<blVectorType>                           m_p;
+    std::vector<blVectorType>                           m_Ap;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blConjugateGradientSolver<blDataType>::blConjugateGradientSolver(const int& maxNumberOfIterations,
+                                                                        const blDataType& tolerance)
+{
+    setMaxNumberOfIterations(maxNumberOfIterations);
+    setTolerance(tolerance);
+
+    m_numberOfIterationsUsed = 0;
+    m_residual = 0;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConjugateGradientSolver<blDataType>::setMaxNumberOfIterations(const int& maxNumberOfIterations)
+{
+    m_maxNumberOfIterations = std::max(maxNumberOfIterations,1);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const int& blConjugateGradientSolver<blDataType>::getMaxNumberOfIterations()const
+{
+    return m_maxNumberOfIterations;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConjugateGradientSolver<blDataType>::setTolerance(const blDataType& tolerance)
+{
+    m_tolerance = tolerance;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blConjugateGradientSolver<blDataType>::getTolerance()const
+{
+    return m_tolerance;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConjugateGradientSolver<blDataType>::setExecutor(const std::shared_ptr<blExecutor>& executor)
+{
+    m_executor = executor;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::shared_ptr<blExecutor>& blConjugateGradientSolver<blDataType>::getExecutor()const
+{
+    return m_executor;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const int& blConjugateGradientSolver<blDataType>::getNumberOfIterationsUsed()const
+{
+    return m_numberOfIterationsUsed;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blConjugateGradientSolver<blDataType>::getResidual()const
+{
+    return m_residual;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConjugateGradientSolver<blDataType>::solve(const blSparseBlockMatrix<blDataType>& A,
+                                                         const std::vector<blVectorType>& b,
+                                                         std::vector<blVectorType>& x)
+{
+    std::size_t numberOfRows = A.getNumberOfRows();
+
+    m_numberOfIterationsUsed = 0;
+    m_residual = 0;
+
+    x.resize(numberOfRows,blVectorType(0,0,0));
+
+    if(numberOfRows == 0)
+        return;
+
+    m_r.resize(numberOfRows);
+    m_z.resize(numberOfRows);
+    m_p.resize(numberOfRows);
+    m_Ap.resize(numberOfRows);
+
+    buildPreconditioner(A);
+
+    // Step 1:  The starting
+    //          residual r = b - A*x
+
+    multiply(A,x,m_Ap);
+
+    for(std::size_t i = 0; i < numberOfRows; ++i)
+        m_r[i] = b[i] - m_Ap[i];
+
+    blDataType bb = dotProduct(b,b);
+    blDataType rr = dotProduct(m_r,m_r);
+    blDataType stoppingResidual = m_tolerance * m_tolerance * bb;
+
+    if(rr <= stoppingResidual)
+    {
+        m_residual = std::sqrt(rr);
+        return;
+    }
+
+    // Step 2:  The first search
+    //          direction is the
+    //          preconditioned residual
+
+    applyPreconditioner(m_r,m_z);
+
+    m_p = m_z;
+
+    blDataType rz = dotProduct(m_r,m_z);
+
+    // Step 3:  Iterate
+    //
+    //          alpha = r.z / p.Ap
+    //          x += alpha*p
+    //          r -= alpha*Ap
+    //          beta = r'.z' / r.z
+    //          p = z' + beta*p
+
+    while(m_numberOfIterationsUsed < m_maxNumberOfIterations)
+    {
+        ++m_numberOfIterationsUsed;
+
+        multiply(A,m_p,m_Ap);
+
+        blDataType pAp = dotProduct(m_p,m_Ap);
+
+        if(pAp <= 0)
+            break;
+
+        blDataType alpha = rz / pAp;
+
+        for(std::size_t i = 0; i < numberOfRows; ++i)
+        {
+            x[i] += alpha * m_p[i];
+            m_r[i] -= alpha * m_Ap[i];
+        }
+
+        rr = dotProduct(m_r,m_r);
+
+        if(rr <= stoppingResidual)
+            break;
+
+        applyPreconditioner(m_r,m_z);
+
+        blDataType newRz = dotProduct(m_r,m_z);
+        blDataType beta = newRz / rz;
+
+        rz = newRz;
+
+        for(std::size_t i = 0; i < numberOfRows; ++i)
+            m_p[i] = m_z[i] + beta * m_p[i];
+    }
+
+    m_residual = std::sqrt(rr);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConjugateGradientSolver<blDataType>::multiply(const blSparseBlockMatrix<blDataType>& A,
+                                                            const std::vector<blVectorType>& x,
+                                                            std::vector<blVectorType>& y)
+{
+    if(!m_executor || m_executor->getNumberOfThreads() <= 1)
+    {
+        A.multiply(x,y,0,A.getNumberOfRows());
+        return;
+    }
+
+    m_executor->parallelFor(A.getNumberOfRows(),
+                            [&A,&x,&y](const std::size_t& beginIndex,const std::size_t& endIndex)
+                            {
+                                A.multiply(x,y,beginIndex,endIndex);
+                            });
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConjugateGradientSolver<blDataType>::buildPreconditioner(const blSparseBlockMatrix<blDataType>& A)
+{
+    m_inverseDiagonalBlocks.resize(A.getNumberOfRows());
+
+    for(std::size_t i = 0; i < A.getNumberOfRows(); ++i)
+    {
+        const blDataType (&k)[3][3] = A.getDiagonalBlock(i).m_values;
+        blDataType (&inverse)[3][3] = m_inverseDiagonalBlocks[i].m_values;
+
+        blDataType determinant = k[0][0] * (k[1][1] * k[2][2] - k[1][2] * k[2][1]) -
+                                 k[0][1] * (k[1][0] * k[2][2] - k[1][2] * k[2][0]) +
+                                 k[0][2] * (k[1][0] * k[2][1] - k[1][1] * k[2][0]);
+
+        // A singular block
+        // gets no preconditioning
+
+        if(determinant == 0)
+        {
+            for(int row = 0; row < 3; ++row)
+                for(int column = 0; column < 3; ++column)
+                    inverse[row][column] = (row == column ? 1 : 0);
+
+            continue;
+        }
+
+        blDataType inverseDeterminant = blDataType(1) / determinant;
+
+        for(int row = 0; row < 3; ++row)
+        {
+            for(int column = 0; column < 3; ++column)
+            {
+                // The cofactors, transposed
+
+                int r1 = (column + 1) % 3;
+                int r2 = (column + 2) % 3;
+                int c1 = (row + 1) % 3;
+                int c2 = (row + 2) % 3;
+
+                inverse[row][column] = (k[r1][c1] * k[r2][c2] - k[r1][c2] * k[r2][c1]) * inverseDeterminant;
+            }
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConjugateGradientSolver<blDataType>::applyPreconditioner(const std::vector<blVectorType>& r,
+                                                                       std::vector<blVectorType>& z)const
+{
+    for(std::size_t i = 0; i < r.size(); ++i)
+        z[i] = blSparseBlockMatrix<blDataType>::multiplyBlock(m_inverseDiagonalBlocks[i],r[i]);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blDataType blConjugateGradientSolver<blDataType>::dotProduct(const std::vector<blVectorType>& a,
+                                                                    const std::vector<blVectorType>& b)
+{
+    blDataType sum = 0;
+
+    for(std::size_t i = 0; i < a.size(); ++i)
+        sum += a[i] * b[i];
+
+    return sum;
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_CONJUGATEGRADIENTSOLVER_HPP
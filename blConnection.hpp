@@ -21,8 +21,30 @@
 // DEPENDENCIES:    - blResourceAPI::blIDSystem -- To keep count of all
 //                                  the connections in a
 //                                  program
+//                  - blRigidBodyTable -- To look up the bodies
+//                                        by their handles
 //
-// NOTES:
+// NOTES:           - Forces are calculated and stored first by
+//                    calculateForcesAndTorques and only applied to the
+//                    bodies by applyForcesAndTorques, so that many
+//                    connections can be calculated in parallel and
+//                    then applied in a fixed order
+//                  - The forces of a connection whose bodies are all
+//                    asleep (or have no mass) are not applied, so the
+//                    connection doesn't keep waking them up
+//                  - Connections that provide force Jacobians are
+//                    integrated implicitly by BL_IMPLICIT_EULER, the
+//                    spring Jacobian drops the negative parts of the
+//                    stiffness so the implicit system stays positive
+//                    definite even for compressed springs
+//                  - The bodies are referred to by generational handles
+//                    into the blRigidBodyTable of the system holding the
+//                    connection (see blRigidBodySystem::getRigidBodyHandle),
+//                    so copying a connection copies plain integers, the
+//                    system points its connections to its table every
+//                    step, and a handle to a body that has left the
+//                    system asserts in debug builds and gives no body in
+//                    release builds
 //
 // DATE CREATED:    May/05/2011
 // DATE UPDATED:
@@ -45,26 +67,37 @@
 template<typename blDataType>
 class blConnection
 {
+public: // Public typedefs
+
+    typedef typename blRigidBodyTable<blDataType>::blBodyHandle     blBodyHandle;
+
 public: // Constructors and destructors
 
     // Default constructor
 
-    blConnection(const std::shared_ptr< blRigidBody<blDataType> >& rigidBody1 = std::shared_ptr< blRigidBody<blDataType> >(),
-                 const std::shared_ptr< blRigidBody<blDataType> >& rigidBody2 = std::shared_ptr< blRigidBody<blDataType> >(),
+    blConnection(const blBodyHandle& rigidBody1Handle = blRigidBodyTable<blDataType>::getNullHandle(),
+                 const blBodyHandle& rigidBody2Handle = blRigidBodyTable<blDataType>::getNullHandle(),
                  const blMathAPI::blVector3d<blDataType>& rigidBody1ConnectionPosition = blMathAPI::blVector3d<blDataType>(0,0,0),
                  const blMathAPI::blVector3d<blDataType>& rigidBody2ConnectionPosition = blMathAPI::blVector3d<blDataType>(0,0,0))
     {
         // Copy the bodies
-        // pointers
+        // handles, the table
+        // is set by the system
 
-        setRigidBody1(rigidBody1);
-        setRigidBody2(rigidBody2);
+        setRigidBody1Handle(rigidBody1Handle);
+        setRigidBody2Handle(rigidBody2Handle);
+        setRigidBodyTable(nullptr);
 
         // Copy the connection
         // positions
 
         setRigidBody1ConnectionPosition(rigidBody1ConnectionPosition);
         setRigidBody2ConnectionPosition(rigidBody2ConnectionPosition);
+
+        // Start with no
+        // stored forces
+
+        clearStoredForcesAndTorques();
     }
 
     // Copy constructor
@@ -72,33 +105,86 @@ public: // Constructors and destructors
     blConnection(const blConnection<blDataType>& connection)
     {
         // Copy the bodies
-        // pointers
+        // handles
 
-        setRigidBody1(connection.getRigidBody1());
-        setRigidBody2(connection.getRigidBody2());
+        setRigidBody1Handle(connection.getRigidBody1Handle());
+        setRigidBody2Handle(connection.getRigidBody2Handle());
+        setRigidBodyTable(connection.getRigidBodyTable());
 
         // Copy the connection
         // positions
 
         setRigidBody1ConnectionPosition(connection.getRigidBody1ConnectionPosition());
         setRigidBody2ConnectionPosition(connection.getRigidBody2ConnectionPosition());
+
+        // Start with no
+        // stored forces
+
+        clearStoredForcesAndTorques();
+    }
+
+    // Move constructor, the
+    // handles are plain data
+    // so it copies them
+    // (noexcept so containers
+    // move connections instead
+    // of copying them)
+
+    blConnection(blConnection<blDataType>&& connection) noexcept
+                 : m_rigidBody1Handle(connection.m_rigidBody1Handle),
+                   m_rigidBody2Handle(connection.m_rigidBody2Handle),
+                   m_rigidBodyTable(connection.m_rigidBodyTable),
+                   m_rigidBody1ConnectionPosition(connection.m_rigidBody1ConnectionPosition),
+                   m_rigidBody2ConnectionPosition(connection.m_rigidBody2ConnectionPosition)
+    {
+        clearStoredForcesAndTorques();
+    }
+
+    // Copy assignment, the
+    // handles are plain data
+    // so moving is copying
+
+    blConnection<blDataType>& operator=(const blConnection<blDataType>& connection)
+    {
+        setRigidBody1Handle(connection.getRigidBody1Handle());
+        setRigidBody2Handle(connection.getRigidBody2Handle());
+        setRigidBodyTable(connection.getRigidBodyTable());
+        setRigidBody1ConnectionPosition(connection.getRigidBody1ConnectionPosition());
+        setRigidBody2ConnectionPosition(connection.getRigidBody2ConnectionPosition());
+        clearStoredForcesAndTorques();
+
+        return *this;
     }
 
     // Destructor
-    ~blConnection()
+    virtual ~blConnection()
     {
     }
 
 public: // Public functions
 
     // Functions used to set/get the
+    // handles of the rigid bodies
+    // connected with this connection
+
+    void                                                    setRigidBody1Handle(const blBodyHandle& rigidBody1Handle);
+    void                                                    setRigidBody2Handle(const blBodyHandle& rigidBody2Handle);
+    const blBodyHandle&                                     getRigidBody1Handle()const;
+    const blBodyHandle&                                     getRigidBody2Handle()const;
+
+    // Functions used to set/get the
+    // table the handles refer to
+
+    void                                                    setRigidBodyTable(const blRigidBodyTable<blDataType>* rigidBodyTable);
+    const blRigidBodyTable<blDataType>*                     getRigidBodyTable()const;
+
+    // Functions used to get the
     // rigid bodies connected with
-    // this connection
+    // this connection, null when
+    // there's no table or body
 
-    void                                                    setRigidBody1(const std::shared_ptr< blRigidBody<blDataType> >& rigidBody1);
-    void                                                    setRigidBody2(const std::shared_ptr< blRigidBody<blDataType> >& rigidBody2);
-    const std::shared_ptr< blRigidBody<blDataType> >&       getRigidBody1()const;
-    const std::shared_ptr< blRigidBody<blDataType> >&       getRigidBody2()const;
+    blRigidBody<blDataType>*                                getRigidBody1()const;
+    blRigidBody<blDataType>*                                getRigidBody2()const;
 
     // Function used to set the
     // positions where this connection
@@ -114,6 +200,21 @@ public: // Public functions
     const blMathAPI::blVector3d<blDataType>&                getRigidBody1ConnectionPosition()const;
     const blMathAPI::blVector3d<blDataType>&                getRigidBody2ConnectionPosition()const;
 
+    // Function that calculates and
+    // stores the forces/torques
+    // without touching the rigid
+    // bodies, which makes it safe
+    // to call on many connections
+    // at the same time
+
+    virtual void                                            calculateForcesAndTorques();
+
+    // Function used to apply
+    // the stored forces/torques
+    // to the rigid bodies
+
+    void                                                    applyForcesAndTorques();
+
     // Function that calculates and
     // applies forces/torques to the
     // rigid bodies
@@ -131,13 +232,68 @@ public: // Public functions
 
     virtual bool                                            hasConnectionBeenBroken()const;
 
-private: // Private variables
-
-    // The rigid bodies connected
-    // with this connections
-
-    std::shared_ptr< blRigidBody<blDataType> >              m_rigidBody1;
-    std::shared_ptr< blRigidBody<blDataType> >              m_rigidBody2;
+    // Function used by implicit
+    // integration to get how the
+    // force on the first body
+    // changes with the second
+    // body's position/velocity,
+    // it returns false when the
+    // connection has no Jacobians
+    // and its force is to be
+    // applied explicitly
+
+    virtual bool                                            calculateForceJacobians(blDataType (&positionJacobian)[3][3],
+                                                                                    blDataType (&velocityJacobian)[3][3]);
+
+protected: // Protected functions
+
+    // Functions used by derived
+    // connections to store the
+    // calculated forces and the
+    // positions (in body coordinates)
+    // where they are applied
+
+    void                                                    storeForcesAndTorques(const blMathAPI::blVector3d<blDataType>& rigidBody1Force,
+                                                                                  const blMathAPI::blVector3d<blDataType>& rigidBody1ForcePosition,
+                                                                                  const blMathAPI::blVector3d<blDataType>& rigidBody2Force,
+                                                                                  const blMathAPI::blVector3d<blDataType>& rigidBody2ForcePosition);
+
+    void                                                    clearStoredForcesAndTorques();
+
+    // Function used by polynomial
+    // springs to build their
+    // Jacobians, the force being
+    // c0 + c1*x + c2*x^2 + ... of
+    // the elongation x
+
+    bool                                                    calculatePolySpringJacobians(const blDataType* coeffs,
+                                                                                         const std::size_t& numberOfCoeffs,
+                                                                                         const blDataType& naturalLength,
+                                                                                         blDataType (&positionJacobian)[3][3],
+                                                                                         blDataType (&velocityJacobian)[3][3])const;
+
+    // Function used by springs
+    // to build the Jacobian of
+    // a force f(length) pulling
+    // along the unit direction
+    // between the bodies
+
+    static void                                             calculateSpringJacobian(const blMathAPI::blVector3d<blDataType>& direction,
+                                                                                    const blDataType& length,
+                                                                                    const blDataType& force,
+                                                                                    const blDataType& forceDerivative,
+                                                                                    blDataType (&positionJacobian)[3][3]);
+
+protected: // Protected variables
+
+    // The handles of the rigid
+    // bodies connected with this
+    // connections and the table
+    // they refer to
+
+    blBodyHandle                                            m_rigidBody1Handle;
+    blBodyHandle                                            m_rigidBody2Handle;
+    const blRigidBodyTable<blDataType>*                     m_rigidBodyTable;
 
     // Positions of where the
     // connection attached to
@@ -145,42 +301,93 @@ private: // Private variables
 
     blMathAPI::blVector3d<blDataType>                       m_rigidBody1ConnectionPosition;
     blMathAPI::blVector3d<blDataType>                       m_rigidBody2ConnectionPosition;
+
+    // The stored forces and
+    // where they are applied
+
+    blMathAPI::blVector3d<blDataType>                       m_rigidBody1Force;
+    blMathAPI::blVector3d<blDataType>                       m_rigidBody1ForcePosition;
+    blMathAPI::blVector3d<blDataType>                       m_rigidBody2Force;
+    blMathAPI::blVector3d<blDataType>                       m_rigidBody2ForcePosition;
+    bool                                                    m_hasStoredForces;
 };
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
 template<typename blDataType>
-inline void blConnection<blDataType>::setRigidBody1(const std::shared_ptr<blRigidBody<blDataType> >& rigidBody1)
+inline void blConnection<blDataType>::setRigidBody1Handle(const blBodyHandle& rigidBody1Handle)
+{
+    m_rigidBody1Handle = rigidBody1Handle;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConnection<blDataType>::setRigidBody2Handle(const blBodyHandle& rigidBody2Handle)
+{
+    m_rigidBody2Handle = rigidBody2Handle;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const typename blConnection<blDataType>::blBodyHandle& blConnection<blDataType>::getRigidBody1Handle()const
 {
-    m_rigidBody1 = rigidBody1;
+    return m_rigidBody1Handle;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
 template<typename blDataType>
-inline void blConnection<blDataType>::setRigidBody2(const std::shared_ptr<blRigidBody<blDataType> >& rigidBody2)
+inline const typename blConnection<blDataType>::blBodyHandle& blConnection<blDataType>::getRigidBody2Handle()const
 {
-    m_rigidBody2 = rigidBody2;
+    return m_rigidBody2Handle;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
 template<typename blDataType>
-inline const std::shared_ptr<blRigidBody<blDataType> >& blConnection<blDataType>::getRigidBody1()const
+inline void blConnection<blDataType>::setRigidBodyTable(const blRigidBodyTable<blDataType>* rigidBodyTable)
 {
-    return m_rigidBody1;
+    m_rigidBodyTable = rigidBodyTable;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
 template<typename blDataType>
-inline const std::shared_ptr<blRigidBody<blDataType> >& blConnection<blDataType>::getRigidBody2()const
+inline const blRigidBodyTable<blDataType>* blConnection<blDataType>::getRigidBodyTable()const
 {
-    return m_rigidBody2;
+    return m_rigidBodyTable;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blRigidBody<blDataType>* blConnection<blDataType>::getRigidBody1()const
+{
+    if(!m_rigidBodyTable)
+        return nullptr;
+
+    return m_rigidBodyTable->getRigidBody(m_rigidBody1Handle);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blRigidBody<blDataType>* blConnection<blDataType>::getRigidBody2()const
+{
+    if(!m_rigidBodyTable)
+        return nullptr;
+
+    return m_rigidBodyTable->getRigidBody(m_rigidBody2Handle);
 }
 //-------------------------------------------------------------------
 
@@ -221,10 +428,74 @@ inline const blMathAPI::blVector3d<blDataType>& blConnection<blDataType>::getRig
 //-------------------------------------------------------------------
 
 
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConnection<blDataType>::calculateForcesAndTorques()
+{
+    // The default connection
+    // doesn't produce any force
+
+    clearStoredForcesAndTorques();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConnection<blDataType>::applyForcesAndTorques()
+{
+    if(!m_hasStoredForces)
+        return;
+
+    blRigidBody<blDataType>* rigidBody1 = getRigidBody1();
+    blRigidBody<blDataType>* rigidBody2 = getRigidBody2();
+
+    bool isAnyBodyAwake = (rigidBody1 && rigidBody1->getIsAwake() && rigidBody1->getMass() > 0) ||
+                          (rigidBody2 && rigidBody2->getIsAwake() && rigidBody2->getMass() > 0);
+
+    if(!isAnyBodyAwake)
+        return;
+
+    if(rigidBody1)
+        rigidBody1->addForceAndTorque(m_rigidBody1Force,m_rigidBody1ForcePosition);
+
+    if(rigidBody2)
+        rigidBody2->addForceAndTorque(m_rigidBody2Force,m_rigidBody2ForcePosition);
+}
+//-------------------------------------------------------------------
+
+
 //-------------------------------------------------------------------
 template<typename blDataType>
 inline void blConnection<blDataType>::calculateAndApplyForcesAndTorques()
 {
+    calculateForcesAndTorques();
+    applyForcesAndTorques();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConnection<blDataType>::storeForcesAndTorques(const blMathAPI::blVector3d<blDataType>& rigidBody1Force,
+                                                            const blMathAPI::blVector3d<blDataType>& rigidBody1ForcePosition,
+                                                            const blMathAPI::blVector3d<blDataType>& rigidBody2Force,
+                                                            const blMathAPI::blVector3d<blDataType>& rigidBody2ForcePosition)
+{
+    m_rigidBody1Force = rigidBody1Force;
+    m_rigidBody1ForcePosition = rigidBody1ForcePosition;
+    m_rigidBody2Force = rigidBody2Force;
+    m_rigidBody2ForcePosition = rigidBody2ForcePosition;
+    m_hasStoredForces = true;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConnection<blDataType>::clearStoredForcesAndTorques()
+{
+    m_hasStoredForces = false;
 }
 //-------------------------------------------------------------------
 
@@ -241,4 +512,125 @@ inline bool blConnection<blDataType>::hasConnectionBeenBroken()const
 //-------------------------------------------------------------------
 
 
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blConnection<blDataType>::calculateForceJacobians(blDataType (&/*positionJacobian*/)[3][3],
+                                                              blDataType (&/*velocityJacobian*/)[3][3])
+{
+    // The default connection
+    // is applied explicitly
+
+    return false;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blConnection<blDataType>::calculatePolySpringJacobians(const blDataType* coeffs,
+                                                                   const std::size_t& numberOfCoeffs,
+                                                                   const blDataType& naturalLength,
+                                                                   blDataType (&positionJacobian)[3][3],
+                                                                   blDataType (&velocityJacobian)[3][3])const
+{
+    blRigidBody<blDataType>* rigidBody1 = getRigidBody1();
+    blRigidBody<blDataType>* rigidBody2 = getRigidBody2();
+
+    if(!rigidBody1 || !rigidBody2)
+        return false;
+
+    // Step 1:  Find the spring's
+    //          current direction
+    //          and length
+
+    blMathAPI::blVector3d<blDataType> Pos1 = m_rigidBody1ConnectionPosition;
+    blMathAPI::blVector3d<blDataType> Pos2 = m_rigidBody2ConnectionPosition;
+
+    rigidBody1->fromBodyToSystemCoordinates(Pos1);
+    rigidBody2->fromBodyToSystemCoordinates(Pos2);
+
+    blMathAPI::blVector3d<blDataType> distanceVector = Pos2 - Pos1;
+
+    blDataType length = distanceVector.getMagnitude();
+
+    // Without a direction
+    // the spring is left
+    // explicit
+
+    if(length <= 0)
+        return false;
+
+    distanceVector.normalize();
+
+    // Step 2:  Evaluate the force
+    //          and its derivative
+    //          at the elongation
+    //          with Horner's method
+
+    blDataType elongation = length - naturalLength;
+
+    blDataType force = 0;
+    blDataType forceDerivative = 0;
+
+    for(std::size_t i = numberOfCoeffs; i > 0; --i)
+    {
+        forceDerivative = forceDerivative * elongation + force;
+        force = force * elongation + coeffs[i - 1];
+    }
+
+    // Step 3:  Build the
+    //          Jacobians, the
+    //          spring has no
+    //          velocity dependence
+
+    calculateSpringJacobian(distanceVector,length,force,forceDerivative,positionJacobian);
+
+    for(int row = 0; row < 3; ++row)
+        for(int column = 0; column < 3; ++column)
+            velocityJacobian[row][column] = 0;
+
+    return true;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConnection<blDataType>::calculateSpringJacobian(const blMathAPI::blVector3d<blDataType>& direction,
+                                                              const blDataType& length,
+                                                              const blDataType& force,
+                                                              const blDataType& forceDerivative,
+                                                              blDataType (&positionJacobian)[3][3])
+{
+    // The force on the first
+    // body is F = f(l)*n, so
+    // moving the second body
+    // changes it by
+    //
+    // dF/dx2 = f'(l)*n*n^T + f(l)/l*(I - n*n^T)
+    //
+    // the negative parts are
+    // dropped to keep the
+    // implicit system positive
+    // definite
+
+    blDataType axialStiffness = std::max(forceDerivative,blDataType(0));
+    blDataType transverseStiffness = length > 0 ? std::max(force / length,blDataType(0)) : blDataType(0);
+
+    blDataType n[3] = {direction.x(),direction.y(),direction.z()};
+
+    for(int row = 0; row < 3; ++row)
+    {
+        for(int column = 0; column < 3; ++column)
+        {
+            blDataType nn = n[row] * n[column];
+
+            positionJacobian[row][column] = axialStiffness * nn +
+                                            transverseStiffness * ((row == column ? 1 : 0) - nn);
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
 #endif // BL_CONNECTION_HPP
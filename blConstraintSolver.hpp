@@ -0,0 +1,1849 @@
+#ifndef BL_CONSTRAINTSOLVER_HPP
+#define BL_CONSTRAINTSOLVER_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blConstraintSolver.hpp
+// CLASS:           blConstraintSolver
+// BASE CLASS:      None
+//
+// PURPOSE:         An iterative (sequential impulses / projected
+//                  Gauss-Seidel) solver that keeps touching bodies
+//                  from sinking into each other and jointed bodies
+//                  together, by correcting their velocities after
+//                  they have been integrated
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blRigidBody
+//                  - blBallJoint
+//                  - blContactManifold
+//                  - blDynamicAABBTree, blBoxBoxNarrowphase -- Used
+//                    by step() to find the contacts
+//                  - blExecutor, blIslandManager -- Used to solve
+//                    islands of bodies in parallel
+//
+// NOTES:           - Each contact point gets a non-penetration impulse
+//                    (never pulling) and two friction impulses bounded
+//                    by the friction coefficient times the normal one,
+//                    each ball joint gets a 3d impulse
+//                  - Penetration past the allowed amount and joint
+//                    drift are pushed out by a Baumgarte velocity bias,
+//                    and contacts approaching faster than the
+//                    restitution threshold bounce back with the
+//                    manifold's restitution coefficient
+//                  - The impulses of the last step are applied first
+//                    (warm starting), contacts are matched to last
+//                    step's contacts by their position relative to
+//                    the first body, joints keep theirs in the joint
+//                  - Once the velocities are solved, the bodies are
+//                    moved by the change in velocity times the time
+//                    step, which makes the whole step the same as
+//                    integrating with the corrected velocities
+//                  - Bodies held together by a joint don't collide
+//                    with each other
+//                  - Bodies with no mass or asleep don't move, and
+//                    the inverse inertia is turned into system
+//                    coordinates with the body's orientation axes
+//                  - With an executor of more than one thread, the
+//                    constraints are split into islands of moving
+//                    bodies, small islands are batched into tasks
+//                    solved exactly like the serial solver would,
+//                    large islands are graph colored and each color
+//                    is solved in parallel (a nested parallelFor)
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+
+    // The most colors a large
+    // island is split into, one
+    // bit each in a 64 bit mask
+    enum {BL_MAX_ISLAND_COLORS = 64};
+
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blConstraintSolver
+{
+public: // Public typedefs
+
+    typedef std::pair<std::size_t,std::size_t>          blPairType;
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+    typedef blMathAPI::blQuaternion<blDataType>         blQuaternionType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blConstraintSolver(const int& numberOfIterations = 10);
+
+    // Destructor
+
+    ~blConstraintSolver()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // set/get the number of
+    // velocity iterations
+
+    void                                                setNumberOfIterations(const int& numberOfIterations);
+    const int&                                          getNumberOfIterations()const;
+
+    // Functions used to
+    // set/get the fraction of
+    // the position error fixed
+    // every step and the
+    // penetration left alone
+
+    void                                                setBaumgarteFactor(const blDataType& baumgarteFactor);
+    const blDataType&                                   getBaumgarteFactor()const;
+
+    void                                                setAllowedPenetration(const blDataType& allowedPenetration);
+    const blDataType&                                   getAllowedPenetration()const;
+
+    // Functions used to
+    // set/get the friction
+    // coefficient
+
+    void                                                setFrictionCoefficient(const blDataType& frictionCoefficient);
+    const blDataType&                                   getFrictionCoefficient()const;
+
+    // Functions used to
+    // set/get the approaching
+    // speed under which contacts
+    // don't bounce
+
+    void                                                setRestitutionThreshold(const blDataType& restitutionThreshold);
+    const blDataType&                                   getRestitutionThreshold()const;
+
+    // Functions used to
+    // turn warm starting
+    // on/off and to set/get
+    // how far a contact can
+    // move and still be
+    // matched to last step's
+
+    void                                                setIsWarmStartingEnabled(const bool& isWarmStartingEnabled);
+    const bool&                                         getIsWarmStartingEnabled()const;
+
+    void                                                setContactMatchingDistance(const blDataType& contactMatchingDistance);
+    const blDataType&                                   getContactMatchingDistance()const;
+
+    // Functions used to
+    // set/get the executor
+    // used to solve islands
+    // of bodies in parallel
+
+    void                                                setExecutor(const std::shared_ptr<blExecutor>& executor);
+    const std::shared_ptr<blExecutor>&                  getExecutor()const;
+
+    // Functions used to
+    // set/get how many
+    // constraints of small
+    // islands are solved
+    // together as one task,
+    // and the size from which
+    // an island is split up
+    // into independent colors
+
+    void                                                setIslandTaskSizes(const std::size_t& islandBatchSize,
+                                                                           const std::size_t& largeIslandSize);
+    const std::size_t&                                  getIslandBatchSize()const;
+    const std::size_t&                                  getLargeIslandSize()const;
+
+    // Function used to find
+    // the contacts between the
+    // bodies and solve them
+    // along with the joints
+
+    template<typename blRigidBodyPointerType>
+    void                                                step(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                             const std::vector<blBallJoint<blDataType>*>& joints,
+                                                             const blDataType& timeStep);
+
+    // Function used to solve
+    // the given contacts (whose
+    // body indices point into
+    // the array of rigid bodies)
+    // and joints
+
+    template<typename blRigidBodyPointerType>
+    void                                                solve(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                              const std::vector< blContactManifold<blDataType> >& manifolds,
+                                                              const std::vector<blBallJoint<blDataType>*>& joints,
+                                                              const blDataType& timeStep);
+
+    // Functions used to get
+    // the collision detection
+    // used by step() and the
+    // contacts it found
+
+    blDynamicAABBTree<blDataType>&                      getBroadphase();
+    blBoxBoxNarrowphase<blDataType>&                    getNarrowphase();
+    const std::vector< blContactManifold<blDataType> >& getContactManifolds()const;
+
+    // Functions used to get
+    // the bodies' bounding boxes
+    // and the pairs of bodies
+    // whose boxes overlap, as
+    // found by the last step()
+
+    const std::vector< blAABB<blDataType> >&           getBoundingBoxes()const;
+    const std::vector<blPairType>&                      getPairs()const;
+
+    // Function used to
+    // forget the cached
+    // contact impulses
+
+    void                                                clearCache();
+
+private: // Private types
+
+    // A contact point
+    // ready to be solved
+
+    struct blContactPointConstraint
+    {
+        blVectorType                                    m_r1;
+        blVectorType                                    m_r2;
+        blVectorType                                    m_localPoint;
+
+        blDataType                                      m_normalMass;
+        blDataType                                      m_tangentMasses[2];
+        blDataType                                      m_targetVelocity;
+
+        blDataType                                      m_normalImpulse;
+        blDataType                                      m_tangentImpulses[2];
+    };
+
+    // A manifold ready
+    // to be solved
+
+    struct blContactConstraint
+    {
+        std::size_t                                     m_body1;
+        std::size_t                                     m_body2;
+
+        blVectorType                                    m_normal;
+        blVectorType                                    m_tangents[2];
+
+        blContactPointConstraint                        m_points[BL_MAX_CONTACT_POINTS];
+        std::size_t                                     m_numberOfPoints;
+    };
+
+    // A ball joint ready
+    // to be solved
+
+    struct blJointConstraint
+    {
+        std::size_t                                     m_body1;
+        std::size_t                                     m_body2;
+        blBallJoint<blDataType>*                        m_joint;
+
+        blVectorType                                    m_r1;
+        blVectorType                                    m_r2;
+        blVectorType                                    m_bias;
+        blVectorType                                    m_impulse;
+
+        // The inverse of the
+        // joint's 3x3 mass matrix
+
+        blDataType                                      m_mass[3][3];
+    };
+
+    // Last step's impulses
+    // of a pair's contacts
+
+    struct blCachedContacts
+    {
+        blPairType                                      m_pair;
+
+        blVectorType                                    m_localPoints[BL_MAX_CONTACT_POINTS];
+        blDataType                                      m_normalImpulses[BL_MAX_CONTACT_POINTS];
+        blDataType                                      m_tangentImpulses[BL_MAX_CONTACT_POINTS][2];
+        std::size_t                                     m_numberOfPoints;
+    };
+
+    // A task solving a batch
+    // of small islands, or one
+    // large island color by color
+
+    struct blIslandTask
+    {
+        std::size_t                                     m_begin;
+        std::size_t                                     m_end;
+
+        std::size_t                                     m_firstColor;
+        std::size_t                                     m_numberOfColors;
+    };
+
+protected: // Protected functions
+
+    // Functions used to
+    // add a body to the
+    // solver and to find it
+
+    std::size_t                                         addBody(blRigidBody<blDataType>* rigidBody);
+    std::size_t                                         findBody(blRigidBody<blDataType>* rigidBody);
+
+    // Function used to
+    // apply the inverse inertia
+    // of a body, in system
+    // coordinates, to a vector
+
+    blVectorType                                        applyInverseInertia(const std::size_t& bodyIndex,
+                                                                            const blVectorType& vector)const;
+
+    // Function used to get
+    // the effective mass of
+    // the two bodies along
+    // a direction
+
+    blDataType                                          getEffectiveMass(const std::size_t& body1,
+                                                                         const std::size_t& body2,
+                                                                         const blVectorType& r1,
+                                                                         const blVectorType& r2,
+                                                                         const blVectorType& direction)const;
+
+    // Function used to get
+    // the velocity of the second
+    // body relative to the first
+    // at a point
+
+    blVectorType                                        getRelativeVelocity(const std::size_t& body1,
+                                                                            const std::size_t& body2,
+                                                                            const blVectorType& r1,
+                                                                            const blVectorType& r2)const;
+
+    // Function used to apply
+    // an impulse to the second
+    // body and its opposite to
+    // the first one
+
+    void                                                applyImpulse(const std::size_t& body1,
+                                                                     const std::size_t& body2,
+                                                                     const blVectorType& r1,
+                                                                     const blVectorType& r2,
+                                                                     const blVectorType& impulse);
+
+    // The steps of
+    // the solver
+
+    void                                                prepareContacts(const std::vector< blContactManifold<blDataType> >& manifolds,
+                                                                        const blDataType& timeStep);
+
+    void                                                prepareJoints(const std::vector<blBallJoint<blDataType>*>& joints,
+                                                                      const blDataType& timeStep);
+
+    void                                                prepareContact(const std::vector< blContactManifold<blDataType> >& manifolds,
+                                                                       const std::size_t& contactIndex,
+                                                                       const blDataType& timeStep);
+
+    void                                                warmStart();
+    void                                                solveJoints();
+    void                                                solveContacts();
+    void                                                storeImpulses();
+    void                                                updateBodies(const blDataType& timeStep);
+
+    // Functions used to
+    // solve one constraint,
+    // constraint ids count the
+    // joints first and then
+    // the contacts
+
+    void                                                warmStartJoint(const std::size_t& jointIndex);
+    void                                                warmStartContact(const std::size_t& contactIndex);
+    void                                                solveJoint(const std::size_t& jointIndex);
+    void                                                solveContact(const std::size_t& contactIndex);
+
+    void                                                getConstraintBodies(const std::size_t& constraintId,
+                                                                            std::size_t& body1,
+                                                                            std::size_t& body2)const;
+
+    void                                                warmStartConstraint(const std::size_t& constraintId);
+    void                                                solveConstraint(const std::size_t& constraintId);
+
+    void                                                updateBody(const std::size_t& bodyIndex,
+                                                                   const blDataType& timeStep);
+
+    // Functions used to
+    // split the constraints
+    // into island tasks and
+    // solve them in parallel
+
+    bool                                                isParallel()const;
+
+    void                                                buildIslandTasks();
+    void                                                colorIsland(const std::size_t& begin,
+                                                                    const std::size_t& end);
+    void                                                solveIslandTask(const std::size_t& taskIndex);
+    void                                                solveIslands();
+
+private: // Private variables
+
+    // The solver's
+    // parameters
+
+    int                                                 m_numberOfIterations;
+    blDataType                                          m_baumgarteFactor;
+    blDataType                                          m_allowedPenetration;
+    blDataType                                          m_frictionCoefficient;
+    blDataType                                          m_restitutionThreshold;
+    bool                                                m_isWarmStartingEnabled;
+    blDataType                                          m_contactMatchingDistance;
+
+    // The bodies being
+    // solved and their
+    // velocities
+
+    std::vector<blRigidBody<blDataType>*>               m_bodies;
+    std::vector< std::pair<blRigidBody<blDataType>*,std::size_t> >   m_bodyLookup;
+    std::size_t                                         m_numberOfSortedBodies;
+
+    std::vector<blDataType>                             m_inverseMasses;
+    std::vector<blVectorType>                           m_velocities;
+    std::vector<blVectorType>                           m_angularVelocities;
+    std::vector<blVectorType>                           m_startingVelocities;
+    std::vector<blVectorType>                           m_startingAngularVelocities;
+
+    // The constraints
+
+    std::vector<blContactConstraint>                    m_contactConstraints;
+    std::vector<blJointConstraint>                      m_jointConstraints;
+
+    // Last step's contact
+    // impulses, sorted by pair
+
+    std::vector<blCachedContacts>                       m_cachedContacts;
+    std::vector<blCachedContacts>                       m_newCachedContacts;
+
+    // The collision
+    // detection used
+    // by step()
+
+    blDynamicAABBTree<blDataType>                       m_broadphase;
+    blBoxBoxNarrowphase<blDataType>                     m_narrowphase;
+
+    std::vector< blAABB<blDataType> >                   m_boundingBoxes;
+    std::vector<blPairType>                             m_pairs;
+    std::vector<blPairType>                             m_jointPairs;
+    std::vector< blContactManifold<blDataType> >        m_manifolds;
+
+    // The executor and the
+    // islands of constraints
+    // it solves in parallel
+
+    std::shared_ptr<blExecutor>                         m_executor;
+    std::size_t                                         m_islandBatchSize;
+    std::size_t                                         m_largeIslandSize;
+
+    blIslandManager<blDataType>                         m_islandManager;
+    std::vector<blPairType>                             m_islandLinks;
+
+    std::vector<std::size_t>                            m_constraintIslands;
+    std::vector<std::size_t>                            m_islandConstraintStarts;
+    std::vector<std::size_t>                            m_islandConstraints;
+
+    std::vector<blIslandTask>                           m_islandTasks;
+
+    // The colors of the
+    // constraints of large
+    // islands, constraints of
+    // the same color share
+    // no moving body
+
+    std::vector<std::size_t>                            m_constraintColors;
+    std::vector<std::uint64_t>                          m_bodyColorMasks;
+    std::vector<std::size_t>                            m_colorCounts;
+    std::vector<std::size_t>                            m_coloredConstraints;
+    std::vector<std::size_t>                            m_colorStarts;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blConstraintSolver<blDataType>::blConstraintSolver(const int& numberOfIterations)
+                                                          : m_baumgarteFactor(0.2),
+                                                            m_allowedPenetration(0.005),
+                                                            m_frictionCoefficient(0.5),
+                                                            m_restitutionThreshold(0.5),
+                                                            m_isWarmStartingEnabled(true),
+                                                            m_contactMatchingDistance(0.05),
+                                                            m_numberOfSortedBodies(0),
+                                                            m_islandBatchSize(64),
+                                                            m_largeIslandSize(256)
+{
+    setNumberOfIterations(numberOfIterations);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::setNumberOfIterations(const int& numberOfIterations)
+{
+    m_numberOfIterations = std::max(1,numberOfIterations);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const int& blConstraintSolver<blDataType>::getNumberOfIterations()const
+{
+    return m_numberOfIterations;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::setBaumgarteFactor(const blDataType& baumgarteFactor)
+{
+    m_baumgarteFactor = std::min(std::max(baumgarteFactor,blDataType(0)),blDataType(1));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blConstraintSolver<blDataType>::getBaumgarteFactor()const
+{
+    return m_baumgarteFactor;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::setAllowedPenetration(const blDataType& allowedPenetration)
+{
+    m_allowedPenetration = std::max(allowedPenetration,blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blConstraintSolver<blDataType>::getAllowedPenetration()const
+{
+    return m_allowedPenetration;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::setFrictionCoefficient(const blDataType& frictionCoefficient)
+{
+    m_frictionCoefficient = std::max(frictionCoefficient,blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blConstraintSolver<blDataType>::getFrictionCoefficient()const
+{
+    return m_frictionCoefficient;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::setRestitutionThreshold(const blDataType& restitutionThreshold)
+{
+    m_restitutionThreshold = std::max(restitutionThreshold,blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blConstraintSolver<blDataType>::getRestitutionThreshold()const
+{
+    return m_restitutionThreshold;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::setIsWarmStartingEnabled(const bool& isWarmStartingEnabled)
+{
+    m_isWarmStartingEnabled = isWarmStartingEnabled;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const bool& blConstraintSolver<blDataType>::getIsWarmStartingEnabled()const
+{
+    return m_isWarmStartingEnabled;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::setContactMatchingDistance(const blDataType& contactMatchingDistance)
+{
+    m_contactMatchingDistance = std::max(contactMatchingDistance,blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blConstraintSolver<blDataType>::getContactMatchingDistance()const
+{
+    return m_contactMatchingDistance;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::setExecutor(const std::shared_ptr<blExecutor>& executor)
+{
+    m_executor = executor;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::shared_ptr<blExecutor>& blConstraintSolver<blDataType>::getExecutor()const
+{
+    return m_executor;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::setIslandTaskSizes(const std::size_t& islandBatchSize,
+                                                               const std::size_t& largeIslandSize)
+{
+    m_islandBatchSize = std::max(islandBatchSize,std::size_t(1));
+    m_largeIslandSize = std::max(largeIslandSize,std::size_t(1));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::size_t& blConstraintSolver<blDataType>::getIslandBatchSize()const
+{
+    return m_islandBatchSize;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::size_t& blConstraintSolver<blDataType>::getLargeIslandSize()const
+{
+    return m_largeIslandSize;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blDynamicAABBTree<blDataType>& blConstraintSolver<blDataType>::getBroadphase()
+{
+    return m_broadphase;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blBoxBoxNarrowphase<blDataType>& blConstraintSolver<blDataType>::getNarrowphase()
+{
+    return m_narrowphase;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector< blContactManifold<blDataType> >& blConstraintSolver<blDataType>::getContactManifolds()const
+{
+    return m_manifolds;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector< blAABB<blDataType> >& blConstraintSolver<blDataType>::getBoundingBoxes()const
+{
+    return m_boundingBoxes;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<typename blConstraintSolver<blDataType>::blPairType>& blConstraintSolver<blDataType>::getPairs()const
+{
+    return m_pairs;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::clearCache()
+{
+    m_cachedContacts.clear();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blRigidBodyPointerType>
+inline void blConstraintSolver<blDataType>::step(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                 const std::vector<blBallJoint<blDataType>*>& joints,
+                                                 const blDataType& timeStep)
+{
+    // Step 1:  Find the pairs
+    //          of bodies whose
+    //          boxes overlap
+
+    m_boundingBoxes.resize(rigidBodies.size());
+
+    for(std::size_t i = 0; i < rigidBodies.size(); ++i)
+        m_boundingBoxes[i].setFromRigidBody(*rigidBodies[i]);
+
+    m_broadphase.update(m_boundingBoxes);
+    m_broadphase.findPairs(m_pairs);
+
+    // Step 2:  Drop the pairs
+    //          held together by
+    //          a joint
+
+    if(!joints.empty())
+    {
+        m_bodyLookup.clear();
+
+        for(std::size_t i = 0; i < rigidBodies.size(); ++i)
+            m_bodyLookup.push_back(std::make_pair(static_cast<blRigidBody<blDataType>*>(&(*rigidBodies[i])),i));
+
+        std::sort(m_bodyLookup.begin(),m_bodyLookup.end());
+
+        m_jointPairs.clear();
+
+        for(std::size_t i = 0; i < joints.size(); ++i)
+        {
+            if(!joints[i] || !joints[i]->getRigidBody1() || !joints[i]->getRigidBody2())
+                continue;
+
+            typename std::vector< std::pair<blRigidBody<blDataType>*,std::size_t> >::iterator body1 = std::lower_bound(m_bodyLookup.begin(),
+                                                                                                                       m_bodyLookup.end(),
+                                                                                                                       std::make_pair(joints[i]->getRigidBody1(),std::size_t(0)));
+
+            typename std::vector< std::pair<blRigidBody<blDataType>*,std::size_t> >::iterator body2 = std::lower_bound(m_bodyLookup.begin(),
+                                                                                                                       m_bodyLookup.end(),
+                                                                                                                       std::make_pair(joints[i]->getRigidBody2(),std::size_t(0)));
+
+            if(body1 == m_bodyLookup.end() || body1->first != joints[i]->getRigidBody1() ||
+               body2 == m_bodyLookup.end() || body2->first != joints[i]->getRigidBody2())
+                continue;
+
+            m_jointPairs.push_back(blPairType(std::min(body1->second,body2->second),
+                                              std::max(body1->second,body2->second)));
+        }
+
+        std::sort(m_jointPairs.begin(),m_jointPairs.end());
+
+        const std::vector<blPairType>& jointPairs = m_jointPairs;
+
+        m_pairs.erase(std::remove_if(m_pairs.begin(),
+                                     m_pairs.end(),
+                                     [&jointPairs](const blPairType& pair){return std::binary_search(jointPairs.begin(),jointPairs.end(),pair);}),
+                      m_pairs.end());
+    }
+
+    // Step 3:  Find their
+    //          contacts
+
+    m_narrowphase.findContacts(rigidBodies,m_pairs,m_manifolds);
+
+    // Step 4:  Solve
+
+    solve(rigidBodies,m_manifolds,joints,timeStep);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blRigidBodyPointerType>
+inline void blConstraintSolver<blDataType>::solve(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                  const std::vector< blContactManifold<blDataType> >& manifolds,
+                                                  const std::vector<blBallJoint<blDataType>*>& joints,
+                                                  const blDataType& timeStep)
+{
+    if(timeStep <= 0)
+        return;
+
+    // Step 1:  Collect the bodies,
+    //          the given ones first so
+    //          the manifolds can index
+    //          them directly, joints
+    //          can add more
+
+    m_bodies.clear();
+    m_bodyLookup.clear();
+    m_inverseMasses.clear();
+    m_velocities.clear();
+    m_angularVelocities.clear();
+
+    for(std::size_t i = 0; i < rigidBodies.size(); ++i)
+        addBody(&(*rigidBodies[i]));
+
+    std::sort(m_bodyLookup.begin(),m_bodyLookup.end());
+    m_numberOfSortedBodies = m_bodyLookup.size();
+
+    // Step 2:  Get the
+    //          constraints ready
+
+    prepareContacts(manifolds,timeStep);
+    prepareJoints(joints,timeStep);
+
+    m_startingVelocities = m_velocities;
+    m_startingAngularVelocities = m_angularVelocities;
+
+    // Step 3:  Warm start and
+    //          iterate, island by
+    //          island when there
+    //          are threads to
+    //          share them
+
+    if(isParallel())
+    {
+        solveIslands();
+    }
+    else
+    {
+        if(m_isWarmStartingEnabled)
+            warmStart();
+
+        for(int iteration = 0; iteration < m_numberOfIterations; ++iteration)
+        {
+            solveJoints();
+            solveContacts();
+        }
+    }
+
+    // Step 4:  Keep the impulses
+    //          for the next step and
+    //          update the bodies
+
+    storeImpulses();
+    updateBodies(timeStep);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blConstraintSolver<blDataType>::addBody(blRigidBody<blDataType>* rigidBody)
+{
+    std::size_t bodyIndex = m_bodies.size();
+
+    m_bodies.push_back(rigidBody);
+    m_bodyLookup.push_back(std::make_pair(rigidBody,bodyIndex));
+
+    // Sleeping bodies don't
+    // move until their island
+    // wakes up
+
+    m_inverseMasses.push_back(rigidBody->getMass() > 0 && rigidBody->getIsAwake() ? blDataType(1) / rigidBody->getMass() : blDataType(0));
+    m_velocities.push_back(rigidBody->getVelocity());
+    m_angularVelocities.push_back(rigidBody->getAngularVelocity());
+
+    // The contacts read the
+    // body's axes and inverse
+    // inertia in system
+    // coordinates in parallel,
+    // so they're brought up
+    // to date here
+
+    rigidBody->updateWorldInertia();
+
+    return bodyIndex;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blConstraintSolver<blDataType>::findBody(blRigidBody<blDataType>* rigidBody)
+{
+    // The given bodies are
+    // sorted, the few added
+    // by joints are not
+
+    typename std::vector< std::pair<blRigidBody<blDataType>*,std::size_t> >::iterator sortedEnd = m_bodyLookup.begin() + m_numberOfSortedBodies;
+
+    typename std::vector< std::pair<blRigidBody<blDataType>*,std::size_t> >::iterator found = std::lower_bound(m_bodyLookup.begin(),
+                                                                                                               sortedEnd,
+                                                                                                               std::make_pair(rigidBody,std::size_t(0)));
+
+    if(found != sortedEnd && found->first == rigidBody)
+        return found->second;
+
+    for(std::size_t i = m_numberOfSortedBodies; i < m_bodyLookup.size(); ++i)
+    {
+        if(m_bodyLookup[i].first == rigidBody)
+            return m_bodyLookup[i].second;
+    }
+
+    return addBody(rigidBody);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blConstraintSolver<blDataType>::blVectorType blConstraintSolver<blDataType>::applyInverseInertia(const std::size_t& bodyIndex,
+                                                                                                                 const blVectorType& vector)const
+{
+    if(m_inverseMasses[bodyIndex] == 0)
+        return blVectorType(0,0,0);
+
+    // R * I^-1 * R^T * vector,
+    // cached by the body when
+    // it was added
+
+    return m_bodies[bodyIndex]->applyCachedWorldInertiaInverse(vector);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blDataType blConstraintSolver<blDataType>::getEffectiveMass(const std::size_t& body1,
+                                                                   const std::size_t& body2,
+                                                                   const blVectorType& r1,
+                                                                   const blVectorType& r2,
+                                                                   const blVectorType& direction)const
+{
+    blVectorType r1CrossDirection = crossProduct(r1,direction);
+    blVectorType r2CrossDirection = crossProduct(r2,direction);
+
+    blDataType inverseEffectiveMass = m_inverseMasses[body1] + m_inverseMasses[body2] +
+                                      r1CrossDirection * applyInverseInertia(body1,r1CrossDirection) +
+                                      r2CrossDirection * applyInverseInertia(body2,r2CrossDirection);
+
+    return inverseEffectiveMass > 0 ? blDataType(1) / inverseEffectiveMass : blDataType(0);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blConstraintSolver<blDataType>::blVectorType blConstraintSolver<blDataType>::getRelativeVelocity(const std::size_t& body1,
+                                                                                                                 const std::size_t& body2,
+                                                                                                                 const blVectorType& r1,
+                                                                                                                 const blVectorType& r2)const
+{
+    return m_velocities[body2] + crossProduct(m_angularVelocities[body2],r2) -
+           m_velocities[body1] - crossProduct(m_angularVelocities[body1],r1);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::applyImpulse(const std::size_t& body1,
+                                                         const std::size_t& body2,
+                                                         const blVectorType& r1,
+                                                         const blVectorType& r2,
+                                                         const blVectorType& impulse)
+{
+    // Bodies that don't move
+    // are never written, so
+    // islands sharing them can
+    // be solved at the same time
+
+    if(m_inverseMasses[body1] > 0)
+    {
+        m_velocities[body1] -= impulse * m_inverseMasses[body1];
+        m_angularVelocities[body1] -= applyInverseInertia(body1,crossProduct(r1,impulse));
+    }
+
+    if(m_inverseMasses[body2] > 0)
+    {
+        m_velocities[body2] += impulse * m_inverseMasses[body2];
+        m_angularVelocities[body2] += applyInverseInertia(body2,crossProduct(r2,impulse));
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::prepareContacts(const std::vector< blContactManifold<blDataType> >& manifolds,
+                                                            const blDataType& timeStep)
+{
+    m_contactConstraints.resize(manifolds.size());
+
+    // Each contact only
+    // writes its own constraint
+
+    if(isParallel())
+    {
+        m_executor->parallelFor(manifolds.size(),
+                                [this,&manifolds,&timeStep](const std::size_t& beginIndex,const std::size_t& endIndex)
+                                {
+                                    for(std::size_t i = beginIndex; i < endIndex; ++i)
+                                        prepareContact(manifolds,i,timeStep);
+                                });
+    }
+    else
+    {
+        for(std::size_t i = 0; i < manifolds.size(); ++i)
+            prepareContact(manifolds,i,timeStep);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::prepareContact(const std::vector< blContactManifold<blDataType> >& manifolds,
+                                                           const std::size_t& contactIndex,
+                                                           const blDataType& timeStep)
+{
+    const blContactManifold<blDataType>& manifold = manifolds[contactIndex];
+    blContactConstraint& constraint = m_contactConstraints[contactIndex];
+
+    constraint.m_body1 = manifold.getFirstBodyIndex();
+    constraint.m_body2 = manifold.getSecondBodyIndex();
+    constraint.m_normal = manifold.getNormal();
+    constraint.m_numberOfPoints = manifold.getNumberOfContactPoints();
+
+    // Step 1:  Two friction
+    //          directions across
+    //          the normal
+
+    const blVectorType& normal = constraint.m_normal;
+
+    if(std::abs(normal.x()) >= blDataType(0.57735))
+        constraint.m_tangents[0] = blMathAPI::getNormalized(blVectorType(normal.y(),-normal.x(),0));
+    else
+        constraint.m_tangents[0] = blMathAPI::getNormalized(blVectorType(0,normal.z(),-normal.y()));
+
+    constraint.m_tangents[1] = crossProduct(normal,constraint.m_tangents[0]);
+
+    // Step 2:  Last step's
+    //          impulses for this
+    //          pair, if any
+
+    const blCachedContacts* cachedContacts = nullptr;
+
+    blCachedContacts key;
+    key.m_pair = blPairType(constraint.m_body1,constraint.m_body2);
+
+    typename std::vector<blCachedContacts>::const_iterator found = std::lower_bound(m_cachedContacts.begin(),
+                                                                                    m_cachedContacts.end(),
+                                                                                    key,
+                                                                                    [](const blCachedContacts& a,const blCachedContacts& b){return a.m_pair < b.m_pair;});
+
+    if(found != m_cachedContacts.end() && found->m_pair == key.m_pair)
+        cachedContacts = &(*found);
+
+    const blRigidBody<blDataType>* body1 = m_bodies[constraint.m_body1];
+    const blRigidBody<blDataType>* body2 = m_bodies[constraint.m_body2];
+
+    // Step 3:  The points
+
+    for(std::size_t j = 0; j < constraint.m_numberOfPoints; ++j)
+    {
+        blContactPointConstraint& point = constraint.m_points[j];
+
+        const blVectorType& contactPoint = manifold.getContactPoint(j);
+
+        point.m_r1 = contactPoint - body1->getPosition();
+        point.m_r2 = contactPoint - body2->getPosition();
+
+        point.m_localPoint = blVectorType(point.m_r1 * body1->getxAxis(),
+                                          point.m_r1 * body1->getyAxis(),
+                                          point.m_r1 * body1->getzAxis());
+
+        point.m_normalMass = getEffectiveMass(constraint.m_body1,constraint.m_body2,point.m_r1,point.m_r2,normal);
+        point.m_tangentMasses[0] = getEffectiveMass(constraint.m_body1,constraint.m_body2,point.m_r1,point.m_r2,constraint.m_tangents[0]);
+        point.m_tangentMasses[1] = getEffectiveMass(constraint.m_body1,constraint.m_body2,point.m_r1,point.m_r2,constraint.m_tangents[1]);
+
+        // The separating speed we
+        // aim for, enough to push
+        // out the penetration and
+        // to bounce back
+
+        blDataType normalVelocity = getRelativeVelocity(constraint.m_body1,constraint.m_body2,point.m_r1,point.m_r2) * normal;
+
+        point.m_targetVelocity = m_baumgarteFactor / timeStep * std::max(manifold.getDepth(j) - m_allowedPenetration,blDataType(0));
+
+        if(normalVelocity < -m_restitutionThreshold)
+            point.m_targetVelocity = std::max(point.m_targetVelocity,-manifold.getRestitutionCoefficient() * normalVelocity);
+
+        // Pick up the impulses
+        // of the closest matching
+        // contact from last step
+
+        point.m_normalImpulse = 0;
+        point.m_tangentImpulses[0] = 0;
+        point.m_tangentImpulses[1] = 0;
+
+        if(cachedContacts)
+        {
+            blDataType bestDistance = m_contactMatchingDistance * m_contactMatchingDistance;
+
+            for(std::size_t k = 0; k < cachedContacts->m_numberOfPoints; ++k)
+            {
+                blVectorType offset = cachedContacts->m_localPoints[k] - point.m_localPoint;
+                blDataType distance = offset * offset;
+
+                if(distance <= bestDistance)
+                {
+                    bestDistance = distance;
+
+                    point.m_normalImpulse = cachedContacts->m_normalImpulses[k];
+                    point.m_tangentImpulses[0] = cachedContacts->m_tangentImpulses[k][0];
+                    point.m_tangentImpulses[1] = cachedContacts->m_tangentImpulses[k][1];
+                }
+            }
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::prepareJoints(const std::vector<blBallJoint<blDataType>*>& joints,
+                                                          const blDataType& timeStep)
+{
+    m_jointConstraints.clear();
+
+    for(std::size_t i = 0; i < joints.size(); ++i)
+    {
+        blBallJoint<blDataType>* joint = joints[i];
+
+        if(!joint || !joint->getRigidBody1() || !joint->getRigidBody2())
+            continue;
+
+        blJointConstraint constraint;
+
+        constraint.m_joint = joint;
+        constraint.m_body1 = findBody(joint->getRigidBody1());
+        constraint.m_body2 = findBody(joint->getRigidBody2());
+
+        // Step 1:  The anchors
+        //          in system
+        //          coordinates
+
+        blVectorType anchor1 = joint->getRigidBody1ConnectionPosition();
+        blVectorType anchor2 = joint->getRigidBody2ConnectionPosition();
+
+        joint->getRigidBody1()->fromBodyToSystemCoordinates(anchor1);
+        joint->getRigidBody2()->fromBodyToSystemCoordinates(anchor2);
+
+        constraint.m_r1 = anchor1 - joint->getRigidBody1()->getPosition();
+        constraint.m_r2 = anchor2 - joint->getRigidBody2()->getPosition();
+
+        // Step 2:  Build the mass
+        //          matrix column by
+        //          column and invert it
+        //
+        //          K*e = (m1^-1 + m2^-1)*e +
+        //                (I1^-1 (r1 x e)) x r1 +
+        //                (I2^-1 (r2 x e)) x r2
+
+        blDataType k[3][3];
+
+        for(int column = 0; column < 3; ++column)
+        {
+            blVectorType e(column == 0 ? 1 : 0,column == 1 ? 1 : 0,column == 2 ? 1 : 0);
+
+            blVectorType kColumn = e * (m_inverseMasses[constraint.m_body1] + m_inverseMasses[constraint.m_body2]) +
+                                   crossProduct(applyInverseInertia(constraint.m_body1,crossProduct(constraint.m_r1,e)),constraint.m_r1) +
+                                   crossProduct(applyInverseInertia(constraint.m_body2,crossProduct(constraint.m_r2,e)),constraint.m_r2);
+
+            k[0][column] = kColumn.x();
+            k[1][column] = kColumn.y();
+            k[2][column] = kColumn.z();
+        }
+
+        blDataType determinant = k[0][0] * (k[1][1] * k[2][2] - k[1][2] * k[2][1]) -
+                                 k[0][1] * (k[1][0] * k[2][2] - k[1][2] * k[2][0]) +
+                                 k[0][2] * (k[1][0] * k[2][1] - k[1][1] * k[2][0]);
+
+        if(determinant == 0)
+            continue;
+
+        blDataType inverseDeterminant = blDataType(1) / determinant;
+
+        for(int row = 0; row < 3; ++row)
+        {
+            for(int column = 0; column < 3; ++column)
+            {
+                // The cofactors, transposed
+
+                int r1 = (column + 1) % 3;
+                int r2 = (column + 2) % 3;
+                int c1 = (row + 1) % 3;
+                int c2 = (row + 2) % 3;
+
+                constraint.m_mass[row][column] = (k[r1][c1] * k[r2][c2] - k[r1][c2] * k[r2][c1]) * inverseDeterminant;
+            }
+        }
+
+        // Step 3:  Bias pulling
+        //          the anchors back
+        //          together
+
+        constraint.m_bias = (anchor2 - anchor1) * (m_baumgarteFactor / timeStep);
+
+        constraint.m_impulse = m_isWarmStartingEnabled ? joint->getAccumulatedImpulse() : blVectorType(0,0,0);
+
+        m_jointConstraints.push_back(constraint);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::warmStart()
+{
+    for(std::size_t i = 0; i < m_jointConstraints.size(); ++i)
+        warmStartJoint(i);
+
+    for(std::size_t i = 0; i < m_contactConstraints.size(); ++i)
+        warmStartContact(i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::warmStartJoint(const std::size_t& jointIndex)
+{
+    const blJointConstraint& constraint = m_jointConstraints[jointIndex];
+
+    applyImpulse(constraint.m_body1,constraint.m_body2,constraint.m_r1,constraint.m_r2,constraint.m_impulse);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::warmStartContact(const std::size_t& contactIndex)
+{
+    const blContactConstraint& constraint = m_contactConstraints[contactIndex];
+
+    if(m_inverseMasses[constraint.m_body1] == 0 && m_inverseMasses[constraint.m_body2] == 0)
+        return;
+
+    for(std::size_t j = 0; j < constraint.m_numberOfPoints; ++j)
+    {
+        const blContactPointConstraint& point = constraint.m_points[j];
+
+        blVectorType impulse = constraint.m_normal * point.m_normalImpulse +
+                               constraint.m_tangents[0] * point.m_tangentImpulses[0] +
+                               constraint.m_tangents[1] * point.m_tangentImpulses[1];
+
+        applyImpulse(constraint.m_body1,constraint.m_body2,point.m_r1,point.m_r2,impulse);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::solveJoints()
+{
+    for(std::size_t i = 0; i < m_jointConstraints.size(); ++i)
+        solveJoint(i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::solveJoint(const std::size_t& jointIndex)
+{
+    blJointConstraint& constraint = m_jointConstraints[jointIndex];
+
+    // The anchors should
+    // move together, and
+    // drift back together
+
+    blVectorType error = getRelativeVelocity(constraint.m_body1,constraint.m_body2,constraint.m_r1,constraint.m_r2) + constraint.m_bias;
+
+    blVectorType impulse(-(constraint.m_mass[0][0] * error.x() + constraint.m_mass[0][1] * error.y() + constraint.m_mass[0][2] * error.z()),
+                         -(constraint.m_mass[1][0] * error.x() + constraint.m_mass[1][1] * error.y() + constraint.m_mass[1][2] * error.z()),
+                         -(constraint.m_mass[2][0] * error.x() + constraint.m_mass[2][1] * error.y() + constraint.m_mass[2][2] * error.z()));
+
+    constraint.m_impulse += impulse;
+
+    applyImpulse(constraint.m_body1,constraint.m_body2,constraint.m_r1,constraint.m_r2,impulse);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::solveContacts()
+{
+    for(std::size_t i = 0; i < m_contactConstraints.size(); ++i)
+        solveContact(i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::solveContact(const std::size_t& contactIndex)
+{
+    blContactConstraint& constraint = m_contactConstraints[contactIndex];
+
+    // Contacts between sleeping
+    // or massless bodies keep
+    // their impulses as they are
+
+    if(m_inverseMasses[constraint.m_body1] == 0 && m_inverseMasses[constraint.m_body2] == 0)
+        return;
+
+    for(std::size_t j = 0; j < constraint.m_numberOfPoints; ++j)
+    {
+        blContactPointConstraint& point = constraint.m_points[j];
+
+        // Step 1:  Friction, bounded
+        //          by the current
+        //          normal impulse
+
+        blDataType maxFrictionImpulse = m_frictionCoefficient * point.m_normalImpulse;
+
+        for(int t = 0; t < 2; ++t)
+        {
+            blDataType tangentVelocity = getRelativeVelocity(constraint.m_body1,constraint.m_body2,point.m_r1,point.m_r2) * constraint.m_tangents[t];
+
+            blDataType oldImpulse = point.m_tangentImpulses[t];
+
+            point.m_tangentImpulses[t] = std::min(std::max(oldImpulse - point.m_tangentMasses[t] * tangentVelocity,
+                                                           -maxFrictionImpulse),
+                                                  maxFrictionImpulse);
+
+            applyImpulse(constraint.m_body1,constraint.m_body2,point.m_r1,point.m_r2,
+                         constraint.m_tangents[t] * (point.m_tangentImpulses[t] - oldImpulse));
+        }
+
+        // Step 2:  Non-penetration,
+        //          the total impulse
+        //          can only push
+
+        blDataType normalVelocity = getRelativeVelocity(constraint.m_body1,constraint.m_body2,point.m_r1,point.m_r2) * constraint.m_normal;
+
+        blDataType oldImpulse = point.m_normalImpulse;
+
+        point.m_normalImpulse = std::max(oldImpulse + point.m_normalMass * (point.m_targetVelocity - normalVelocity),
+                                         blDataType(0));
+
+        applyImpulse(constraint.m_body1,constraint.m_body2,point.m_r1,point.m_r2,
+                     constraint.m_normal * (point.m_normalImpulse - oldImpulse));
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::storeImpulses()
+{
+    // Joints keep
+    // their own
+
+    for(std::size_t i = 0; i < m_jointConstraints.size(); ++i)
+        m_jointConstraints[i].m_joint->setAccumulatedImpulse(m_jointConstraints[i].m_impulse);
+
+    // Contacts are kept
+    // sorted by pair
+
+    m_newCachedContacts.resize(m_contactConstraints.size());
+
+    for(std::size_t i = 0; i < m_contactConstraints.size(); ++i)
+    {
+        const blContactConstraint& constraint = m_contactConstraints[i];
+        blCachedContacts& cachedContacts = m_newCachedContacts[i];
+
+        cachedContacts.m_pair = blPairType(constraint.m_body1,constraint.m_body2);
+        cachedContacts.m_numberOfPoints = constraint.m_numberOfPoints;
+
+        for(std::size_t j = 0; j < constraint.m_numberOfPoints; ++j)
+        {
+            cachedContacts.m_localPoints[j] = constraint.m_points[j].m_localPoint;
+            cachedContacts.m_normalImpulses[j] = constraint.m_points[j].m_normalImpulse;
+            cachedContacts.m_tangentImpulses[j][0] = constraint.m_points[j].m_tangentImpulses[0];
+            cachedContacts.m_tangentImpulses[j][1] = constraint.m_points[j].m_tangentImpulses[1];
+        }
+    }
+
+    std::sort(m_newCachedContacts.begin(),
+              m_newCachedContacts.end(),
+              [](const blCachedContacts& a,const blCachedContacts& b){return a.m_pair < b.m_pair;});
+
+    m_cachedContacts.swap(m_newCachedContacts);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::updateBodies(const blDataType& timeStep)
+{
+    if(isParallel())
+    {
+        m_executor->parallelFor(m_bodies.size(),
+                                [this,&timeStep](const std::size_t& beginIndex,const std::size_t& endIndex)
+                                {
+                                    for(std::size_t i = beginIndex; i < endIndex; ++i)
+                                        updateBody(i,timeStep);
+                                });
+    }
+    else
+    {
+        for(std::size_t i = 0; i < m_bodies.size(); ++i)
+            updateBody(i,timeStep);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::updateBody(const std::size_t& bodyIndex,
+                                                       const blDataType& timeStep)
+{
+    if(m_inverseMasses[bodyIndex] == 0)
+        return;
+
+    blVectorType velocityChange = m_velocities[bodyIndex] - m_startingVelocities[bodyIndex];
+    blVectorType angularVelocityChange = m_angularVelocities[bodyIndex] - m_startingAngularVelocities[bodyIndex];
+
+    blRigidBody<blDataType>* body = m_bodies[bodyIndex];
+
+    // Step 1:  The new
+    //          velocities
+
+    body->setVelocity(m_velocities[bodyIndex]);
+    body->setAngularVelocity(m_angularVelocities[bodyIndex]);
+
+    // Step 2:  Move the body
+    //          as if it had had
+    //          them all step long
+
+    if(velocityChange * velocityChange > 0)
+        body->translate(velocityChange * timeStep);
+
+    blDataType angularSpeedChange = blMathAPI::norm2(angularVelocityChange);
+
+    if(angularSpeedChange > 0)
+    {
+        blDataType theta = angularSpeedChange * timeStep;
+
+        blQuaternionType rotQtn(std::cos(theta/blDataType(2)),
+                                angularVelocityChange * (std::sin(theta/blDataType(2)) / angularSpeedChange));
+
+        body->blOrientation<blDataType>::rotate(rotQtn);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::getConstraintBodies(const std::size_t& constraintId,
+                                                                std::size_t& body1,
+                                                                std::size_t& body2)const
+{
+    if(constraintId < m_jointConstraints.size())
+    {
+        body1 = m_jointConstraints[constraintId].m_body1;
+        body2 = m_jointConstraints[constraintId].m_body2;
+    }
+    else
+    {
+        body1 = m_contactConstraints[constraintId - m_jointConstraints.size()].m_body1;
+        body2 = m_contactConstraints[constraintId - m_jointConstraints.size()].m_body2;
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::warmStartConstraint(const std::size_t& constraintId)
+{
+    if(constraintId < m_jointConstraints.size())
+        warmStartJoint(constraintId);
+    else
+        warmStartContact(constraintId - m_jointConstraints.size());
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::solveConstraint(const std::size_t& constraintId)
+{
+    if(constraintId < m_jointConstraints.size())
+        solveJoint(constraintId);
+    else
+        solveContact(constraintId - m_jointConstraints.size());
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blConstraintSolver<blDataType>::isParallel()const
+{
+    return m_executor && m_executor->getNumberOfThreads() > 1;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::buildIslandTasks()
+{
+    std::size_t numberOfConstraints = m_jointConstraints.size() + m_contactConstraints.size();
+
+    // Step 1:  Bodies that move
+    //          and share a constraint
+    //          are in the same island,
+    //          bodies that don't move
+    //          link nothing
+
+    m_islandLinks.clear();
+
+    for(std::size_t i = 0; i < numberOfConstraints; ++i)
+    {
+        std::size_t body1,body2;
+        getConstraintBodies(i,body1,body2);
+
+        if(m_inverseMasses[body1] > 0 && m_inverseMasses[body2] > 0)
+            m_islandLinks.push_back(blPairType(body1,body2));
+    }
+
+    m_islandManager.buildIslands(m_bodies,m_islandLinks);
+
+    std::size_t numberOfIslands = m_islandManager.getNumberOfIslands();
+
+    // Step 2:  Sort the constraints
+    //          island by island, keeping
+    //          their order (joints first)
+    //          within each island
+
+    m_constraintIslands.resize(numberOfConstraints);
+    m_islandConstraintStarts.assign(numberOfIslands + 1,0);
+
+    for(std::size_t i = 0; i < numberOfConstraints; ++i)
+    {
+        std::size_t body1,body2;
+        getConstraintBodies(i,body1,body2);
+
+        std::size_t island = blIslandManager<blDataType>::nullIsland;
+
+        if(m_inverseMasses[body1] > 0)
+            island = m_islandManager.getIsland(body1);
+        else if(m_inverseMasses[body2] > 0)
+            island = m_islandManager.getIsland(body2);
+
+        m_constraintIslands[i] = island;
+
+        if(island != blIslandManager<blDataType>::nullIsland)
+            ++m_islandConstraintStarts[island + 1];
+    }
+
+    for(std::size_t i = 0; i < numberOfIslands; ++i)
+        m_islandConstraintStarts[i + 1] += m_islandConstraintStarts[i];
+
+    m_islandConstraints.resize(m_islandConstraintStarts[numberOfIslands]);
+    m_colorCounts.assign(m_islandConstraintStarts.begin(),m_islandConstraintStarts.end() - 1);
+
+    for(std::size_t i = 0; i < numberOfConstraints; ++i)
+    {
+        if(m_constraintIslands[i] != blIslandManager<blDataType>::nullIsland)
+            m_islandConstraints[m_colorCounts[m_constraintIslands[i]]++] = i;
+    }
+
+    // Step 3:  Small islands are
+    //          batched together, large
+    //          ones are split by color
+
+    m_islandTasks.clear();
+    m_colorStarts.clear();
+    m_bodyColorMasks.assign(m_bodies.size(),0);
+
+    blIslandTask batch;
+    batch.m_begin = 0;
+    batch.m_end = 0;
+    batch.m_firstColor = 0;
+    batch.m_numberOfColors = 0;
+
+    for(std::size_t i = 0; i < numberOfIslands; ++i)
+    {
+        std::size_t begin = m_islandConstraintStarts[i];
+        std::size_t end = m_islandConstraintStarts[i + 1];
+
+        if(end - begin >= m_largeIslandSize)
+        {
+            if(batch.m_end > batch.m_begin)
+                m_islandTasks.push_back(batch);
+
+            blIslandTask task;
+            task.m_begin = begin;
+            task.m_end = end;
+            task.m_firstColor = m_colorStarts.size();
+
+            colorIsland(begin,end);
+
+            task.m_numberOfColors = m_colorStarts.size() - task.m_firstColor - 1;
+
+            m_islandTasks.push_back(task);
+
+            batch.m_begin = end;
+            batch.m_end = end;
+        }
+        else
+        {
+            batch.m_end = end;
+
+            if(batch.m_end - batch.m_begin >= m_islandBatchSize)
+            {
+                m_islandTasks.push_back(batch);
+
+                batch.m_begin = end;
+            }
+        }
+    }
+
+    if(batch.m_end > batch.m_begin)
+        m_islandTasks.push_back(batch);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::colorIsland(const std::size_t& begin,
+                                                        const std::size_t& end)
+{
+    // Step 1:  Greedily give each
+    //          constraint the first
+    //          color none of its moving
+    //          bodies has yet, the ones
+    //          left over get the last
+    //          color, solved serially
+
+    m_constraintColors.resize(end - begin);
+    m_colorCounts.assign(BL_MAX_ISLAND_COLORS + 1,0);
+
+    std::size_t numberOfColors = 0;
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+        std::size_t body1,body2;
+        getConstraintBodies(m_islandConstraints[i],body1,body2);
+
+        std::uint64_t usedColors = 0;
+
+        if(m_inverseMasses[body1] > 0)
+            usedColors |= m_bodyColorMasks[body1];
+
+        if(m_inverseMasses[body2] > 0)
+            usedColors |= m_bodyColorMasks[body2];
+
+        std::size_t color = 0;
+
+        while(color < BL_MAX_ISLAND_COLORS && (usedColors & (std::uint64_t(1) << color)))
+            ++color;
+
+        if(color < BL_MAX_ISLAND_COLORS)
+        {
+            if(m_inverseMasses[body1] > 0)
+                m_bodyColorMasks[body1] |= std::uint64_t(1) << color;
+
+            if(m_inverseMasses[body2] > 0)
+                m_bodyColorMasks[body2] |= std::uint64_t(1) << color;
+        }
+
+        m_constraintColors[i - begin] = color;
+        ++m_colorCounts[color];
+
+        numberOfColors = std::max(numberOfColors,color + 1);
+    }
+
+    // Step 2:  Sort the island's
+    //          constraints by color
+
+    std::size_t start = begin;
+
+    for(std::size_t color = 0; color < numberOfColors; ++color)
+    {
+        m_colorStarts.push_back(start);
+
+        std::size_t count = m_colorCounts[color];
+        m_colorCounts[color] = start - begin;
+        start += count;
+    }
+
+    m_colorStarts.push_back(end);
+
+    m_coloredConstraints.resize(end - begin);
+
+    for(std::size_t i = begin; i < end; ++i)
+        m_coloredConstraints[m_colorCounts[m_constraintColors[i - begin]]++] = m_islandConstraints[i];
+
+    std::copy(m_coloredConstraints.begin(),m_coloredConstraints.end(),m_islandConstraints.begin() + begin);
+
+    // Step 3:  Clear the colors
+    //          of the island's bodies
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+        std::size_t body1,body2;
+        getConstraintBodies(m_islandConstraints[i],body1,body2);
+
+        m_bodyColorMasks[body1] = 0;
+        m_bodyColorMasks[body2] = 0;
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::solveIslandTask(const std::size_t& taskIndex)
+{
+    const blIslandTask& task = m_islandTasks[taskIndex];
+
+    // The warm start
+    // is pass -1
+
+    int firstPass = m_isWarmStartingEnabled ? -1 : 0;
+
+    // Step 1:  Small islands are
+    //          solved one constraint
+    //          after the other, just
+    //          like the serial solver
+
+    if(task.m_numberOfColors == 0)
+    {
+        for(int pass = firstPass; pass < m_numberOfIterations; ++pass)
+        {
+            for(std::size_t i = task.m_begin; i < task.m_end; ++i)
+            {
+                if(pass < 0)
+                    warmStartConstraint(m_islandConstraints[i]);
+                else
+                    solveConstraint(m_islandConstraints[i]);
+            }
+        }
+
+        return;
+    }
+
+    // Step 2:  A large island is
+    //          solved color by color,
+    //          the constraints of one
+    //          color in parallel
+
+    for(int pass = firstPass; pass < m_numberOfIterations; ++pass)
+    {
+        for(std::size_t color = 0; color < task.m_numberOfColors; ++color)
+        {
+            std::size_t colorBegin = m_colorStarts[task.m_firstColor + color];
+            std::size_t colorEnd = m_colorStarts[task.m_firstColor + color + 1];
+
+            if(color == BL_MAX_ISLAND_COLORS)
+            {
+                for(std::size_t i = colorBegin; i < colorEnd; ++i)
+                {
+                    if(pass < 0)
+                        warmStartConstraint(m_islandConstraints[i]);
+                    else
+                        solveConstraint(m_islandConstraints[i]);
+                }
+
+                continue;
+            }
+
+            m_executor->parallelFor(colorEnd - colorBegin,
+                                    [this,pass,colorBegin](const std::size_t& beginIndex,const std::size_t& endIndex)
+                                    {
+                                        for(std::size_t i = colorBegin + beginIndex; i < colorBegin + endIndex; ++i)
+                                        {
+                                            if(pass < 0)
+                                                warmStartConstraint(m_islandConstraints[i]);
+                                            else
+                                                solveConstraint(m_islandConstraints[i]);
+                                        }
+                                    });
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blConstraintSolver<blDataType>::solveIslands()
+{
+    buildIslandTasks();
+
+    m_executor->parallelFor(m_islandTasks.size(),
+                            [this](const std::size_t& beginIndex,const std::size_t& endIndex)
+                            {
+                                for(std::size_t i = beginIndex; i < endIndex; ++i)
+                                    solveIslandTask(i);
+                            });
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_CONSTRAINTSOLVER_HPP
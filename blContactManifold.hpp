@@ -0,0 +1,268 @@
+#ifndef BL_CONTACTMANIFOLD_HPP
+#define BL_CONTACTMANIFOLD_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blContactManifold.hpp
+// CLASS:           blContactManifold
+// BASE CLASS:      None
+//
+// PURPOSE:         The contact points found between two touching
+//                  bodies, sharing one normal, each with its own
+//                  penetration depth
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blMathAPI::blVector3d
+//
+// NOTES:           - The normal points from the first body to the
+//                    second one, pushing the second body along the
+//                    normal by the depth separates them
+//                  - A manifold holds at most four points
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+
+    // The most contact points
+    // kept in a manifold
+    enum {BL_MAX_CONTACT_POINTS = 4};
+
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blContactManifold
+{
+public: // Public typedefs
+
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blContactManifold(const std::size_t& firstBodyIndex = 0,
+                      const std::size_t& secondBodyIndex = 0);
+
+    // Destructor
+
+    ~blContactManifold()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // set/get the indices of
+    // the two bodies touching
+
+    void                                                setBodyIndices(const std::size_t& firstBodyIndex,
+                                                                       const std::size_t& secondBodyIndex);
+
+    const std::size_t&                                  getFirstBodyIndex()const;
+    const std::size_t&                                  getSecondBodyIndex()const;
+
+    // Functions used to
+    // set/get the normal
+
+    void                                                setNormal(const blVectorType& normal);
+    const blVectorType&                                 getNormal()const;
+
+    // Functions used to
+    // set/get the restitution
+    // coefficient along the
+    // normal
+
+    void                                                setRestitutionCoefficient(const blDataType& restitutionCoefficient);
+    const blDataType&                                   getRestitutionCoefficient()const;
+
+    // Functions used to
+    // add/get the contact
+    // points, addContactPoint
+    // ignores points past the
+    // fourth one
+
+    void                                                addContactPoint(const blVectorType& position,
+                                                                        const blDataType& depth);
+
+    std::size_t                                         getNumberOfContactPoints()const;
+    const blVectorType&                                 getContactPoint(const std::size_t& index)const;
+    const blDataType&                                   getDepth(const std::size_t& index)const;
+
+    // Function used to
+    // remove all the points
+
+    void                                                clearContactPoints();
+
+private: // Private variables
+
+    // The bodies
+
+    std::size_t                                         m_firstBodyIndex;
+    std::size_t                                         m_secondBodyIndex;
+
+    // The normal and
+    // restitution
+
+    blVectorType                                        m_normal;
+    blDataType                                          m_restitutionCoefficient;
+
+    // The contact points
+
+    blVectorType                                        m_contactPoints[BL_MAX_CONTACT_POINTS];
+    blDataType                                          m_depths[BL_MAX_CONTACT_POINTS];
+    std::size_t                                         m_numberOfContactPoints;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blContactManifold<blDataType>::blContactManifold(const std::size_t& firstBodyIndex,
+                                                        const std::size_t& secondBodyIndex)
+                                                        : m_firstBodyIndex(firstBodyIndex),
+                                                          m_secondBodyIndex(secondBodyIndex),
+                                                          m_normal(0,0,0),
+                                                          m_restitutionCoefficient(1),
+                                                          m_numberOfContactPoints(0)
+{
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blContactManifold<blDataType>::setBodyIndices(const std::size_t& firstBodyIndex,
+                                                          const std::size_t& secondBodyIndex)
+{
+    m_firstBodyIndex = firstBodyIndex;
+    m_secondBodyIndex = secondBodyIndex;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::size_t& blContactManifold<blDataType>::getFirstBodyIndex()const
+{
+    return m_firstBodyIndex;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::size_t& blContactManifold<blDataType>::getSecondBodyIndex()const
+{
+    return m_secondBodyIndex;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blContactManifold<blDataType>::setNormal(const blVectorType& normal)
+{
+    m_normal = normal;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const typename blContactManifold<blDataType>::blVectorType& blContactManifold<blDataType>::getNormal()const
+{
+    return m_normal;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blContactManifold<blDataType>::setRestitutionCoefficient(const blDataType& restitutionCoefficient)
+{
+    m_restitutionCoefficient = restitutionCoefficient;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blContactManifold<blDataType>::getRestitutionCoefficient()const
+{
+    return m_restitutionCoefficient;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blContactManifold<blDataType>::addContactPoint(const blVectorType& position,
+                                                           const blDataType& depth)
+{
+    if(m_numberOfContactPoints >= BL_MAX_CONTACT_POINTS)
+        return;
+
+    m_contactPoints[m_numberOfContactPoints] = position;
+    m_depths[m_numberOfContactPoints] = depth;
+
+    ++m_numberOfContactPoints;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blContactManifold<blDataType>::getNumberOfContactPoints()const
+{
+    return m_numberOfContactPoints;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const typename blContactManifold<blDataType>::blVectorType& blContactManifold<blDataType>::getContactPoint(const std::size_t& index)const
+{
+    return m_contactPoints[index];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blContactManifold<blDataType>::getDepth(const std::size_t& index)const
+{
+    return m_depths[index];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blContactManifold<blDataType>::clearContactPoints()
+{
+    m_numberOfContactPoints = 0;
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_CONTACTMANIFOLD_HPP
@@ -60,6 +60,16 @@ public: // Constructors and destructors
 
     blDamping(const blDamping<blDataType>& damping);
 
+    // Move constructor
+
+    blDamping(blDamping<blDataType>&& damping) = default;
+
+    // Copy and move
+    // assignments
+
+    blDamping<blDataType>&                                      operator=(const blDamping<blDataType>& damping) = default;
+    blDamping<blDataType>&                                      operator=(blDamping<blDataType>&& damping) = default;
+
     // Destructor
 
     ~blDamping()
@@ -0,0 +1,918 @@
+#ifndef BL_DYNAMICAABBTREE_HPP
+#define BL_DYNAMICAABBTREE_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blDynamicAABBTree.hpp
+// CLASS:           blDynamicAABBTree
+// BASE CLASS:      None
+//
+// PURPOSE:         A broadphase built as a dynamic bounding volume
+//                  hierarchy of fattened boxes, with box overlap
+//                  queries, ray casts and pair finding that only
+//                  descend into the branches they touch
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blAABB
+//
+// NOTES:           - Each proxy is a leaf holding its box grown by
+//                    a margin, a proxy that moves but stays inside
+//                    its fat box leaves the tree untouched, otherwise
+//                    only its leaf is taken out and inserted again
+//                  - Leaves are inserted next to the sibling that
+//                    grows the total surface area the least, and
+//                    the branches above them are rotated whenever
+//                    that makes them smaller
+//                  - The nodes live in one array and point to each
+//                    other by index, freed nodes are kept in a free
+//                    list and reused
+//                  - Pairs are returned as the proxies' user data
+//                    (for ex. the body indices), smaller first
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blDynamicAABBTree
+{
+public: // Public typedefs
+
+    typedef std::pair<std::size_t,std::size_t>          blPairType;
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+
+    // The index used for
+    // a missing node
+
+    static const std::size_t                            nullNode = std::size_t(-1);
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blDynamicAABBTree(const blDataType& margin = blDataType(0.1));
+
+    // Destructor
+
+    ~blDynamicAABBTree()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // set/get the margin
+    // by which the boxes
+    // are grown
+
+    void                                                setMargin(const blDataType& margin);
+    const blDataType&                                   getMargin()const;
+
+    // Functions used to
+    // add/remove/move a
+    // proxy, moveProxy
+    // returns true if the
+    // proxy had to be
+    // inserted again
+
+    std::size_t                                         createProxy(const blAABB<blDataType>& aabb,
+                                                                    const std::size_t& userData);
+
+    void                                                destroyProxy(const std::size_t& proxyID);
+
+    bool                                                moveProxy(const std::size_t& proxyID,
+                                                                  const blAABB<blDataType>& aabb);
+
+    // Functions used to
+    // get a proxy's fat
+    // box and user data
+
+    const blAABB<blDataType>&                           getFatAABB(const std::size_t& proxyID)const;
+    const std::size_t&                                  getUserData(const std::size_t& proxyID)const;
+
+    // Function used to
+    // keep one proxy per
+    // box, where each box's
+    // index is the user data
+    // of its proxy
+
+    void                                                update(const std::vector< blAABB<blDataType> >& boxes);
+
+    // Function used to
+    // find the proxies whose
+    // fat boxes overlap a box
+
+    void                                                query(const blAABB<blDataType>& aabb,
+                                                              std::vector<std::size_t>& proxyIDs)const;
+
+    // Function used to
+    // find the proxies whose
+    // fat boxes are hit by
+    // the segment going from
+    // origin along direction
+    // for maxDistance times
+    // the direction's length
+
+    void                                                rayCast(const blVectorType& origin,
+                                                                const blVectorType& direction,
+                                                                const blDataType& maxDistance,
+                                                                std::vector<std::size_t>& proxyIDs)const;
+
+    // Function used to
+    // find all the pairs of
+    // proxies whose fat boxes
+    // overlap
+
+    void                                                findPairs(std::vector<blPairType>& pairs);
+
+    // Functions used to
+    // get the tree's height
+    // and number of proxies
+
+    int                                                 getHeight()const;
+    std::size_t                                         getNumberOfProxies()const;
+
+    // Function used to
+    // remove all the proxies
+
+    void                                                clear();
+
+protected: // Protected functions
+
+    // Functions used to
+    // get/return nodes from/to
+    // the pool
+
+    std::size_t                                         allocateNode();
+    void                                                freeNode(const std::size_t& nodeID);
+
+    // Functions used to
+    // link/unlink a leaf
+
+    void                                                insertLeaf(const std::size_t& leafID);
+    void                                                removeLeaf(const std::size_t& leafID);
+
+    // Function used to
+    // refit the branches
+    // from a node up to the
+    // root, rotating them
+    // along the way
+
+    void                                                refitUpwards(std::size_t nodeID);
+
+    // Function used to
+    // rotate a node's children
+    // with its grandchildren
+    // when that shrinks them
+
+    void                                                rotate(const std::size_t& nodeID);
+
+    // Function used to
+    // refit a node from
+    // its two children
+
+    void                                                refitNode(const std::size_t& nodeID);
+
+    bool                                                isLeaf(const std::size_t& nodeID)const;
+
+private: // Private types
+
+    struct blNode
+    {
+        // The fat box
+
+        blAABB<blDataType>                              m_aabb;
+
+        // The parent, or
+        // the next free node
+        // while in the free list
+
+        std::size_t                                     m_parent;
+
+        // The children, nullNode
+        // for leaves
+
+        std::size_t                                     m_child1;
+        std::size_t                                     m_child2;
+
+        // The proxy's user data
+
+        std::size_t                                     m_userData;
+
+        // The height of the
+        // node, 0 for leaves and
+        // -1 for free nodes
+
+        int                                             m_height;
+    };
+
+private: // Private variables
+
+    // The margin
+
+    blDataType                                          m_margin;
+
+    // The node pool
+
+    std::vector<blNode>                                 m_nodes;
+    std::size_t                                         m_root;
+    std::size_t                                         m_freeList;
+    std::size_t                                         m_numberOfProxies;
+
+    // The proxies created by
+    // the update function, one
+    // per box
+
+    std::vector<std::size_t>                            m_boxProxies;
+
+    // Stack reused by
+    // the pair finding
+
+    std::vector<blPairType>                             m_pairStack;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+const std::size_t blDynamicAABBTree<blDataType>::nullNode;
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blDynamicAABBTree<blDataType>::blDynamicAABBTree(const blDataType& margin)
+                                                        : m_margin(margin),
+                                                          m_root(nullNode),
+                                                          m_freeList(nullNode),
+                                                          m_numberOfProxies(0)
+{
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::setMargin(const blDataType& margin)
+{
+    m_margin = std::max(margin,blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blDynamicAABBTree<blDataType>::getMargin()const
+{
+    return m_margin;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blDynamicAABBTree<blDataType>::isLeaf(const std::size_t& nodeID)const
+{
+    return m_nodes[nodeID].m_child1 == nullNode;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blDynamicAABBTree<blDataType>::allocateNode()
+{
+    std::size_t nodeID;
+
+    if(m_freeList != nullNode)
+    {
+        nodeID = m_freeList;
+        m_freeList = m_nodes[nodeID].m_parent;
+    }
+    else
+    {
+        nodeID = m_nodes.size();
+        m_nodes.push_back(blNode());
+    }
+
+    m_nodes[nodeID].m_parent = nullNode;
+    m_nodes[nodeID].m_child1 = nullNode;
+    m_nodes[nodeID].m_child2 = nullNode;
+    m_nodes[nodeID].m_userData = 0;
+    m_nodes[nodeID].m_height = 0;
+
+    return nodeID;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::freeNode(const std::size_t& nodeID)
+{
+    m_nodes[nodeID].m_parent = m_freeList;
+    m_nodes[nodeID].m_height = -1;
+
+    m_freeList = nodeID;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blDynamicAABBTree<blDataType>::createProxy(const blAABB<blDataType>& aabb,
+                                                               const std::size_t& userData)
+{
+    std::size_t proxyID = allocateNode();
+
+    m_nodes[proxyID].m_aabb = aabb;
+    m_nodes[proxyID].m_aabb.fatten(m_margin);
+    m_nodes[proxyID].m_userData = userData;
+
+    insertLeaf(proxyID);
+
+    ++m_numberOfProxies;
+
+    return proxyID;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::destroyProxy(const std::size_t& proxyID)
+{
+    removeLeaf(proxyID);
+    freeNode(proxyID);
+
+    --m_numberOfProxies;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blDynamicAABBTree<blDataType>::moveProxy(const std::size_t& proxyID,
+                                                     const blAABB<blDataType>& aabb)
+{
+    // Still inside its
+    // fat box, nothing
+    // to do
+
+    if(m_nodes[proxyID].m_aabb.contains(aabb))
+        return false;
+
+    removeLeaf(proxyID);
+
+    m_nodes[proxyID].m_aabb = aabb;
+    m_nodes[proxyID].m_aabb.fatten(m_margin);
+
+    insertLeaf(proxyID);
+
+    return true;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blAABB<blDataType>& blDynamicAABBTree<blDataType>::getFatAABB(const std::size_t& proxyID)const
+{
+    return m_nodes[proxyID].m_aabb;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::size_t& blDynamicAABBTree<blDataType>::getUserData(const std::size_t& proxyID)const
+{
+    return m_nodes[proxyID].m_userData;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline int blDynamicAABBTree<blDataType>::getHeight()const
+{
+    if(m_root == nullNode)
+        return 0;
+
+    return m_nodes[m_root].m_height;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blDynamicAABBTree<blDataType>::getNumberOfProxies()const
+{
+    return m_numberOfProxies;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::clear()
+{
+    m_nodes.clear();
+    m_boxProxies.clear();
+
+    m_root = nullNode;
+    m_freeList = nullNode;
+    m_numberOfProxies = 0;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::update(const std::vector< blAABB<blDataType> >& boxes)
+{
+    // Drop the proxies
+    // of boxes that are
+    // gone
+
+    while(m_boxProxies.size() > boxes.size())
+    {
+        destroyProxy(m_boxProxies.back());
+        m_boxProxies.pop_back();
+    }
+
+    // Move the proxies
+    // we already have and
+    // create the new ones
+
+    for(std::size_t i = 0; i < m_boxProxies.size(); ++i)
+        moveProxy(m_boxProxies[i],boxes[i]);
+
+    for(std::size_t i = m_boxProxies.size(); i < boxes.size(); ++i)
+        m_boxProxies.push_back(createProxy(boxes[i],i));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::refitNode(const std::size_t& nodeID)
+{
+    blNode& node = m_nodes[nodeID];
+
+    node.m_aabb = m_nodes[node.m_child1].m_aabb;
+    node.m_aabb.merge(m_nodes[node.m_child2].m_aabb);
+
+    node.m_height = 1 + std::max(m_nodes[node.m_child1].m_height,
+                                 m_nodes[node.m_child2].m_height);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::insertLeaf(const std::size_t& leafID)
+{
+    if(m_root == nullNode)
+    {
+        m_root = leafID;
+        m_nodes[leafID].m_parent = nullNode;
+        return;
+    }
+
+    // Step 1:  Walk down to the
+    //          sibling that makes the
+    //          tree grow the least,
+    //          every node we pass has
+    //          to grow to hold the leaf
+
+    const blAABB<blDataType> leafAABB = m_nodes[leafID].m_aabb;
+
+    std::size_t index = m_root;
+
+    while(!isLeaf(index))
+    {
+        const blNode& node = m_nodes[index];
+
+        blAABB<blDataType> combinedAABB = node.m_aabb;
+        combinedAABB.merge(leafAABB);
+
+        blDataType area = node.m_aabb.getSurfaceArea();
+        blDataType combinedArea = combinedAABB.getSurfaceArea();
+
+        // Cost of making the
+        // leaf a sibling of
+        // this node
+
+        blDataType cost = blDataType(2) * combinedArea;
+
+        // Cost inherited by
+        // going further down
+
+        blDataType inheritedCost = blDataType(2) * (combinedArea - area);
+
+        blDataType childCosts[2];
+        std::size_t children[2] = {node.m_child1,node.m_child2};
+
+        for(int i = 0; i < 2; ++i)
+        {
+            blAABB<blDataType> childAABB = m_nodes[children[i]].m_aabb;
+            childAABB.merge(leafAABB);
+
+            if(isLeaf(children[i]))
+                childCosts[i] = childAABB.getSurfaceArea() + inheritedCost;
+            else
+                childCosts[i] = childAABB.getSurfaceArea() - m_nodes[children[i]].m_aabb.getSurfaceArea() + inheritedCost;
+        }
+
+        if(cost < childCosts[0] && cost < childCosts[1])
+            break;
+
+        index = (childCosts[0] < childCosts[1]) ? children[0] : children[1];
+    }
+
+    std::size_t sibling = index;
+
+    // Step 2:  Put a new parent
+    //          above the sibling and
+    //          the leaf
+
+    std::size_t oldParent = m_nodes[sibling].m_parent;
+    std::size_t newParent = allocateNode();
+
+    m_nodes[newParent].m_parent = oldParent;
+    m_nodes[newParent].m_child1 = sibling;
+    m_nodes[newParent].m_child2 = leafID;
+
+    m_nodes[sibling].m_parent = newParent;
+    m_nodes[leafID].m_parent = newParent;
+
+    if(oldParent == nullNode)
+        m_root = newParent;
+    else if(m_nodes[oldParent].m_child1 == sibling)
+        m_nodes[oldParent].m_child1 = newParent;
+    else
+        m_nodes[oldParent].m_child2 = newParent;
+
+    // Step 3:  Refit the
+    //          branches above
+
+    refitUpwards(newParent);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::removeLeaf(const std::size_t& leafID)
+{
+    if(leafID == m_root)
+    {
+        m_root = nullNode;
+        return;
+    }
+
+    // The leaf's sibling
+    // takes its parent's
+    // place
+
+    std::size_t parent = m_nodes[leafID].m_parent;
+    std::size_t grandParent = m_nodes[parent].m_parent;
+    std::size_t sibling = (m_nodes[parent].m_child1 == leafID) ? m_nodes[parent].m_child2 : m_nodes[parent].m_child1;
+
+    m_nodes[sibling].m_parent = grandParent;
+
+    if(grandParent == nullNode)
+    {
+        m_root = sibling;
+    }
+    else
+    {
+        if(m_nodes[grandParent].m_child1 == parent)
+            m_nodes[grandParent].m_child1 = sibling;
+        else
+            m_nodes[grandParent].m_child2 = sibling;
+
+        refitUpwards(grandParent);
+    }
+
+    freeNode(parent);
+
+    m_nodes[leafID].m_parent = nullNode;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::refitUpwards(std::size_t nodeID)
+{
+    while(nodeID != nullNode)
+    {
+        refitNode(nodeID);
+        rotate(nodeID);
+
+        nodeID = m_nodes[nodeID].m_parent;
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::rotate(const std::size_t& nodeID)
+{
+    // A node with children B
+    // and C can swap B with one
+    // of C's children or C with
+    // one of B's children, the
+    // node itself keeps the same
+    // box, but the child that gets
+    // the swapped in node can
+    // shrink, we pick the swap
+    // that shrinks it the most
+
+    if(m_nodes[nodeID].m_height < 2)
+        return;
+
+    std::size_t children[2] = {m_nodes[nodeID].m_child1,m_nodes[nodeID].m_child2};
+
+    blDataType bestReduction = blDataType(0);
+    int bestChild = -1;
+    int bestGrandChild = -1;
+
+    for(int i = 0; i < 2; ++i)
+    {
+        // The child whose
+        // children we look at,
+        // and the child that
+        // would be swapped in
+
+        std::size_t parentOfGrandChildren = children[1 - i];
+        std::size_t swappedChild = children[i];
+
+        if(isLeaf(parentOfGrandChildren))
+            continue;
+
+        const blNode& parentNode = m_nodes[parentOfGrandChildren];
+        blDataType currentArea = parentNode.m_aabb.getSurfaceArea();
+
+        std::size_t grandChildren[2] = {parentNode.m_child1,parentNode.m_child2};
+
+        for(int j = 0; j < 2; ++j)
+        {
+            // Swapping grandchild j
+            // out leaves its sibling
+            // together with the
+            // swapped in child
+
+            blAABB<blDataType> newAABB = m_nodes[swappedChild].m_aabb;
+            newAABB.merge(m_nodes[grandChildren[1 - j]].m_aabb);
+
+            blDataType reduction = currentArea - newAABB.getSurfaceArea();
+
+            if(reduction > bestReduction)
+            {
+                bestReduction = reduction;
+                bestChild = i;
+                bestGrandChild = j;
+            }
+        }
+    }
+
+    if(bestChild < 0)
+        return;
+
+    // Do the swap
+
+    std::size_t swappedChild = children[bestChild];
+    std::size_t parentOfGrandChildren = children[1 - bestChild];
+    std::size_t grandChild = (bestGrandChild == 0) ? m_nodes[parentOfGrandChildren].m_child1 : m_nodes[parentOfGrandChildren].m_child2;
+
+    if(m_nodes[nodeID].m_child1 == swappedChild)
+        m_nodes[nodeID].m_child1 = grandChild;
+    else
+        m_nodes[nodeID].m_child2 = grandChild;
+
+    if(m_nodes[parentOfGrandChildren].m_child1 == grandChild)
+        m_nodes[parentOfGrandChildren].m_child1 = swappedChild;
+    else
+        m_nodes[parentOfGrandChildren].m_child2 = swappedChild;
+
+    m_nodes[grandChild].m_parent = nodeID;
+    m_nodes[swappedChild].m_parent = parentOfGrandChildren;
+
+    refitNode(parentOfGrandChildren);
+    refitNode(nodeID);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::query(const blAABB<blDataType>& aabb,
+                                                 std::vector<std::size_t>& proxyIDs)const
+{
+    proxyIDs.clear();
+
+    if(m_root == nullNode)
+        return;
+
+    std::vector<std::size_t> stack;
+    stack.push_back(m_root);
+
+    while(!stack.empty())
+    {
+        std::size_t nodeID = stack.back();
+        stack.pop_back();
+
+        const blNode& node = m_nodes[nodeID];
+
+        if(!node.m_aabb.overlaps(aabb))
+            continue;
+
+        if(isLeaf(nodeID))
+        {
+            proxyIDs.push_back(nodeID);
+        }
+        else
+        {
+            stack.push_back(node.m_child1);
+            stack.push_back(node.m_child2);
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::rayCast(const blVectorType& origin,
+                                                   const blVectorType& direction,
+                                                   const blDataType& maxDistance,
+                                                   std::vector<std::size_t>& proxyIDs)const
+{
+    proxyIDs.clear();
+
+    if(m_root == nullNode)
+        return;
+
+    const blDataType originValues[3] = {origin.x(),origin.y(),origin.z()};
+    const blDataType directionValues[3] = {direction.x(),direction.y(),direction.z()};
+
+    std::vector<std::size_t> stack;
+    stack.push_back(m_root);
+
+    while(!stack.empty())
+    {
+        std::size_t nodeID = stack.back();
+        stack.pop_back();
+
+        const blNode& node = m_nodes[nodeID];
+
+        // Clip the segment
+        // against the box's
+        // slabs
+
+        const blDataType lowerBounds[3] = {node.m_aabb.getLowerBound().x(),node.m_aabb.getLowerBound().y(),node.m_aabb.getLowerBound().z()};
+        const blDataType upperBounds[3] = {node.m_aabb.getUpperBound().x(),node.m_aabb.getUpperBound().y(),node.m_aabb.getUpperBound().z()};
+
+        blDataType tMin = blDataType(0);
+        blDataType tMax = maxDistance;
+
+        bool isHit = true;
+
+        for(int axis = 0; axis < 3 && isHit; ++axis)
+        {
+            if(directionValues[axis] == blDataType(0))
+            {
+                if(originValues[axis] < lowerBounds[axis] || originValues[axis] > upperBounds[axis])
+                    isHit = false;
+
+                continue;
+            }
+
+            blDataType inverseDirection = blDataType(1) / directionValues[axis];
+            blDataType t1 = (lowerBounds[axis] - originValues[axis]) * inverseDirection;
+            blDataType t2 = (upperBounds[axis] - originValues[axis]) * inverseDirection;
+
+            if(t1 > t2)
+                std::swap(t1,t2);
+
+            tMin = std::max(tMin,t1);
+            tMax = std::min(tMax,t2);
+
+            if(tMin > tMax)
+                isHit = false;
+        }
+
+        if(!isHit)
+            continue;
+
+        if(isLeaf(nodeID))
+        {
+            proxyIDs.push_back(nodeID);
+        }
+        else
+        {
+            stack.push_back(node.m_child1);
+            stack.push_back(node.m_child2);
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blDynamicAABBTree<blDataType>::findPairs(std::vector<blPairType>& pairs)
+{
+    pairs.clear();
+
+    if(m_root == nullNode)
+        return;
+
+    // We walk the tree against
+    // itself, a pair of nodes
+    // is only opened up when
+    // their boxes overlap
+
+    m_pairStack.clear();
+    m_pairStack.push_back(blPairType(m_root,m_root));
+
+    while(!m_pairStack.empty())
+    {
+        std::size_t nodeID1 = m_pairStack.back().first;
+        std::size_t nodeID2 = m_pairStack.back().second;
+        m_pairStack.pop_back();
+
+        const blNode& node1 = m_nodes[nodeID1];
+        const blNode& node2 = m_nodes[nodeID2];
+
+        if(nodeID1 == nodeID2)
+        {
+            // Pairs within one
+            // branch, either within
+            // each child or across
+            // the two children
+
+            if(isLeaf(nodeID1))
+                continue;
+
+            m_pairStack.push_back(blPairType(node1.m_child1,node1.m_child1));
+            m_pairStack.push_back(blPairType(node1.m_child2,node1.m_child2));
+            m_pairStack.push_back(blPairType(node1.m_child1,node1.m_child2));
+
+            continue;
+        }
+
+        if(!node1.m_aabb.overlaps(node2.m_aabb))
+            continue;
+
+        bool isLeaf1 = isLeaf(nodeID1);
+        bool isLeaf2 = isLeaf(nodeID2);
+
+        if(isLeaf1 && isLeaf2)
+        {
+            pairs.push_back(blPairType(std::min(node1.m_userData,node2.m_userData),
+                                       std::max(node1.m_userData,node2.m_userData)));
+        }
+        else if(isLeaf1 || (!isLeaf2 && node2.m_aabb.getSurfaceArea() > node1.m_aabb.getSurfaceArea()))
+        {
+            // Open up the
+            // bigger node
+
+            m_pairStack.push_back(blPairType(nodeID1,node2.m_child1));
+            m_pairStack.push_back(blPairType(nodeID1,node2.m_child2));
+        }
+        else
+        {
+            m_pairStack.push_back(blPairType(node1.m_child1,nodeID2));
+            m_pairStack.push_back(blPairType(node1.m_child2,nodeID2));
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_DYNAMICAABBTREE_HPP
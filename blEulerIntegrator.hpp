@@ -0,0 +1,117 @@
+#ifndef BL_EULERINTEGRATOR_HPP
+#define BL_EULERINTEGRATOR_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blEulerIntegrator.hpp
+// CLASS:           blEulerIntegrator
+// BASE CLASS:      blIntegratorPolicy
+//
+// PURPOSE:         Based on blIntegratorPolicy, it integrates a rigid
+//                  body's state using the explicit Euler method
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blIntegratorPolicy
+//
+// NOTES:           - Also used by blRigidBody for BL_EULER
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+class blEulerIntegrator : public blIntegratorPolicy<blEulerIntegrator>
+{
+public: // Public functions
+
+    // Function used to
+    // calculate the new
+    // state of a rigid
+    // body
+
+    template<typename blDataType>
+    static void                                         integrateState(blRigidBody<blDataType>& rigidBody,
+                                                                       const sf::Time& timeStep,
+                                                                       const blMathAPI::blVector3d<blDataType>& accelerationField);
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blEulerIntegrator::integrateState(blRigidBody<blDataType>& rigidBody,
+                                              const sf::Time& timeStep,
+                                              const blMathAPI::blVector3d<blDataType>& accelerationField)
+{
+    blDataType dt = blDataType(timeStep.asSeconds());
+
+    // Step 1:  Integrate the
+    //          position
+
+    blMathAPI::blVector3d<blDataType> positionStep = rigidBody.getVelocity() * dt;
+
+    rigidBody.blPosition<blDataType>::translate(positionStep.x(),
+                                                positionStep.y(),
+                                                positionStep.z());
+
+    // Step 2:  Integrate the
+    //          velocity
+
+    rigidBody.changeVelocity((rigidBody.getTotalForce()/rigidBody.getMass() + accelerationField) * dt);
+
+    // Step 3:  Find the angular
+    //          acceleration before
+    //          rotating, the inertia
+    //          is taken in system
+    //          coordinates like the
+    //          angular velocity and
+    //          the torque
+
+    blMathAPI::blVector3d<blDataType> angularAcceleration = rigidBody.applyWorldInertiaInverse(rigidBody.getTotalTorque() -
+                                                                                                crossProduct(rigidBody.getAngularVelocity(),rigidBody.applyWorldInertia(rigidBody.getAngularVelocity())));
+
+    // Step 4:  Integrate the
+    //          angular position,
+    //          rotating by |w|*dt
+    //          about w
+
+    blDataType angularSpeed = blMathAPI::norm2(rigidBody.getAngularVelocity());
+
+    if(angularSpeed > 0)
+    {
+        blDataType theta = angularSpeed * dt;
+
+        blMathAPI::blQuaternion<blDataType> angVelQtn(std::cos(theta/blDataType(2)),
+                                                      rigidBody.getAngularVelocity() * (std::sin(theta/blDataType(2)) / angularSpeed));
+
+        rigidBody.blOrientation<blDataType>::rotate(angVelQtn);
+    }
+
+    // Step 5:  Integrate the
+    //          angular velocity
+
+    rigidBody.changeAngularVelocity(angularAcceleration * dt);
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_EULERINTEGRATOR_HPP
@@ -0,0 +1,95 @@
+#ifndef BL_EXECUTOR_HPP
+#define BL_EXECUTOR_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blExecutor.hpp
+// CLASS:           blExecutor
+// BASE CLASS:      None
+//
+// PURPOSE:         A base class for pluggable executors used to
+//                  run loops over ranges of items, the default
+//                  implementation runs the whole range serially on
+//                  the calling thread
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - std::function
+//
+// NOTES:           - Derived executors (for ex. blThreadPool) split
+//                    the range [0,numberOfItems) in contiguous chunks
+//                    and hand each chunk to a worker as [begin,end)
+//                  - The task must be safe to run concurrently on
+//                    disjoint ranges
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+class blExecutor
+{
+public: // Public typedefs
+
+    typedef std::function<void(const std::size_t&,const std::size_t&)>   blRangeTaskType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blExecutor()
+    {
+    }
+
+    // Destructor
+
+    virtual ~blExecutor()
+    {
+    }
+
+public: // Public functions
+
+    // Function used to
+    // run a task over the
+    // range [0,numberOfItems)
+
+    virtual void                                        parallelFor(const std::size_t& numberOfItems,
+                                                                    const blRangeTaskType& task)
+    {
+        if(numberOfItems > 0)
+            task(0,numberOfItems);
+    }
+
+    // Function used to
+    // get the number of
+    // threads that can
+    // run tasks at the
+    // same time
+
+    virtual std::size_t                                 getNumberOfThreads()const
+    {
+        return 1;
+    }
+};
+//-------------------------------------------------------------------
+
+
+#endif // BL_EXECUTOR_HPP
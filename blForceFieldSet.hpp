@@ -0,0 +1,869 @@
+#ifndef BL_FORCEFIELDSET_HPP
+#define BL_FORCEFIELDSET_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blForceFieldSet.hpp
+// CLASS:           blForceFieldSet
+// BASE CLASS:      None
+//
+// PURPOSE:         A set of spatially varying acceleration fields
+//                  (uniform fields, radial point attractors, gridded
+//                  vector fields and procedural wind) acting on the
+//                  bodies of a blRigidBodyWorld, all evaluated in one
+//                  batched pass over the body positions instead of
+//                  one addForce call per body per field
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blRigidBodyWorld -- The bodies the fields act on
+//                  - blSimdPack, blScalarPack, blVector3dArray
+//                  - blExecutor -- Used to split the pass
+//                    between threads
+//
+// NOTES:           - Every field gives an acceleration, the pass adds
+//                    up the accelerations of all the fields at each
+//                    body and adds mass*acceleration to the body's
+//                    force, bodies without mass get no force
+//                  - A point attractor pulls with
+//                    strength*d/(|d|^2 + s^2)^(3/2), d being the vector
+//                    from the body to the attractor and s its softening
+//                    radius, a negative strength pushes bodies away
+//                  - A grid field holds one acceleration per grid node,
+//                    x index fastest, and is sampled with trilinear
+//                    interpolation, positions outside the grid take
+//                    the value at the nearest border
+//                  - The wind field scales its acceleration by
+//                    1 + turbulence*n, with n in [-1,1] a sum of three
+//                    plane waves of a smooth periodic bump travelling
+//                    in fixed directions, so gusts move through space
+//                    and time without tables or trig functions
+//                  - Uniform, attractor and wind fields are evaluated
+//                    with SIMD registers, grid fields need a lookup per
+//                    body and are sampled one body at a time in the
+//                    same pass
+//                  - The pass only writes the range's own bodies, so
+//                    the results are the same for any number of threads
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blForceFieldSet
+{
+public: // Public typedefs
+
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+
+    typedef blSimdPack<blDataType>                      blPackType;
+    typedef blScalarPack<blDataType>                    blTailPackType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blForceFieldSet();
+
+    // Destructor
+
+    ~blForceFieldSet()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // add fields, each one
+    // returns the field's
+    // index among the fields
+    // of its kind
+
+    std::size_t                                         addUniformField(const blVectorType& acceleration);
+
+    std::size_t                                         addAttractor(const blVectorType& center,
+                                                                     const blDataType& strength,
+                                                                     const blDataType& softeningRadius = 0);
+
+    std::size_t                                         addGridField(const blVectorType& origin,
+                                                                     const blVectorType& cellSize,
+                                                                     const std::size_t& numberOfNodesX,
+                                                                     const std::size_t& numberOfNodesY,
+                                                                     const std::size_t& numberOfNodesZ,
+                                                                     const std::vector<blVectorType>& accelerations);
+
+    std::size_t                                         addWindField(const blVectorType& acceleration,
+                                                                     const blDataType& turbulence,
+                                                                     const blDataType& frequency,
+                                                                     const blDataType& speed);
+
+    // Function used to
+    // remove all the fields
+
+    void                                                clear();
+
+    // Functions used to
+    // get the number of
+    // fields of each kind
+
+    std::size_t                                         getNumberOfUniformFields()const;
+    std::size_t                                         getNumberOfAttractors()const;
+    std::size_t                                         getNumberOfGridFields()const;
+    std::size_t                                         getNumberOfWindFields()const;
+
+    // Functions used to
+    // change fields that
+    // move or vary over
+    // time
+
+    void                                                setUniformField(const std::size_t& fieldIndex,
+                                                                        const blVectorType& acceleration);
+
+    void                                                setAttractorCenter(const std::size_t& attractorIndex,
+                                                                           const blVectorType& center);
+    void                                                setAttractorStrength(const std::size_t& attractorIndex,
+                                                                             const blDataType& strength);
+
+    void                                                setGridValue(const std::size_t& gridIndex,
+                                                                     const std::size_t& nodeX,
+                                                                     const std::size_t& nodeY,
+                                                                     const std::size_t& nodeZ,
+                                                                     const blVectorType& acceleration);
+
+    void                                                setWindField(const std::size_t& windIndex,
+                                                                     const blVectorType& acceleration,
+                                                                     const blDataType& turbulence);
+
+    // Functions used to
+    // set/get the executor
+    // used to split the
+    // pass between threads
+
+    void                                                setExecutor(const std::shared_ptr<blExecutor>& executor);
+    const std::shared_ptr<blExecutor>&                  getExecutor()const;
+
+    // Function used to
+    // calculate the field
+    // accelerations at
+    // a set of positions
+
+    void                                                calculateAccelerations(const blVector3dArray<blDataType>& positions,
+                                                                               const sf::Time& totalTime);
+
+    // Function used to
+    // calculate the field
+    // accelerations at all
+    // the bodies and add
+    // mass*acceleration to
+    // their forces
+
+    void                                                calculateAndApplyForces(blRigidBodyWorld<blDataType>& world,
+                                                                                const sf::Time& totalTime);
+
+    // Function used to get
+    // the accelerations of
+    // the last pass
+
+    const blVector3dArray<blDataType>&                  getAccelerations()const;
+
+protected: // Protected types
+
+    // A grid of
+    // accelerations
+
+    struct blGridField
+    {
+        blVectorType                                    m_origin;
+        blVectorType                                    m_inverseCellSize;
+        std::size_t                                     m_numberOfNodes[3];
+        blVector3dArray<blDataType>                     m_accelerations;
+    };
+
+    // A wind field
+
+    struct blWindField
+    {
+        blVectorType                                    m_acceleration;
+        blDataType                                      m_turbulence;
+        blDataType                                      m_frequency;
+        blDataType                                      m_speed;
+    };
+
+protected: // Protected functions
+
+    // The steps of a
+    // pass over the bodies
+    // [beginIndex,endIndex)
+
+    void                                                sampleGridFields(const blVector3dArray<blDataType>& positions,
+                                                                         const std::size_t& beginIndex,
+                                                                         const std::size_t& endIndex);
+
+    void                                                evaluateFields(const blVector3dArray<blDataType>& positions,
+                                                                       const blDataType& time,
+                                                                       const std::size_t& beginIndex,
+                                                                       const std::size_t& endIndex);
+
+    void                                                applyForces(blRigidBodyWorld<blDataType>& world,
+                                                                    const std::size_t& beginIndex,
+                                                                    const std::size_t& endIndex)const;
+
+    // The kernels written
+    // once for any pack
+    // type, processing the
+    // bodies starting at
+    // index i
+
+    template<typename blPack>
+    void                                                fieldsKernel(const blDataType* px,const blDataType* py,const blDataType* pz,
+                                                                     const blDataType& time,
+                                                                     const std::size_t& i);
+
+    template<typename blPack>
+    void                                                forcesKernel(blDataType* fx,blDataType* fy,blDataType* fz,
+                                                                     const blDataType* masses,
+                                                                     const std::size_t& i)const;
+
+    // Function used to
+    // evaluate the wind
+    // noise, in [-1,1]
+
+    template<typename blPack>
+    static typename blPack::blRegisterType              windNoise(const typename blPack::blRegisterType& x,
+                                                                  const typename blPack::blRegisterType& y,
+                                                                  const typename blPack::blRegisterType& z,
+                                                                  const blDataType& frequency,
+                                                                  const blDataType& phase);
+
+    bool                                                isParallel()const;
+
+private: // Private variables
+
+    // The uniform fields
+    // and their sum
+
+    std::vector<blVectorType>                           m_uniformFields;
+    blVectorType                                        m_uniformAcceleration;
+
+    // The point attractors,
+    // the softening radii are
+    // kept squared
+
+    blVector3dArray<blDataType>                         m_attractorCenters;
+    std::vector<blDataType>                             m_attractorStrengths;
+    std::vector<blDataType>                             m_attractorSoftenings;
+
+    // The grid and
+    // wind fields
+
+    std::vector<blGridField>                            m_gridFields;
+    std::vector<blWindField>                            m_windFields;
+
+    // The accelerations
+    // of the last pass
+
+    blVector3dArray<blDataType>                         m_accelerations;
+
+    // The executor
+
+    std::shared_ptr<blExecutor>                         m_executor;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blForceFieldSet<blDataType>::blForceFieldSet()
+{
+    m_uniformAcceleration = blVectorType(0,0,0);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blForceFieldSet<blDataType>::addUniformField(const blVectorType& acceleration)
+{
+    m_uniformFields.push_back(acceleration);
+    m_uniformAcceleration += acceleration;
+
+    return m_uniformFields.size() - 1;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blForceFieldSet<blDataType>::addAttractor(const blVectorType& center,
+                                                             const blDataType& strength,
+                                                             const blDataType& softeningRadius)
+{
+    m_attractorCenters.push_back(center);
+    m_attractorStrengths.push_back(strength);
+    m_attractorSoftenings.push_back(softeningRadius * softeningRadius);
+
+    return m_attractorStrengths.size() - 1;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blForceFieldSet<blDataType>::addGridField(const blVectorType& origin,
+                                                             const blVectorType& cellSize,
+                                                             const std::size_t& numberOfNodesX,
+                                                             const std::size_t& numberOfNodesY,
+                                                             const std::size_t& numberOfNodesZ,
+                                                             const std::vector<blVectorType>& accelerations)
+{
+    blGridField gridField;
+
+    gridField.m_origin = origin;
+    gridField.m_inverseCellSize = blVectorType(cellSize.x() > 0 ? blDataType(1)/cellSize.x() : blDataType(0),
+                                               cellSize.y() > 0 ? blDataType(1)/cellSize.y() : blDataType(0),
+                                               cellSize.z() > 0 ? blDataType(1)/cellSize.z() : blDataType(0));
+
+    gridField.m_numberOfNodes[0] = std::max(numberOfNodesX,std::size_t(1));
+    gridField.m_numberOfNodes[1] = std::max(numberOfNodesY,std::size_t(1));
+    gridField.m_numberOfNodes[2] = std::max(numberOfNodesZ,std::size_t(1));
+
+    // Missing nodes
+    // are left at zero
+
+    std::size_t numberOfNodes = gridField.m_numberOfNodes[0] * gridField.m_numberOfNodes[1] * gridField.m_numberOfNodes[2];
+
+    gridField.m_accelerations.resize(numberOfNodes);
+
+    for(std::size_t i = 0; i < numberOfNodes && i < accelerations.size(); ++i)
+        gridField.m_accelerations.setVector(i,accelerations[i]);
+
+    m_gridFields.push_back(gridField);
+
+    return m_gridFields.size() - 1;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blForceFieldSet<blDataType>::addWindField(const blVectorType& acceleration,
+                                                             const blDataType& turbulence,
+                                                             const blDataType& frequency,
+                                                             const blDataType& speed)
+{
+    blWindField windField;
+
+    windField.m_acceleration = acceleration;
+    windField.m_turbulence = turbulence;
+    windField.m_frequency = frequency;
+    windField.m_speed = speed;
+
+    m_windFields.push_back(windField);
+
+    return m_windFields.size() - 1;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::clear()
+{
+    m_uniformFields.clear();
+    m_uniformAcceleration = blVectorType(0,0,0);
+
+    m_attractorCenters.clear();
+    m_attractorStrengths.clear();
+    m_attractorSoftenings.clear();
+
+    m_gridFields.clear();
+    m_windFields.clear();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blForceFieldSet<blDataType>::getNumberOfUniformFields()const
+{
+    return m_uniformFields.size();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blForceFieldSet<blDataType>::getNumberOfAttractors()const
+{
+    return m_attractorStrengths.size();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blForceFieldSet<blDataType>::getNumberOfGridFields()const
+{
+    return m_gridFields.size();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blForceFieldSet<blDataType>::getNumberOfWindFields()const
+{
+    return m_windFields.size();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::setUniformField(const std::size_t& fieldIndex,
+                                                         const blVectorType& acceleration)
+{
+    m_uniformFields[fieldIndex] = acceleration;
+
+    // Add the sum up
+    // again instead of
+    // correcting it, so
+    // no error builds up
+
+    m_uniformAcceleration = blVectorType(0,0,0);
+
+    for(std::size_t i = 0; i < m_uniformFields.size(); ++i)
+        m_uniformAcceleration += m_uniformFields[i];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::setAttractorCenter(const std::size_t& attractorIndex,
+                                                            const blVectorType& center)
+{
+    m_attractorCenters.setVector(attractorIndex,center);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::setAttractorStrength(const std::size_t& attractorIndex,
+                                                              const blDataType& strength)
+{
+    m_attractorStrengths[attractorIndex] = strength;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::setGridValue(const std::size_t& gridIndex,
+                                                      const std::size_t& nodeX,
+                                                      const std::size_t& nodeY,
+                                                      const std::size_t& nodeZ,
+                                                      const blVectorType& acceleration)
+{
+    blGridField& gridField = m_gridFields[gridIndex];
+
+    gridField.m_accelerations.setVector(nodeX + gridField.m_numberOfNodes[0] * (nodeY + gridField.m_numberOfNodes[1] * nodeZ),
+                                        acceleration);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::setWindField(const std::size_t& windIndex,
+                                                      const blVectorType& acceleration,
+                                                      const blDataType& turbulence)
+{
+    m_windFields[windIndex].m_acceleration = acceleration;
+    m_windFields[windIndex].m_turbulence = turbulence;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::setExecutor(const std::shared_ptr<blExecutor>& executor)
+{
+    m_executor = executor;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::shared_ptr<blExecutor>& blForceFieldSet<blDataType>::getExecutor()const
+{
+    return m_executor;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blVector3dArray<blDataType>& blForceFieldSet<blDataType>::getAccelerations()const
+{
+    return m_accelerations;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blForceFieldSet<blDataType>::isParallel()const
+{
+    return m_executor && m_executor->getNumberOfThreads() > 1;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::calculateAccelerations(const blVector3dArray<blDataType>& positions,
+                                                                const sf::Time& totalTime)
+{
+    std::size_t numberOfBodies = positions.size();
+    blDataType time = totalTime.asSeconds();
+
+    m_accelerations.resize(numberOfBodies);
+
+    if(isParallel())
+    {
+        m_executor->parallelFor(numberOfBodies,
+                                [this,&positions,time](const std::size_t& beginIndex,const std::size_t& endIndex)
+                                {
+                                    evaluateFields(positions,time,beginIndex,endIndex);
+                                });
+    }
+    else
+    {
+        evaluateFields(positions,time,0,numberOfBodies);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::calculateAndApplyForces(blRigidBodyWorld<blDataType>& world,
+                                                                 const sf::Time& totalTime)
+{
+    std::size_t numberOfBodies = world.getNumberOfBodies();
+    blDataType time = totalTime.asSeconds();
+
+    m_accelerations.resize(numberOfBodies);
+
+    // Each range evaluates
+    // the fields at its own
+    // bodies and adds their
+    // forces right away,
+    // while the positions
+    // are still in the cache
+
+    if(isParallel())
+    {
+        m_executor->parallelFor(numberOfBodies,
+                                [this,&world,time](const std::size_t& beginIndex,const std::size_t& endIndex)
+                                {
+                                    evaluateFields(world.getPositions(),time,beginIndex,endIndex);
+                                    applyForces(world,beginIndex,endIndex);
+                                });
+    }
+    else
+    {
+        evaluateFields(world.getPositions(),time,0,numberOfBodies);
+        applyForces(world,0,numberOfBodies);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::sampleGridFields(const blVector3dArray<blDataType>& positions,
+                                                          const std::size_t& beginIndex,
+                                                          const std::size_t& endIndex)
+{
+    for(std::size_t i = beginIndex; i < endIndex; ++i)
+    {
+        blVectorType acceleration(0,0,0);
+        blVectorType position = positions.getVector(i);
+
+        for(std::size_t k = 0; k < m_gridFields.size(); ++k)
+        {
+            const blGridField& gridField = m_gridFields[k];
+
+            // Step 1:  Find the cell
+            //          and where in it
+            //          the body is, along
+            //          each axis
+
+            blVectorType gridPosition = position - gridField.m_origin;
+
+            blDataType coords[3] = {gridPosition.x() * gridField.m_inverseCellSize.x(),
+                                    gridPosition.y() * gridField.m_inverseCellSize.y(),
+                                    gridPosition.z() * gridField.m_inverseCellSize.z()};
+
+            std::size_t nodes[3][2];
+            blDataType weights[3];
+
+            for(int axis = 0; axis < 3; ++axis)
+            {
+                blDataType lastNode = blDataType(gridField.m_numberOfNodes[axis] - 1);
+                blDataType coord = std::min(std::max(coords[axis],blDataType(0)),lastNode);
+                blDataType node = std::min(std::floor(coord),std::max(lastNode - 1,blDataType(0)));
+
+                nodes[axis][0] = std::size_t(node);
+                nodes[axis][1] = std::min(nodes[axis][0] + 1,gridField.m_numberOfNodes[axis] - 1);
+                weights[axis] = coord - node;
+            }
+
+            // Step 2:  Blend the eight
+            //          corner values
+
+            for(int corner = 0; corner < 8; ++corner)
+            {
+                int cx = corner & 1;
+                int cy = (corner >> 1) & 1;
+                int cz = (corner >> 2) & 1;
+
+                blDataType weight = (cx ? weights[0] : blDataType(1) - weights[0]) *
+                                    (cy ? weights[1] : blDataType(1) - weights[1]) *
+                                    (cz ? weights[2] : blDataType(1) - weights[2]);
+
+                std::size_t node = nodes[0][cx] + gridField.m_numberOfNodes[0] * (nodes[1][cy] + gridField.m_numberOfNodes[1] * nodes[2][cz]);
+
+                acceleration += weight * gridField.m_accelerations.getVector(node);
+            }
+        }
+
+        m_accelerations.setVector(i,acceleration);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::evaluateFields(const blVector3dArray<blDataType>& positions,
+                                                        const blDataType& time,
+                                                        const std::size_t& beginIndex,
+                                                        const std::size_t& endIndex)
+{
+    // The grid fields start
+    // the accelerations off,
+    // the kernels add the
+    // other fields to them
+
+    sampleGridFields(positions,beginIndex,endIndex);
+
+    const blDataType* px = positions.x().data();
+    const blDataType* py = positions.y().data();
+    const blDataType* pz = positions.z().data();
+
+    std::size_t i = beginIndex;
+
+    for(; i + blPackType::width <= endIndex; i += blPackType::width)
+        fieldsKernel<blPackType>(px,py,pz,time,i);
+
+    for(; i < endIndex; ++i)
+        fieldsKernel<blTailPackType>(px,py,pz,time,i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blForceFieldSet<blDataType>::applyForces(blRigidBodyWorld<blDataType>& world,
+                                                     const std::size_t& beginIndex,
+                                                     const std::size_t& endIndex)const
+{
+    blDataType* fx = world.getTotalForces().x().data();
+    blDataType* fy = world.getTotalForces().y().data();
+    blDataType* fz = world.getTotalForces().z().data();
+
+    const blDataType* masses = world.getMasses().data();
+
+    std::size_t i = beginIndex;
+
+    for(; i + blPackType::width <= endIndex; i += blPackType::width)
+        forcesKernel<blPackType>(fx,fy,fz,masses,i);
+
+    for(; i < endIndex; ++i)
+        forcesKernel<blTailPackType>(fx,fy,fz,masses,i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline typename blPack::blRegisterType blForceFieldSet<blDataType>::windNoise(const typename blPack::blRegisterType& x,
+                                                                              const typename blPack::blRegisterType& y,
+                                                                              const typename blPack::blRegisterType& z,
+                                                                              const blDataType& frequency,
+                                                                              const blDataType& phase)
+{
+    typedef typename blPack::blRegisterType R;
+
+    // Three plane waves, each
+    // one along a fixed unit
+    // direction, at a higher
+    // frequency and with a
+    // smaller weight
+
+    static const blDataType directions[3][3] = {{blDataType(0.80),blDataType(0.36),blDataType(0.48)},
+                                                {blDataType(-0.28),blDataType(0.96),blDataType(0.0)},
+                                                {blDataType(0.36),blDataType(-0.48),blDataType(0.80)}};
+
+    static const blDataType scales[3] = {blDataType(1.0),blDataType(2.03),blDataType(4.11)};
+    static const blDataType offsets[3] = {blDataType(0.0),blDataType(0.37),blDataType(0.71)};
+    static const blDataType weights[3] = {blDataType(0.5),blDataType(0.3),blDataType(0.2)};
+
+    R one = blPack::set1(1);
+    R noise = blPack::set1(0);
+
+    for(int k = 0; k < 3; ++k)
+    {
+        blDataType f = frequency * scales[k];
+
+        R u = blPack::mulAdd(x,blPack::set1(f * directions[k][0]),
+              blPack::mulAdd(y,blPack::set1(f * directions[k][1]),
+              blPack::mulAdd(z,blPack::set1(f * directions[k][2]),
+                             blPack::set1(phase * scales[k] + offsets[k]))));
+
+        // The bump 16*t^2*(1 - t)^2
+        // over the fraction t of
+        // u, smooth across whole
+        // numbers and within [0,1]
+
+        R t = blPack::sub(u,blPack::floor(u));
+        R bump = blPack::mul(t,blPack::sub(one,t));
+
+        noise = blPack::mulAdd(blPack::mul(bump,bump),blPack::set1(16 * weights[k]),noise);
+    }
+
+    // From [0,1] to [-1,1]
+
+    return blPack::sub(blPack::add(noise,noise),one);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline void blForceFieldSet<blDataType>::fieldsKernel(const blDataType* px,const blDataType* py,const blDataType* pz,
+                                                      const blDataType& time,
+                                                      const std::size_t& i)
+{
+    typedef typename blPack::blRegisterType R;
+
+    R Px = blPack::load(px + i);
+    R Py = blPack::load(py + i);
+    R Pz = blPack::load(pz + i);
+
+    // Start from the grid
+    // fields and the uniform
+    // fields
+
+    R ax = blPack::add(blPack::load(m_accelerations.x().data() + i),blPack::set1(m_uniformAcceleration.x()));
+    R ay = blPack::add(blPack::load(m_accelerations.y().data() + i),blPack::set1(m_uniformAcceleration.y()));
+    R az = blPack::add(blPack::load(m_accelerations.z().data() + i),blPack::set1(m_uniformAcceleration.z()));
+
+    // Point attractors
+    // a += k*d/(|d|^2 + s^2)^(3/2)
+
+    for(std::size_t j = 0; j < m_attractorStrengths.size(); ++j)
+    {
+        R dx = blPack::sub(blPack::set1(m_attractorCenters.x()[j]),Px);
+        R dy = blPack::sub(blPack::set1(m_attractorCenters.y()[j]),Py);
+        R dz = blPack::sub(blPack::set1(m_attractorCenters.z()[j]),Pz);
+
+        R r2 = blPack::mulAdd(dx,dx,blPack::mulAdd(dy,dy,blPack::mulAdd(dz,dz,blPack::set1(m_attractorSoftenings[j]))));
+
+        // Bodies sitting on an
+        // attractor without
+        // softening get no pull
+
+        r2 = blPack::max(r2,blPack::set1(std::numeric_limits<blDataType>::min()));
+
+        R scale = blPack::div(blPack::set1(m_attractorStrengths[j]),blPack::mul(r2,blPack::sqrt(r2)));
+
+        ax = blPack::mulAdd(dx,scale,ax);
+        ay = blPack::mulAdd(dy,scale,ay);
+        az = blPack::mulAdd(dz,scale,az);
+    }
+
+    // Wind fields
+    // a += A*(1 + turbulence*n)
+
+    for(std::size_t j = 0; j < m_windFields.size(); ++j)
+    {
+        const blWindField& windField = m_windFields[j];
+
+        R noise = windNoise<blPack>(Px,Py,Pz,windField.m_frequency,windField.m_speed * time);
+
+        R gust = blPack::mulAdd(noise,blPack::set1(windField.m_turbulence),blPack::set1(1));
+
+        ax = blPack::mulAdd(gust,blPack::set1(windField.m_acceleration.x()),ax);
+        ay = blPack::mulAdd(gust,blPack::set1(windField.m_acceleration.y()),ay);
+        az = blPack::mulAdd(gust,blPack::set1(windField.m_acceleration.z()),az);
+    }
+
+    blPack::store(m_accelerations.x().data() + i,ax);
+    blPack::store(m_accelerations.y().data() + i,ay);
+    blPack::store(m_accelerations.z().data() + i,az);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blPack>
+inline void blForceFieldSet<blDataType>::forcesKernel(blDataType* fx,blDataType* fy,blDataType* fz,
+                                                      const blDataType* masses,
+                                                      const std::size_t& i)const
+{
+    typedef typename blPack::blRegisterType R;
+
+    // The world keeps the
+    // masses, zero for bodies
+    // without mass, so the
+    // accelerations turn into
+    // forces without a division
+
+    R mass = blPack::load(masses + i);
+
+    blPack::store(fx + i,blPack::mulAdd(blPack::load(m_accelerations.x().data() + i),mass,blPack::load(fx + i)));
+    blPack::store(fy + i,blPack::mulAdd(blPack::load(m_accelerations.y().data() + i),mass,blPack::load(fy + i)));
+    blPack::store(fz + i,blPack::mulAdd(blPack::load(m_accelerations.z().data() + i),mass,blPack::load(fz + i)));
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_FORCEFIELDSET_HPP
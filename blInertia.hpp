@@ -20,7 +20,25 @@
 // DEPENDENCIES:    blMathAPI::blMatrix3d -- From the blMathAPI used to
 //                                           represent rotational inertia
 //
-// NOTES:
+// NOTES:           - The inverse inertia tensor in system coordinates,
+//                    R*I^-1*R^T, is cached by updateWorldInertia as
+//                    its three columns and tagged with the orientation
+//                    version it was calculated for, so it's only
+//                    calculated again when the object rotates or its
+//                    inertia changes, the inertia itself is applied
+//                    straight through the axes since it's only needed
+//                    once per step
+//                  - When the inertia tensor is diagonal (the body
+//                    axes are its principal axes, as for boxes) only
+//                    its three principal moments and their reciprocals
+//                    are kept, the products with it and its inverse
+//                    are three multiplies and getInertia() and
+//                    getInertiaInverse() build the matrices when asked,
+//                    other tensors keep the full matrices
+//                  - A tensor counts as diagonal when its off-diagonal
+//                    terms are within a few epsilons of its largest
+//                    diagonal term, so round-off from building it
+//                    doesn't push it onto the full matrices path
 // DATE CREATED:    Nov/08/2010
 // DATE UPDATED:
 //-------------------------------------------------------------------
@@ -45,6 +63,7 @@ class blInertia
 protected: // Protected typedefs
 
     typedef blMathAPI::blMatrix3d<blDataType>       blMatrixType;
+    typedef blMathAPI::blVector3d<blDataType>       blVectorType;
 
 public: // Constructors and destructors
 
@@ -57,6 +76,16 @@ public: // Constructors and destructors
 
     blInertia(const blInertia<blDataType>& inertia);
 
+    // Move constructor
+
+    blInertia(blInertia<blDataType>&& inertia) = default;
+
+    // Copy and move
+    // assignments
+
+    blInertia<blDataType>&                          operator=(const blInertia<blDataType>& inertia);
+    blInertia<blDataType>&                          operator=(blInertia<blDataType>&& inertia) = default;
+
     // Destructor
 
     ~blInertia()
@@ -70,20 +99,110 @@ public: // Public function
     // the inertia tensor
 
     const blDataType&                               getMass()const;
-    const blMatrixType&                             getInertia()const;
-    const blMatrixType&                             getInertiaInverse()const;
+    blMatrixType                                    getInertia()const;
+    blMatrixType                                    getInertiaInverse()const;
 
     void                                            setMass(const blDataType& mass);
     void                                            setInertia(const blMatrixType& inertia);
 
+    // Function used to
+    // zero the inverse
+    // inertia, so torques
+    // can't turn the object
+    // (static and kinematic
+    // bodies), the inertia
+    // itself is kept and
+    // later calls to
+    // setInertia keep the
+    // inverse at zero
+
+    void                                            zeroInertiaInverse();
+
+    // Functions used to
+    // know whether the
+    // inertia tensor is
+    // diagonal and to get
+    // its principal moments
+    // and their reciprocals
+
+    bool                                            getIsInertiaDiagonal()const;
+    const blVectorType&                             getPrincipalMoments()const;
+    const blVectorType&                             getPrincipalMomentsInverse()const;
+
+    // Functions used to
+    // multiply a vector
+    // in body coordinates
+    // by the inertia and
+    // its inverse
+
+    blVectorType                                    applyInertia(const blVectorType& vector)const;
+    blVectorType                                    applyInertiaInverse(const blVectorType& vector)const;
+
+    // Function used to
+    // bring the inverse
+    // inertia in system
+    // coordinates up to date
+    // for the object's axes
+    // and orientation version
+
+    void                                            updateWorldInertia(const blVectorType& xAxis,
+                                                                       const blVectorType& yAxis,
+                                                                       const blVectorType& zAxis,
+                                                                       const std::size_t& orientationVersion)const;
+
+    // Function used to
+    // multiply a vector by
+    // the last calculated
+    // inverse inertia in
+    // system coordinates
+
+    blVectorType                                    applyCachedWorldInertiaInverse(const blVectorType& vector)const;
+
+private: // Private structs
+
+    // The full inertia
+    // tensor and its inverse
+
+    struct blInertiaTensors
+    {
+        blMatrixType                                m_inertia;
+        blMatrixType                                m_inertiaInverse;
+    };
+
 private: // Private variables
 
-    // The mass and
-    // inertia variables
+    // The mass
 
     blDataType                                      m_mass;
-    blMatrixType                                    m_inertia;
-    blMatrixType                                    m_inertiaInverse;
+
+    // The full tensors, only
+    // allocated when the
+    // inertia isn't diagonal
+
+    std::unique_ptr<blInertiaTensors>               m_inertiaTensors;
+
+    // The principal moments
+    // and their reciprocals
+    // when the inertia
+    // is diagonal
+
+    blVectorType                                    m_principalMoments;
+    blVectorType                                    m_principalMomentsInverse;
+
+    // Whether the inverse
+    // inertia is kept at zero
+
+    bool                                            m_isInertiaInverseZero;
+
+    // The columns of the
+    // inverse inertia in
+    // system coordinates and
+    // the orientation version
+    // they were calculated for
+
+    mutable blVectorType                            m_worldInertiaInverseColumns[3];
+    mutable std::size_t                             m_worldInertiaVersion;
+    mutable bool                                    m_isWorldInertiaOutdated;
 };
 //---------------------------------------------------------------------------------------
 
@@ -93,6 +212,9 @@ template<typename blDataType>
 inline blInertia<blDataType>::blInertia(const blDataType& mass,
                                         const blMatrixType& inertia)
 {
+    m_worldInertiaVersion = 0;
+    m_isInertiaInverseZero = false;
+
     // Set the mass
     // and inertia
     setMass(mass);
@@ -105,10 +227,40 @@ inline blInertia<blDataType>::blInertia(const blDataType& mass,
 template<typename blDataType>
 inline blInertia<blDataType>::blInertia(const blInertia<blDataType>& inertia)
 {
+    m_worldInertiaVersion = 0;
+
     // Copy the mass
     // and inertia
-    setMass(inertia.getMass());
-    setInertia(inertia.getInertia());
+    *this = inertia;
+}
+//---------------------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------------------
+template<typename blDataType>
+inline blInertia<blDataType>& blInertia<blDataType>::operator=(const blInertia<blDataType>& inertia)
+{
+    if(this == &inertia)
+        return *this;
+
+    m_mass = inertia.m_mass;
+
+    if(inertia.m_inertiaTensors)
+        m_inertiaTensors.reset(new blInertiaTensors(*inertia.m_inertiaTensors));
+    else
+        m_inertiaTensors.reset();
+
+    m_principalMoments = inertia.m_principalMoments;
+    m_principalMomentsInverse = inertia.m_principalMomentsInverse;
+    m_isInertiaInverseZero = inertia.m_isInertiaInverseZero;
+
+    // The inertia in system
+    // coordinates has to be
+    // calculated again
+
+    m_isWorldInertiaOutdated = true;
+
+    return *this;
 }
 //---------------------------------------------------------------------------------------
 
@@ -126,13 +278,71 @@ inline void blInertia<blDataType>::setMass(const blDataType& mass)
 template<typename blDataType>
 inline void blInertia<blDataType>::setInertia(const blMatrixType& inertia)
 {
-    m_inertia = inertia;
+    // Check whether the
+    // tensor is diagonal,
+    // reading its columns
+    // by multiplying it by
+    // the unit vectors
+
+    blVectorType column1 = inertia * blVectorType(1,0,0);
+    blVectorType column2 = inertia * blVectorType(0,1,0);
+    blVectorType column3 = inertia * blVectorType(0,0,1);
+
+    blDataType largestMoment = std::max(std::abs(column1.x()),
+                                        std::max(std::abs(column2.y()),
+                                                 std::abs(column3.z())));
+
+    blDataType largestProduct = std::max(std::max(std::max(std::abs(column1.y()),std::abs(column1.z())),
+                                                  std::max(std::abs(column2.x()),std::abs(column2.z()))),
+                                         std::max(std::abs(column3.x()),std::abs(column3.y())));
+
+    if(largestProduct <= blDataType(16) * std::numeric_limits<blDataType>::epsilon() * largestMoment)
+    {
+        m_inertiaTensors.reset();
+
+        m_principalMoments = blVectorType(column1.x(),column2.y(),column3.z());
+        m_principalMomentsInverse = blVectorType(blDataType(1) / column1.x(),
+                                                 blDataType(1) / column2.y(),
+                                                 blDataType(1) / column3.z());
+    }
+    else
+    {
+        // Calculate and store
+        // the inverse of the
+        // inertia matrix
 
-    // Calculate and store
-    // the inverse of the
-    // inertia matrix
+        m_inertiaTensors.reset(new blInertiaTensors());
+        m_inertiaTensors->m_inertia = inertia;
+        m_inertiaTensors->m_inertiaInverse = inv(inertia);
 
-    m_inertiaInverse = inv(m_inertia);
+        m_principalMoments = blVectorType(0,0,0);
+        m_principalMomentsInverse = blVectorType(0,0,0);
+    }
+
+    if(m_isInertiaInverseZero)
+        zeroInertiaInverse();
+
+    // The inertia in system
+    // coordinates has to be
+    // calculated again
+
+    m_isWorldInertiaOutdated = true;
+}
+//---------------------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------------------
+template<typename blDataType>
+inline void blInertia<blDataType>::zeroInertiaInverse()
+{
+    m_isInertiaInverseZero = true;
+
+    if(m_inertiaTensors)
+        m_inertiaTensors->m_inertiaInverse = blMathAPI::eye3d<blDataType>(0);
+    else
+        m_principalMomentsInverse = blVectorType(0,0,0);
+
+    m_isWorldInertiaOutdated = true;
 }
 //---------------------------------------------------------------------------------------
 
@@ -148,18 +358,142 @@ inline const blDataType& blInertia<blDataType>::getMass()const
 
 //---------------------------------------------------------------------------------------
 template<typename blDataType>
-inline const typename blInertia<blDataType>::blMatrixType& blInertia<blDataType>::getInertia()const
+inline typename blInertia<blDataType>::blMatrixType blInertia<blDataType>::getInertia()const
+{
+    if(m_inertiaTensors)
+        return m_inertiaTensors->m_inertia;
+
+    blMatrixType inertia = blMathAPI::eye3d<blDataType>(0);
+
+    inertia(0,0) = m_principalMoments.x();
+    inertia(1,1) = m_principalMoments.y();
+    inertia(2,2) = m_principalMoments.z();
+
+    return inertia;
+}
+//---------------------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------------------
+template<typename blDataType>
+inline typename blInertia<blDataType>::blMatrixType blInertia<blDataType>::getInertiaInverse()const
+{
+    if(m_inertiaTensors)
+        return m_inertiaTensors->m_inertiaInverse;
+
+    blMatrixType inertiaInverse = blMathAPI::eye3d<blDataType>(0);
+
+    inertiaInverse(0,0) = m_principalMomentsInverse.x();
+    inertiaInverse(1,1) = m_principalMomentsInverse.y();
+    inertiaInverse(2,2) = m_principalMomentsInverse.z();
+
+    return inertiaInverse;
+}
+//---------------------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------------------
+template<typename blDataType>
+inline bool blInertia<blDataType>::getIsInertiaDiagonal()const
 {
-    return m_inertia;
+    return !m_inertiaTensors;
+}
+//---------------------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------------------
+template<typename blDataType>
+inline const typename blInertia<blDataType>::blVectorType& blInertia<blDataType>::getPrincipalMoments()const
+{
+    return m_principalMoments;
+}
+//---------------------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------------------
+template<typename blDataType>
+inline const typename blInertia<blDataType>::blVectorType& blInertia<blDataType>::getPrincipalMomentsInverse()const
+{
+    return m_principalMomentsInverse;
+}
+//---------------------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------------------
+template<typename blDataType>
+inline typename blInertia<blDataType>::blVectorType blInertia<blDataType>::applyInertia(const blVectorType& vector)const
+{
+    if(!m_inertiaTensors)
+    {
+        return blVectorType(m_principalMoments.x() * vector.x(),
+                            m_principalMoments.y() * vector.y(),
+                            m_principalMoments.z() * vector.z());
+    }
+
+    return m_inertiaTensors->m_inertia * vector;
+}
+//---------------------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------------------
+template<typename blDataType>
+inline typename blInertia<blDataType>::blVectorType blInertia<blDataType>::applyInertiaInverse(const blVectorType& vector)const
+{
+    if(!m_inertiaTensors)
+    {
+        return blVectorType(m_principalMomentsInverse.x() * vector.x(),
+                            m_principalMomentsInverse.y() * vector.y(),
+                            m_principalMomentsInverse.z() * vector.z());
+    }
+
+    return m_inertiaTensors->m_inertiaInverse * vector;
+}
+//---------------------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------------------
+template<typename blDataType>
+inline void blInertia<blDataType>::updateWorldInertia(const blVectorType& xAxis,
+                                                      const blVectorType& yAxis,
+                                                      const blVectorType& zAxis,
+                                                      const std::size_t& orientationVersion)const
+{
+    if(!m_isWorldInertiaOutdated &&
+       m_worldInertiaVersion == orientationVersion)
+    {
+        return;
+    }
+
+    // The columns of R^T are
+    // the system axes in body
+    // coordinates, so column j
+    // of R*I^-1*R^T is R*I^-1
+    // times the j-th one of them
+
+    blVectorType systemAxesInBodyCoordinates[3] = {blVectorType(xAxis.x(),yAxis.x(),zAxis.x()),
+                                                   blVectorType(xAxis.y(),yAxis.y(),zAxis.y()),
+                                                   blVectorType(xAxis.z(),yAxis.z(),zAxis.z())};
+
+    for(int j = 0; j < 3; ++j)
+    {
+        blVectorType column = applyInertiaInverse(systemAxesInBodyCoordinates[j]);
+        m_worldInertiaInverseColumns[j] = xAxis * column.x() + yAxis * column.y() + zAxis * column.z();
+    }
+
+    m_worldInertiaVersion = orientationVersion;
+
+    m_isWorldInertiaOutdated = false;
 }
 //---------------------------------------------------------------------------------------
 
 
 //---------------------------------------------------------------------------------------
 template<typename blDataType>
-inline const typename blInertia<blDataType>::blMatrixType& blInertia<blDataType>::getInertiaInverse()const
+inline typename blInertia<blDataType>::blVectorType blInertia<blDataType>::applyCachedWorldInertiaInverse(const blVectorType& vector)const
 {
-    return m_inertiaInverse;
+    return m_worldInertiaInverseColumns[0] * vector.x() +
+           m_worldInertiaInverseColumns[1] * vector.y() +
+           m_worldInertiaInverseColumns[2] * vector.z();
 }
 //---------------------------------------------------------------------------------------
 
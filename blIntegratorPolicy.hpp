@@ -0,0 +1,121 @@
+#ifndef BL_INTEGRATORPOLICY_HPP
+#define BL_INTEGRATORPOLICY_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blIntegratorPolicy.hpp
+// CLASS:           blIntegratorPolicy
+// BASE CLASS:      None
+//
+// PURPOSE:         A base class for compile-time integrator policies,
+//                  it runs a full simulation step of a rigid body
+//                  (damping, integration, motion limits and clearing
+//                  the forces) and leaves the actual state update to
+//                  the derived policy
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blRigidBody
+//
+// NOTES:           - Derived policies pass themselves as the template
+//                    parameter (for ex. class blEulerIntegrator :
+//                    public blIntegratorPolicy<blEulerIntegrator>) and
+//                    implement a static integrateState function
+//                  - Every call on the rigid body that could reach a
+//                    virtual function (translate, rotate, calculateDamping,
+//                    resolveMotionLimits) is qualified, so the whole step
+//                    gets inlined with no virtual calls
+//                  - Policies are used as the second template parameter
+//                    of blRigidBodySystem, for ex.
+//                    blRigidBodySystem<double,blSemiImplicitEulerIntegrator>
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+
+template<typename blDataType>
+class blRigidBody;
+
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDerivedPolicy>
+class blIntegratorPolicy
+{
+public: // Public variables
+
+    // Compile-time policies
+    // ignore the system's
+    // integration method
+
+    enum {isRuntimeSelected = 0};
+
+public: // Public functions
+
+    // Function used to
+    // simulate a rigid
+    // body for one step
+
+    template<typename blDataType>
+    static void                                         simulate(blRigidBody<blDataType>& rigidBody,
+                                                                 const sf::Time& timeStep,
+                                                                 const sf::Time& totalTime,
+                                                                 const blMathAPI::blVector3d<blDataType>& accelerationField,
+                                                                 const int& integrationMethod);
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDerivedPolicy>
+template<typename blDataType>
+inline void blIntegratorPolicy<blDerivedPolicy>::simulate(blRigidBody<blDataType>& rigidBody,
+                                                          const sf::Time& timeStep,
+                                                          const sf::Time& /*totalTime*/,
+                                                          const blMathAPI::blVector3d<blDataType>& accelerationField,
+                                                          const int& /*integrationMethod*/)
+{
+    // Add the damping
+    // losses into the
+    // total body forces
+
+    rigidBody.addForce(rigidBody.blDamping<blDataType>::calculateDamping(rigidBody.getVelocity()));
+    rigidBody.addTorque(rigidBody.blDamping<blDataType>::calculateAngularDamping(rigidBody.getAngularVelocity()));
+
+    // Calculate the
+    // new state
+
+    blDerivedPolicy::integrateState(rigidBody,timeStep,accelerationField);
+
+    // Check the
+    // motion limits
+
+    rigidBody.blRigidBody<blDataType>::resolveMotionLimits();
+    rigidBody.blRigidBody<blDataType>::resolveAngularMotionLimits();
+
+    // Reset the total
+    // force and torque
+
+    rigidBody.clearForcesAndTorques();
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_INTEGRATORPOLICY_HPP
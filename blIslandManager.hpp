@@ -0,0 +1,561 @@
+#ifndef BL_ISLANDMANAGER_HPP
+#define BL_ISLANDMANAGER_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blIslandManager.hpp
+// CLASS:           blIslandManager
+// BASE CLASS:      None
+//
+// PURPOSE:         Groups rigid bodies linked by connections, joints
+//                  or contacts into islands (with a union-find) and
+//                  puts whole islands to sleep once all their bodies
+//                  have been at rest long enough
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blSleeping -- The bodies' sleeping state
+//                  - blAABB -- Used to find the touching bodies
+//
+// NOTES:           - Links are pairs of indices into the array of
+//                    bodies given to update()
+//                  - Bodies with no mass don't move, so they don't
+//                    join islands (a floor doesn't tie together all
+//                    the bodies resting on it) and don't sleep
+//                  - A body is at rest while its speed and angular
+//                    speed stay under the sleep thresholds, an island
+//                    falls asleep when all its bodies have been at rest
+//                    for the time to sleep, and its velocities are then
+//                    zeroed
+//                  - Bodies touching each other are linked when
+//                    their bounding boxes, grown by the contact margin,
+//                    overlap, a resting contact comes and goes from one
+//                    step to the next as gravity pulls the awake body
+//                    away from a sleeping one, the margin keeps them
+//                    linked through it
+//                  - An island with any awake body that isn't at rest
+//                    wakes up whole, so a body woken by a force, or
+//                    touched by a moving neighbor, wakes its island
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blIslandManager
+{
+public: // Public typedefs
+
+    typedef std::pair<std::size_t,std::size_t>          blPairType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blIslandManager(const blDataType& linearSleepThreshold = 0.05,
+                    const blDataType& angularSleepThreshold = 0.05,
+                    const blDataType& timeToSleep = 0.5,
+                    const blDataType& contactMargin = 0.02);
+
+    // Destructor
+
+    ~blIslandManager()
+    {
+    }
+
+public: // Public functions
+
+    // Index of the island of
+    // bodies that don't join
+    // any island
+
+    static const std::size_t                            nullIsland;
+
+    // Functions used to
+    // set/get the speeds under
+    // which a body is at rest
+
+    void                                                setSleepThresholds(const blDataType& linearSleepThreshold,
+                                                                           const blDataType& angularSleepThreshold);
+
+    const blDataType&                                   getLinearSleepThreshold()const;
+    const blDataType&                                   getAngularSleepThreshold()const;
+
+    // Functions used to
+    // set/get how long an
+    // island has to be at rest
+    // before it falls asleep
+
+    void                                                setTimeToSleep(const blDataType& timeToSleep);
+    const blDataType&                                   getTimeToSleep()const;
+
+    // Functions used to
+    // set/get how far apart
+    // two bodies can be and
+    // still count as touching
+
+    void                                                setContactMargin(const blDataType& contactMargin);
+    const blDataType&                                   getContactMargin()const;
+
+    // Function used to find
+    // the pairs of touching
+    // bodies among the pairs
+    // of a broadphase
+
+    void                                                findTouchingPairs(const std::vector< blAABB<blDataType> >& boundingBoxes,
+                                                                          const std::vector<blPairType>& pairs,
+                                                                          std::vector<blPairType>& links)const;
+
+    // Function used to build
+    // the islands and update
+    // their sleeping state
+
+    template<typename blRigidBodyPointerType>
+    void                                                update(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                               const std::vector<blPairType>& links,
+                                                               const blDataType& timeStep);
+
+    // Function used to
+    // only build the islands
+
+    template<typename blRigidBodyPointerType>
+    void                                                buildIslands(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                                     const std::vector<blPairType>& links);
+
+    // Functions used to get
+    // the islands, the bodies of
+    // island i are getIslandBodies()
+    // from getIslandStarts()[i] to
+    // getIslandStarts()[i + 1]
+
+    std::size_t                                         getNumberOfIslands()const;
+    const std::vector<std::size_t>&                     getIslandStarts()const;
+    const std::vector<std::size_t>&                     getIslandBodies()const;
+    const std::size_t&                                  getIsland(const std::size_t& bodyIndex)const;
+
+protected: // Protected functions
+
+    // Union-find functions
+
+    std::size_t                                         findRoot(std::size_t bodyIndex);
+    void                                                unite(const std::size_t& body1,
+                                                              const std::size_t& body2);
+
+    // Function used to update
+    // the sleeping state of
+    // the islands
+
+    template<typename blRigidBodyPointerType>
+    void                                                updateSleeping(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                                       const blDataType& timeStep);
+
+private: // Private variables
+
+    // The sleeping
+    // parameters
+
+    blDataType                                          m_linearSleepThreshold;
+    blDataType                                          m_angularSleepThreshold;
+    blDataType                                          m_timeToSleep;
+    blDataType                                          m_contactMargin;
+
+    // The union-find
+    // forest
+
+    std::vector<std::size_t>                            m_parents;
+    std::vector<std::size_t>                            m_sizes;
+
+    // The islands, with their
+    // bodies stored contiguously
+
+    std::vector<std::size_t>                            m_islands;
+    std::vector<std::size_t>                            m_islandStarts;
+    std::vector<std::size_t>                            m_islandBodies;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+const std::size_t blIslandManager<blDataType>::nullIsland = std::size_t(-1);
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blIslandManager<blDataType>::blIslandManager(const blDataType& linearSleepThreshold,
+                                                    const blDataType& angularSleepThreshold,
+                                                    const blDataType& timeToSleep,
+                                                    const blDataType& contactMargin)
+{
+    setSleepThresholds(linearSleepThreshold,angularSleepThreshold);
+    setTimeToSleep(timeToSleep);
+    setContactMargin(contactMargin);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blIslandManager<blDataType>::setSleepThresholds(const blDataType& linearSleepThreshold,
+                                                            const blDataType& angularSleepThreshold)
+{
+    m_linearSleepThreshold = std::max(linearSleepThreshold,blDataType(0));
+    m_angularSleepThreshold = std::max(angularSleepThreshold,blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blIslandManager<blDataType>::getLinearSleepThreshold()const
+{
+    return m_linearSleepThreshold;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blIslandManager<blDataType>::getAngularSleepThreshold()const
+{
+    return m_angularSleepThreshold;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blIslandManager<blDataType>::setTimeToSleep(const blDataType& timeToSleep)
+{
+    m_timeToSleep = std::max(timeToSleep,blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blIslandManager<blDataType>::getTimeToSleep()const
+{
+    return m_timeToSleep;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blIslandManager<blDataType>::setContactMargin(const blDataType& contactMargin)
+{
+    m_contactMargin = std::max(contactMargin,blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blIslandManager<blDataType>::getContactMargin()const
+{
+    return m_contactMargin;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blIslandManager<blDataType>::findTouchingPairs(const std::vector< blAABB<blDataType> >& boundingBoxes,
+                                                          const std::vector<blPairType>& pairs,
+                                                          std::vector<blPairType>& links)const
+{
+    for(std::size_t i = 0; i < pairs.size(); ++i)
+    {
+        blAABB<blDataType> boundingBox = boundingBoxes[pairs[i].first];
+        boundingBox.fatten(m_contactMargin);
+
+        if(boundingBox.overlaps(boundingBoxes[pairs[i].second]))
+            links.push_back(pairs[i]);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blIslandManager<blDataType>::getNumberOfIslands()const
+{
+    return m_islandStarts.empty() ? 0 : m_islandStarts.size() - 1;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<std::size_t>& blIslandManager<blDataType>::getIslandStarts()const
+{
+    return m_islandStarts;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<std::size_t>& blIslandManager<blDataType>::getIslandBodies()const
+{
+    return m_islandBodies;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::size_t& blIslandManager<blDataType>::getIsland(const std::size_t& bodyIndex)const
+{
+    return m_islands[bodyIndex];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blIslandManager<blDataType>::findRoot(std::size_t bodyIndex)
+{
+    // Path halving, every
+    // other node on the way
+    // skips to its grandparent
+
+    while(m_parents[bodyIndex] != bodyIndex)
+    {
+        m_parents[bodyIndex] = m_parents[m_parents[bodyIndex]];
+        bodyIndex = m_parents[bodyIndex];
+    }
+
+    return bodyIndex;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blIslandManager<blDataType>::unite(const std::size_t& body1,
+                                               const std::size_t& body2)
+{
+    std::size_t root1 = findRoot(body1);
+    std::size_t root2 = findRoot(body2);
+
+    if(root1 == root2)
+        return;
+
+    // The smaller tree
+    // goes under the
+    // bigger one
+
+    if(m_sizes[root1] < m_sizes[root2])
+        std::swap(root1,root2);
+
+    m_parents[root2] = root1;
+    m_sizes[root1] += m_sizes[root2];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blRigidBodyPointerType>
+inline void blIslandManager<blDataType>::update(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                const std::vector<blPairType>& links,
+                                                const blDataType& timeStep)
+{
+    buildIslands(rigidBodies,links);
+    updateSleeping(rigidBodies,timeStep);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blRigidBodyPointerType>
+inline void blIslandManager<blDataType>::buildIslands(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                      const std::vector<blPairType>& links)
+{
+    std::size_t numberOfBodies = rigidBodies.size();
+
+    // Step 1:  Every body
+    //          starts in its
+    //          own set
+
+    m_parents.resize(numberOfBodies);
+    m_sizes.assign(numberOfBodies,1);
+
+    for(std::size_t i = 0; i < numberOfBodies; ++i)
+        m_parents[i] = i;
+
+    // Step 2:  Merge the sets
+    //          of linked bodies
+    //          that have mass
+
+    for(std::size_t i = 0; i < links.size(); ++i)
+    {
+        const std::size_t& body1 = links[i].first;
+        const std::size_t& body2 = links[i].second;
+
+        if(body1 >= numberOfBodies || body2 >= numberOfBodies)
+            continue;
+
+        if(rigidBodies[body1]->getMass() <= 0 || rigidBodies[body2]->getMass() <= 0)
+            continue;
+
+        unite(body1,body2);
+    }
+
+    // Step 3:  Number the
+    //          islands and count
+    //          their bodies
+
+    m_islands.assign(numberOfBodies,nullIsland);
+    m_islandStarts.clear();
+
+    for(std::size_t i = 0; i < numberOfBodies; ++i)
+    {
+        if(rigidBodies[i]->getMass() <= 0)
+            continue;
+
+        std::size_t root = findRoot(i);
+
+        if(m_islands[root] == nullIsland)
+        {
+            m_islands[root] = m_islandStarts.size();
+            m_islandStarts.push_back(0);
+        }
+
+        m_islands[i] = m_islands[root];
+        ++m_islandStarts[m_islands[i]];
+    }
+
+    // Step 4:  Turn the counts
+    //          into starts and lay
+    //          the bodies out island
+    //          by island
+
+    std::size_t start = 0;
+
+    for(std::size_t i = 0; i < m_islandStarts.size(); ++i)
+    {
+        std::size_t count = m_islandStarts[i];
+        m_islandStarts[i] = start;
+        start += count;
+    }
+
+    m_islandStarts.push_back(start);
+    m_islandBodies.resize(start);
+
+    for(std::size_t i = 0; i < numberOfBodies; ++i)
+    {
+        if(m_islands[i] != nullIsland)
+            m_islandBodies[m_islandStarts[m_islands[i]]++] = i;
+    }
+
+    // The scatter moved each
+    // start to the next island's
+    // start, shift them back
+
+    for(std::size_t i = m_islandStarts.size() - 1; i > 0; --i)
+        m_islandStarts[i] = m_islandStarts[i - 1];
+
+    m_islandStarts[0] = 0;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+template<typename blRigidBodyPointerType>
+inline void blIslandManager<blDataType>::updateSleeping(const std::vector<blRigidBodyPointerType>& rigidBodies,
+                                                        const blDataType& timeStep)
+{
+    blDataType linearSleepThreshold2 = m_linearSleepThreshold * m_linearSleepThreshold;
+    blDataType angularSleepThreshold2 = m_angularSleepThreshold * m_angularSleepThreshold;
+
+    for(std::size_t island = 0; island + 1 < m_islandStarts.size(); ++island)
+    {
+        // Step 1:  Update how long
+        //          the awake bodies
+        //          have been at rest
+
+        bool isAnyBodyAwake = false;
+        blDataType minSleepTime = std::numeric_limits<blDataType>::max();
+
+        for(std::size_t i = m_islandStarts[island]; i < m_islandStarts[island + 1]; ++i)
+        {
+            const blRigidBodyPointerType& body = rigidBodies[m_islandBodies[i]];
+
+            if(!body->getIsAwake())
+                continue;
+
+            isAnyBodyAwake = true;
+
+            if(body->getVelocity() * body->getVelocity() > linearSleepThreshold2 ||
+               body->getAngularVelocity() * body->getAngularVelocity() > angularSleepThreshold2)
+            {
+                body->setSleepTime(0);
+            }
+            else
+            {
+                body->setSleepTime(body->getSleepTime() + timeStep);
+            }
+
+            minSleepTime = std::min(minSleepTime,body->getSleepTime());
+        }
+
+        // Step 2:  An island whose
+        //          bodies are all asleep
+        //          stays asleep
+
+        if(!isAnyBodyAwake)
+            continue;
+
+        // Step 3:  Put the island to
+        //          sleep if it has rested
+        //          long enough, wake it
+        //          all otherwise
+
+        bool shouldIslandSleep = (minSleepTime >= m_timeToSleep);
+
+        for(std::size_t i = m_islandStarts[island]; i < m_islandStarts[island + 1]; ++i)
+        {
+            const blRigidBodyPointerType& body = rigidBodies[m_islandBodies[i]];
+
+            if(shouldIslandSleep)
+            {
+                body->setIsAwake(false);
+                body->setVelocity(0,0,0);
+                body->setAngularVelocity(0,0,0);
+            }
+            else
+            {
+                body->setIsAwake(true);
+            }
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_ISLANDMANAGER_HPP
@@ -0,0 +1,266 @@
+#ifndef BL_MATRIX3DARRAY_HPP
+#define BL_MATRIX3DARRAY_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blMatrix3dArray.hpp
+// CLASS:           blMatrix3dArray
+// BASE CLASS:      None
+//
+// PURPOSE:         A structure-of-arrays container of 3x3 matrices,
+//                  where each of the nine elements of all the
+//                  matrices is stored in its own contiguous array
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    blMathAPI::blMatrix3d -- From the blMathAPI used to
+//                                           set single matrices
+//                  std::vector -- Used to store each element
+//
+// NOTES:           - Elements are addressed in row-major order,
+//                    so element(r,c) holds the (r,c) entry of
+//                    every matrix
+//                  - A blMatrix3d is unpacked by multiplying it
+//                    against the three unit vectors, which gives
+//                    us its columns without relying on how the
+//                    blMathAPI stores its entries
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blMatrix3dArray
+{
+public: // Public typedefs
+
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+    typedef blMathAPI::blMatrix3d<blDataType>           blMatrixType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blMatrix3dArray(const std::size_t& numberOfMatrices = 0);
+
+    // Destructor
+
+    ~blMatrix3dArray()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // get/change the
+    // number of matrices
+
+    std::size_t                                         size()const;
+    void                                                resize(const std::size_t& numberOfMatrices);
+    void                                                reserve(const std::size_t& numberOfMatrices);
+    void                                                clear();
+
+    // Functions used to
+    // add/remove matrices
+    // at the end of the
+    // arrays
+
+    void                                                push_back(const blMatrixType& matrix);
+    void                                                pop_back();
+
+    // Function used to
+    // set a single matrix
+
+    void                                                setMatrix(const std::size_t& index,
+                                                                  const blMatrixType& matrix);
+
+    // Function used to
+    // copy one matrix
+    // onto another one
+
+    void                                                copyMatrix(const std::size_t& fromIndex,
+                                                                   const std::size_t& toIndex);
+
+    // Function used to
+    // multiply one of the
+    // matrices by a vector
+
+    blVectorType                                        multiply(const std::size_t& index,
+                                                                 const blVectorType& vector)const;
+
+    // Functions used to
+    // get the element
+    // arrays
+
+    std::vector<blDataType>&                            element(const int& row,
+                                                                const int& col);
+
+    const std::vector<blDataType>&                      element(const int& row,
+                                                                const int& col)const;
+
+private: // Private variables
+
+    // The element
+    // arrays
+
+    std::vector<blDataType>                             m_elements[9];
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blMatrix3dArray<blDataType>::blMatrix3dArray(const std::size_t& numberOfMatrices)
+{
+    resize(numberOfMatrices);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blMatrix3dArray<blDataType>::size()const
+{
+    return m_elements[0].size();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blMatrix3dArray<blDataType>::resize(const std::size_t& numberOfMatrices)
+{
+    for(int i = 0; i < 9; ++i)
+        m_elements[i].resize(numberOfMatrices,0);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blMatrix3dArray<blDataType>::reserve(const std::size_t& numberOfMatrices)
+{
+    for(int i = 0; i < 9; ++i)
+        m_elements[i].reserve(numberOfMatrices);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blMatrix3dArray<blDataType>::clear()
+{
+    for(int i = 0; i < 9; ++i)
+        m_elements[i].clear();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blMatrix3dArray<blDataType>::push_back(const blMatrixType& matrix)
+{
+    for(int i = 0; i < 9; ++i)
+        m_elements[i].push_back(0);
+
+    setMatrix(size() - 1,matrix);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blMatrix3dArray<blDataType>::pop_back()
+{
+    for(int i = 0; i < 9; ++i)
+        m_elements[i].pop_back();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blMatrix3dArray<blDataType>::setMatrix(const std::size_t& index,
+                                                   const blMatrixType& matrix)
+{
+    // Extract the
+    // columns of the
+    // matrix
+
+    blVectorType columns[3] = {matrix * blVectorType(1,0,0),
+                               matrix * blVectorType(0,1,0),
+                               matrix * blVectorType(0,0,1)};
+
+    for(int col = 0; col < 3; ++col)
+    {
+        m_elements[col][index] = columns[col].x();
+        m_elements[3 + col][index] = columns[col].y();
+        m_elements[6 + col][index] = columns[col].z();
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blMatrix3dArray<blDataType>::copyMatrix(const std::size_t& fromIndex,
+                                                    const std::size_t& toIndex)
+{
+    for(int i = 0; i < 9; ++i)
+        m_elements[i][toIndex] = m_elements[i][fromIndex];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blMatrix3dArray<blDataType>::blVectorType blMatrix3dArray<blDataType>::multiply(const std::size_t& index,
+                                                                                                 const blVectorType& vector)const
+{
+    return blVectorType(m_elements[0][index]*vector.x() + m_elements[1][index]*vector.y() + m_elements[2][index]*vector.z(),
+                        m_elements[3][index]*vector.x() + m_elements[4][index]*vector.y() + m_elements[5][index]*vector.z(),
+                        m_elements[6][index]*vector.x() + m_elements[7][index]*vector.y() + m_elements[8][index]*vector.z());
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blMatrix3dArray<blDataType>::element(const int& row,
+                                                                     const int& col)
+{
+    return m_elements[3*row + col];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blMatrix3dArray<blDataType>::element(const int& row,
+                                                                           const int& col)const
+{
+    return m_elements[3*row + col];
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_MATRIX3DARRAY_HPP
@@ -0,0 +1,444 @@
+#ifndef BL_MEMORYPOOL_HPP
+#define BL_MEMORYPOOL_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blMemoryPool.hpp
+// CLASS:           blMemoryPool
+//                  blPoolAllocator
+// BASE CLASS:      None
+//
+// PURPOSE:         A fixed-block memory pool and a standard allocator
+//                  drawing from it, used with std::allocate_shared to
+//                  create rigid bodies and connections without going
+//                  through the global new/delete every time
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - std::mutex
+//                  - std::shared_ptr
+//
+// NOTES:           - The pool hands out blocks of one size, carved
+//                    out of chunks of many blocks, freed blocks go on
+//                    a free list and are handed out again, so once
+//                    the pool has grown (or has been reserved) to the
+//                    peak number of objects, spawning and despawning
+//                    them doesn't touch the global new/delete
+//                  - A pool built with a block size of zero takes the
+//                    size of its first allocation, so a pool used for
+//                    one type through blAllocateShared sizes itself to
+//                    that type and its shared_ptr control block
+//                  - Requests larger than a block, or for more than
+//                    one object, fall back to the global new/delete
+//                  - Chunks are only given back when the pool is
+//                    destroyed, the allocators keep the pool alive as
+//                    long as any object allocated from it is alive
+//                  - Allocating and freeing is guarded by a mutex, so
+//                    objects can be released from any thread
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+class blMemoryPool
+{
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blMemoryPool(const std::size_t& blockSize = 0,
+                 const std::size_t& numberOfBlocksPerChunk = 256);
+
+    // Destructor
+
+    ~blMemoryPool();
+
+private: // Non-copyable
+
+    blMemoryPool(const blMemoryPool&);
+    blMemoryPool&                                       operator=(const blMemoryPool&);
+
+public: // Public functions
+
+    // Functions used to
+    // get the block size
+    // and the number of
+    // blocks per chunk
+
+    std::size_t                                         getBlockSize()const;
+    const std::size_t&                                  getNumberOfBlocksPerChunk()const;
+
+    // Functions used to
+    // get how many blocks
+    // are in use and how
+    // many exist in total
+
+    std::size_t                                         getNumberOfUsedBlocks()const;
+    std::size_t                                         getNumberOfBlocks()const;
+
+    // Function used to grow
+    // the pool up front so
+    // that a number of blocks
+    // can be in use without
+    // it growing again
+
+    void                                                reserve(const std::size_t& numberOfBlocks);
+
+    // Functions used to get
+    // and give back memory
+
+    void*                                               allocate(const std::size_t& numberOfBytes);
+    void                                                deallocate(void* memory,
+                                                                   const std::size_t& numberOfBytes);
+
+private: // Private types
+
+    // A free block holds a
+    // pointer to the next one
+
+    struct blFreeBlock
+    {
+        blFreeBlock*                                    m_next;
+    };
+
+private: // Private functions
+
+    // Function used to set
+    // the block size, rounded
+    // up so every block is
+    // aligned for any type
+
+    void                                                setBlockSize(const std::size_t& blockSize);
+
+    // Function used to add
+    // a chunk of blocks to
+    // the free list
+
+    void                                                addChunk();
+
+private: // Private variables
+
+    // The size of a block
+    // and of a chunk
+
+    std::size_t                                         m_blockSize;
+    std::size_t                                         m_numberOfBlocksPerChunk;
+
+    // The chunks and the
+    // list of free blocks
+
+    std::vector<unsigned char*>                         m_chunks;
+    blFreeBlock*                                        m_freeBlocks;
+
+    // How many blocks
+    // are handed out
+
+    std::size_t                                         m_numberOfUsedBlocks;
+
+    // The mutex guarding
+    // the free list
+
+    mutable std::mutex                                  m_mutex;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline blMemoryPool::blMemoryPool(const std::size_t& blockSize,
+                                  const std::size_t& numberOfBlocksPerChunk)
+{
+    m_blockSize = 0;
+    m_numberOfBlocksPerChunk = std::max(numberOfBlocksPerChunk,std::size_t(1));
+    m_freeBlocks = nullptr;
+    m_numberOfUsedBlocks = 0;
+
+    if(blockSize > 0)
+        setBlockSize(blockSize);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline blMemoryPool::~blMemoryPool()
+{
+    for(std::size_t i = 0; i < m_chunks.size(); ++i)
+        ::operator delete(m_chunks[i]);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline std::size_t blMemoryPool::getBlockSize()const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_blockSize;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline const std::size_t& blMemoryPool::getNumberOfBlocksPerChunk()const
+{
+    return m_numberOfBlocksPerChunk;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline std::size_t blMemoryPool::getNumberOfUsedBlocks()const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_numberOfUsedBlocks;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline std::size_t blMemoryPool::getNumberOfBlocks()const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_chunks.size() * m_numberOfBlocksPerChunk;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blMemoryPool::reserve(const std::size_t& numberOfBlocks)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Without a block size
+    // there's nothing to
+    // carve the chunks into
+
+    if(m_blockSize == 0)
+        return;
+
+    while(m_chunks.size() * m_numberOfBlocksPerChunk < numberOfBlocks)
+        addChunk();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void* blMemoryPool::allocate(const std::size_t& numberOfBytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if(m_blockSize == 0)
+            setBlockSize(numberOfBytes);
+
+        if(numberOfBytes <= m_blockSize)
+        {
+            if(!m_freeBlocks)
+                addChunk();
+
+            blFreeBlock* block = m_freeBlocks;
+            m_freeBlocks = block->m_next;
+
+            ++m_numberOfUsedBlocks;
+
+            return block;
+        }
+    }
+
+    // Too big for
+    // a block
+
+    return ::operator new(numberOfBytes);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blMemoryPool::deallocate(void* memory,
+                                     const std::size_t& numberOfBytes)
+{
+    if(!memory)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if(numberOfBytes <= m_blockSize)
+        {
+            blFreeBlock* block = static_cast<blFreeBlock*>(memory);
+            block->m_next = m_freeBlocks;
+            m_freeBlocks = block;
+
+            --m_numberOfUsedBlocks;
+
+            return;
+        }
+    }
+
+    ::operator delete(memory);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blMemoryPool::setBlockSize(const std::size_t& blockSize)
+{
+    const std::size_t alignment = alignof(std::max_align_t);
+
+    std::size_t size = std::max(blockSize,sizeof(blFreeBlock));
+
+    m_blockSize = (size + alignment - 1) / alignment * alignment;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blMemoryPool::addChunk()
+{
+    unsigned char* chunk = static_cast<unsigned char*>(::operator new(m_blockSize * m_numberOfBlocksPerChunk));
+
+    m_chunks.push_back(chunk);
+
+    // Thread the chunk's
+    // blocks onto the
+    // free list, first
+    // block first
+
+    for(std::size_t i = m_numberOfBlocksPerChunk; i > 0; --i)
+    {
+        blFreeBlock* block = reinterpret_cast<blFreeBlock*>(chunk + (i - 1) * m_blockSize);
+        block->m_next = m_freeBlocks;
+        m_freeBlocks = block;
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blType>
+class blPoolAllocator
+{
+public: // Public typedefs
+
+    typedef blType                                      value_type;
+
+    template<typename blOtherType>
+    struct rebind
+    {
+        typedef blPoolAllocator<blOtherType>            other;
+    };
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blPoolAllocator(const std::shared_ptr<blMemoryPool>& memoryPool)
+                    : m_memoryPool(memoryPool)
+    {
+    }
+
+    // Copy constructor
+    // from an allocator
+    // of another type
+
+    template<typename blOtherType>
+    blPoolAllocator(const blPoolAllocator<blOtherType>& poolAllocator)
+                    : m_memoryPool(poolAllocator.getMemoryPool())
+    {
+    }
+
+public: // Public functions
+
+    // Function used to
+    // get the pool
+
+    const std::shared_ptr<blMemoryPool>&                getMemoryPool()const
+    {
+        return m_memoryPool;
+    }
+
+    // Functions used to
+    // get and give back
+    // memory for n objects
+
+    blType*                                             allocate(const std::size_t& n)
+    {
+        return static_cast<blType*>(m_memoryPool->allocate(n * sizeof(blType)));
+    }
+
+    void                                                deallocate(blType* memory,
+                                                                   const std::size_t& n)
+    {
+        m_memoryPool->deallocate(memory,n * sizeof(blType));
+    }
+
+private: // Private variables
+
+    // The pool
+
+    std::shared_ptr<blMemoryPool>                       m_memoryPool;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blType1,typename blType2>
+inline bool operator==(const blPoolAllocator<blType1>& poolAllocator1,
+                       const blPoolAllocator<blType2>& poolAllocator2)
+{
+    return poolAllocator1.getMemoryPool() == poolAllocator2.getMemoryPool();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blType1,typename blType2>
+inline bool operator!=(const blPoolAllocator<blType1>& poolAllocator1,
+                       const blPoolAllocator<blType2>& poolAllocator2)
+{
+    return !(poolAllocator1 == poolAllocator2);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Creates an object and its
+// shared_ptr control block in
+// one block of the pool, or
+// with std::make_shared when
+// there is no pool
+//-------------------------------------------------------------------
+template<typename blType,typename... blArgumentTypes>
+inline std::shared_ptr<blType> blAllocateShared(const std::shared_ptr<blMemoryPool>& memoryPool,
+                                                blArgumentTypes&&... arguments)
+{
+    if(!memoryPool)
+        return std::make_shared<blType>(std::forward<blArgumentTypes>(arguments)...);
+
+    return std::allocate_shared<blType>(blPoolAllocator<blType>(memoryPool),
+                                        std::forward<blArgumentTypes>(arguments)...);
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_MEMORYPOOL_HPP
@@ -25,7 +25,24 @@
 //                  blMathAPI::blQuaternion -- From the blMathAPI used to
 //                                  represent rotation orientation
 //
-// NOTES:
+// NOTES:           - Rotating only updates the rotation quaternions,
+//                    the orientation axes and the angle/axis of
+//                    rotation are flagged as outdated and calculated
+//                    again the first time they're asked for, so the
+//                    integrators don't pay for them every step
+//                  - Since the first get after a rotation writes the
+//                    cached values, code reading the same body from
+//                    several threads at once should bring them up to
+//                    date first with updateOrientationAxes() and
+//                    updateOrientationAngleAndAxisOfRotation()
+//                  - Every change of the rotation bumps the orientation
+//                    version, so values cached from the orientation
+//                    elsewhere (like the inertia in system coordinates)
+//                    know they're outdated by comparing one number
+//                  - The shouldOrientationAxesBeUpdated and
+//                    shouldOrientationAngleAndAxisBeUpdated flags are
+//                    kept for compatibility, the values are kept up
+//                    to date lazily either way
 //
 // DATE CREATED:    Nov/08/2010
 // DATE UPDATED:
@@ -62,6 +79,14 @@ public: // Constructors and destructors
     // Copy constructor
     blOrientation(const blOrientation<blDataType>& orientation);
 
+    // Move constructor
+    blOrientation(blOrientation<blDataType>&& orientation) = default;
+
+    // Copy and move
+    // assignments
+    blOrientation<blDataType>&                                  operator=(const blOrientation<blDataType>& orientation) = default;
+    blOrientation<blDataType>&                                  operator=(blOrientation<blDataType>&& orientation) = default;
+
     // Destructor
     ~blOrientation(void)
     {
@@ -96,11 +121,25 @@ public: // Public functions
     // Function used to
     // rotate the body
     // using a quaternion
+    // (the update flags of
+    // the rotate functions
+    // are ignored, see NOTES)
 
     virtual void                                                rotate(const blQuaternionType& rotQtn,
                                                                        const bool& shouldOrientationAxesBeUpdated = true,
                                                                        const bool& shouldOrientationAngleAndAxisBeUpdated = true);
 
+    // Function used to
+    // rotate the body to
+    // a given orientation
+    // (unlike setOrientation
+    // this keeps the starting
+    // orientation)
+
+    virtual void                                                rotateTo(const blQuaternionType& rotQtn,
+                                                                         const bool& shouldOrientationAxesBeUpdated = true,
+                                                                         const bool& shouldOrientationAngleAndAxisBeUpdated = true);
+
     // Function used to
     // rotate the object
     // using three Euler
@@ -171,19 +210,29 @@ public: // Public functions
     const blVectorType&                                         getTotalEulerAngles()const;
     const blVectorType&                                         getEarlierTotalEulerAngles()const;
 
+    // Function used to
+    // get the orientation
+    // version, bumped every
+    // time the rotation
+    // changes
+
+    const std::size_t&                                          getOrientationVersion()const;
+
     // Function used to
     // update the object's
     // current x,y,z
     // coordinate axes
+    // if they're outdated
 
-    void                                                        updateOrientationAxes();
+    void                                                        updateOrientationAxes()const;
 
     // Function used to
     // update the object's
     // current orientation
     // angle/axis of rotation
+    // if it's outdated
 
-    void                                                        updateOrientationAngleAndAxisOfRotation();
+    void                                                        updateOrientationAngleAndAxisOfRotation()const;
 
     // Function used to
     // update the object's
@@ -202,18 +251,26 @@ public: // Public functions
 private: // Private Variables
 
     // The object's
-    // coordinate axes
+    // coordinate axes,
+    // calculated from the
+    // rotation quaternion
+    // when outdated
 
-    blVectorType                                                m_xAxis;
-    blVectorType                                                m_yAxis;
-    blVectorType                                                m_zAxis;
+    mutable blVectorType                                        m_xAxis;
+    mutable blVectorType                                        m_yAxis;
+    mutable blVectorType                                        m_zAxis;
+    mutable bool                                                m_areOrientationAxesOutdated;
 
     // Rotation angle
     // and axis for the
-    // current orientation
+    // current orientation,
+    // calculated from the
+    // rotation quaternion
+    // when outdated
 
-    blDataType                                                  m_angleOfRotation;
-    blVectorType                                                m_axisOfRotation;
+    mutable blDataType                                          m_angleOfRotation;
+    mutable blVectorType                                        m_axisOfRotation;
+    mutable bool                                                m_isAngleAndAxisOfRotationOutdated;
 
     // Rotation quaternion
     // used to rotate and
@@ -232,6 +289,11 @@ private: // Private Variables
 
     blVectorType                                                m_totalEulerAngles;
     blVectorType                                                m_earlierTotalEulerAngles;
+
+    // The orientation
+    // version
+
+    std::size_t                                                 m_orientationVersion;
 };
 //-------------------------------------------------------------------
 
@@ -241,6 +303,8 @@ template<typename blDataType>
 inline blOrientation<blDataType>::blOrientation(const blVectorType& xAxis,
                                                 const blVectorType& yAxis)
 {
+    m_orientationVersion = 0;
+
     setOrientationWithTwoAxes(xAxis,yAxis);
 }
 //-------------------------------------------------------------------
@@ -256,6 +320,7 @@ inline blOrientation<blDataType>::blOrientation(const blOrientation<blDataType>&
     m_xAxis = orientation.getxAxis();
     m_yAxis = orientation.getyAxis();
     m_zAxis = orientation.getzAxis();
+    m_areOrientationAxesOutdated = false;
 
     // Get and store the
     // rotation angle/axis
@@ -263,12 +328,14 @@ inline blOrientation<blDataType>::blOrientation(const blOrientation<blDataType>&
 
     m_angleOfRotation = orientation.getAngleOfRotation();
     m_axisOfRotation = orientation.getAxisOfRotation();
+    m_isAngleAndAxisOfRotationOutdated = false;
     m_rotQtn = orientation.getRotQtn();
     m_lastRotQtn = orientation.getLastRotQtn();
     m_earlierRotQtn = orientation.getEarlierRotQtn();
     m_startingRotQtn = orientation.getStartingRotQtn();
     m_totalEulerAngles = orientation.getTotalEulerAngles();
     m_earlierTotalEulerAngles = orientation.getEarlierTotalEulerAngles();
+    m_orientationVersion = orientation.getOrientationVersion();
 }
 //-------------------------------------------------------------------
 
@@ -289,6 +356,8 @@ inline void blOrientation<blDataType>::setOrientationWithTwoAxes(const blVectorT
 
     m_zAxis = blMathAPI::getNormalized(crossProduct(m_xAxis,m_yAxis));
 
+    m_areOrientationAxesOutdated = false;
+
     // Third:       Calculate an angle/axis
     //              of rotation that rotates
     //              the object's x axis so that
@@ -347,7 +416,9 @@ inline void blOrientation<blDataType>::setOrientationWithTwoAxes(const blVectorT
 
     resetTotalEulerAngles();
 
-    updateOrientationAngleAndAxisOfRotation();
+    m_isAngleAndAxisOfRotationOutdated = true;
+
+    ++m_orientationVersion;
 }
 //-------------------------------------------------------------------
 
@@ -364,13 +435,15 @@ inline void blOrientation<blDataType>::setOrientation(const blQuaternionType& ro
     m_earlierRotQtn = m_rotQtn;
     m_startingRotQtn = m_rotQtn;
 
-    // Update the axis
-    // and angle of rotation
-    // and the coordinate
-    // axes
+    // The axis and angle
+    // of rotation and the
+    // coordinate axes are
+    // now outdated
 
-    updateOrientationAxes();
-    updateOrientationAngleAndAxisOfRotation();
+    m_areOrientationAxesOutdated = true;
+    m_isAngleAndAxisOfRotationOutdated = true;
+
+    ++m_orientationVersion;
 
     // We zero out the
     // total euler angles
@@ -417,8 +490,8 @@ inline void blOrientation<blDataType>::setOrientationWithEulerAngles(const blDat
 //-------------------------------------------------------------------
 template<typename blDataType>
 inline void blOrientation<blDataType>::rotate(const blQuaternionType& rotQtn,
-                                              const bool& shouldOrientationAxesBeUpdated,
-                                              const bool& shouldOrientationAngleAndAxisBeUpdated)
+                                              const bool& /*shouldOrientationAxesBeUpdated*/,
+                                              const bool& /*shouldOrientationAngleAndAxisBeUpdated*/)
 {
     // First:       Store the current
     //              rotation
@@ -440,23 +513,54 @@ inline void blOrientation<blDataType>::rotate(const blQuaternionType& rotQtn,
     else
         m_rotQtn = rotQtn*m_rotQtn;
 
-    // Third:       Update the
-    //              orientation
-    //              axes
+    // Third:       The orientation
+    //              axes and the angle/
+    //              axis of rotation are
+    //              only calculated again
+    //              when asked for
+
+    m_areOrientationAxesOutdated = true;
+    m_isAngleAndAxisOfRotationOutdated = true;
+
+    ++m_orientationVersion;
+
+    // Fourth:      Move the total
+    //              euler angles along,
+    //              updateTotalEulerAngles
+    //              compares the current
+    //              rotation with itself,
+    //              so this is all it did
+    //              besides two quaternion
+    //              to euler conversions
+
+    m_earlierTotalEulerAngles = m_totalEulerAngles;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blOrientation<blDataType>::rotateTo(const blQuaternionType& rotQtn,
+                                                const bool& /*shouldOrientationAxesBeUpdated*/,
+                                                const bool& /*shouldOrientationAngleAndAxisBeUpdated*/)
+{
+    // Store the rotation
+    // that takes us from
+    // the current to the
+    // new orientation
+
+    m_lastRotQtn = rotQtn * m_rotQtn.getConjugate();
 
-    if(shouldOrientationAxesBeUpdated)
-        updateOrientationAxes();
+    m_earlierRotQtn = m_rotQtn;
 
-    // Fourth:      Update the angle
-    //              axis of rotation
+    m_rotQtn = rotQtn;
 
-    if(shouldOrientationAngleAndAxisBeUpdated)
-        updateOrientationAngleAndAxisOfRotation();
+    m_areOrientationAxesOutdated = true;
+    m_isAngleAndAxisOfRotationOutdated = true;
 
-    // Fifth:       Update the total
-    //              euler angles
+    ++m_orientationVersion;
 
-    updateTotalEulerAngles();
+    m_earlierTotalEulerAngles = m_totalEulerAngles;
 }
 //-------------------------------------------------------------------
 
@@ -528,8 +632,8 @@ inline void blOrientation<blDataType>::rotateWithAngleAxis(const blDataType& Ang
 //-------------------------------------------------------------------
 template<typename blDataType>
 inline void blOrientation<blDataType>::adjustOrientation(const blVectorType& totalEulerAngles,
-                                                         const bool& shouldOrientationAxesBeUpdated,
-                                                         const bool& shouldOrientationAngleAndAxisBeUpdated)
+                                                         const bool& /*shouldOrientationAxesBeUpdated*/,
+                                                         const bool& /*shouldOrientationAngleAndAxisBeUpdated*/)
 {
     // Form a quaternion
     // for this rotation
@@ -546,28 +650,26 @@ inline void blOrientation<blDataType>::adjustOrientation(const blVectorType& tot
     m_earlierTotalEulerAngles = m_totalEulerAngles;
     m_totalEulerAngles = totalEulerAngles;
 
-    // Update the
-    // orientation
-    // axes
-
-    if(shouldOrientationAxesBeUpdated)
-        updateOrientationAxes();
-
-    // Update the
-    // orientation
-    // angle and
+    // The orientation
+    // axes and angle and
     // axis of rotation
+    // are now outdated
+
+    m_areOrientationAxesOutdated = true;
+    m_isAngleAndAxisOfRotationOutdated = true;
 
-    if(shouldOrientationAngleAndAxisBeUpdated)
-        updateOrientationAngleAndAxisOfRotation();
+    ++m_orientationVersion;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
 template<typename blDataType>
-inline void blOrientation<blDataType>::updateOrientationAxes()
+inline void blOrientation<blDataType>::updateOrientationAxes()const
 {
+    if(!m_areOrientationAxesOutdated)
+        return;
+
     // First:       rotate the object's
     //              orientation axes
 
@@ -582,15 +684,22 @@ inline void blOrientation<blDataType>::updateOrientationAxes()
     //              x into y
 
     m_zAxis = blMathAPI::getNormalized(crossProduct(m_xAxis,m_yAxis));
+
+    m_areOrientationAxesOutdated = false;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
 template<typename blDataType>
-inline void blOrientation<blDataType>::updateOrientationAngleAndAxisOfRotation()
+inline void blOrientation<blDataType>::updateOrientationAngleAndAxisOfRotation()const
 {
+    if(!m_isAngleAndAxisOfRotationOutdated)
+        return;
+
     blMathAPI::quaternionToAxisAngle(m_rotQtn,m_axisOfRotation,m_angleOfRotation);
+
+    m_isAngleAndAxisOfRotationOutdated = false;
 }
 //-------------------------------------------------------------------
 
@@ -687,6 +796,8 @@ inline void blOrientation<blDataType>::resetTotalEulerAngles()
 template<typename blDataType>
 inline const typename blOrientation<blDataType>::blVectorType& blOrientation<blDataType>::getxAxis()const
 {
+    updateOrientationAxes();
+
     return m_xAxis;
 }
 //-------------------------------------------------------------------
@@ -696,6 +807,8 @@ inline const typename blOrientation<blDataType>::blVectorType& blOrientation<blD
 template<typename blDataType>
 inline const typename blOrientation<blDataType>::blVectorType& blOrientation<blDataType>::getyAxis()const
 {
+    updateOrientationAxes();
+
     return m_yAxis;
 }
 //-------------------------------------------------------------------
@@ -705,6 +818,8 @@ inline const typename blOrientation<blDataType>::blVectorType& blOrientation<blD
 template<typename blDataType>
 inline const typename blOrientation<blDataType>::blVectorType& blOrientation<blDataType>::getzAxis()const
 {
+    updateOrientationAxes();
+
     return m_zAxis;
 }
 //-------------------------------------------------------------------
@@ -714,6 +829,8 @@ inline const typename blOrientation<blDataType>::blVectorType& blOrientation<blD
 template<typename blDataType>
 inline const blDataType& blOrientation<blDataType>::getAngleOfRotation()const
 {
+    updateOrientationAngleAndAxisOfRotation();
+
     return m_angleOfRotation;
 }
 //-------------------------------------------------------------------
@@ -723,6 +840,8 @@ inline const blDataType& blOrientation<blDataType>::getAngleOfRotation()const
 template<typename blDataType>
 inline const typename blOrientation<blDataType>::blVectorType& blOrientation<blDataType>::getAxisOfRotation()const
 {
+    updateOrientationAngleAndAxisOfRotation();
+
     return m_axisOfRotation;
 }
 //-------------------------------------------------------------------
@@ -782,4 +901,13 @@ inline const typename blOrientation<blDataType>::blVectorType& blOrientation<blD
 //-------------------------------------------------------------------
 
 
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::size_t& blOrientation<blDataType>::getOrientationVersion()const
+{
+    return m_orientationVersion;
+}
+//-------------------------------------------------------------------
+
+
 #endif // BL_ORIENTATION_HPP
@@ -59,12 +59,12 @@ public: // Constructors and destructors
     // Default constructor
 
     blPolySpring(const blDataType& naturalLength = 1,
-                 const std::shared_ptr< blRigidBody<blDataType> >& rigidBody1 = std::shared_ptr< blRigidBody<blDataType> >(),
-                 const std::shared_ptr< blRigidBody<blDataType> >& rigidBody2 = std::shared_ptr< blRigidBody<blDataType> >(),
+                 const typename blConnection<blDataType>::blBodyHandle& rigidBody1Handle = blRigidBodyTable<blDataType>::getNullHandle(),
+                 const typename blConnection<blDataType>::blBodyHandle& rigidBody2Handle = blRigidBodyTable<blDataType>::getNullHandle(),
                  const blMathAPI::blVector3d<blDataType>& rigidBody1ConnectionPosition = blMathAPI::blVector3d<blDataType>(0,0,0),
                  const blMathAPI::blVector3d<blDataType>& rigidBody2ConnectionPosition = blMathAPI::blVector3d<blDataType>(0,0,0))
-                 : blConnection<blDataType>(rigidBody1,
-                                            rigidBody2,
+                 : blConnection<blDataType>(rigidBody1Handle,
+                                            rigidBody2Handle,
                                             rigidBody1ConnectionPosition,
                                             rigidBody2ConnectionPosition)
     {
@@ -94,6 +94,41 @@ public: // Constructors and destructors
         setCoeffs(spring1.getCoeffs());
     }
 
+    // Move constructor, it
+    // takes over the coefficients
+    // instead of copying them
+
+    blPolySpring(blPolySpring<blDataType>&& spring1) noexcept
+                 : blConnection<blDataType>(std::move(spring1))
+    {
+        setNaturalLength(spring1.getNaturalLength());
+
+        setCoeffs(std::move(spring1.m_coeffs));
+    }
+
+    // Copy and move
+    // assignments
+
+    blPolySpring<blDataType>& operator=(const blPolySpring<blDataType>& spring1)
+    {
+        blConnection<blDataType>::operator=(spring1);
+
+        setNaturalLength(spring1.getNaturalLength());
+        setCoeffs(spring1.getCoeffs());
+
+        return *this;
+    }
+
+    blPolySpring<blDataType>& operator=(blPolySpring<blDataType>&& spring1)
+    {
+        blConnection<blDataType>::operator=(std::move(spring1));
+
+        setNaturalLength(spring1.getNaturalLength());
+        setCoeffs(std::move(spring1.m_coeffs));
+
+        return *this;
+    }
+
     // Destructor
 
     ~blPolySpring()
@@ -114,6 +149,7 @@ public: // Public functions
     template<int numOfCoeffs>
     void                                            setCoeffs(const blDataType(&coeffs)[numOfCoeffs]);
     void                                            setCoeffs(const std::vector<blDataType>& coeffs);
+    void                                            setCoeffs(std::vector<blDataType>&& coeffs);
 
     // Function used to get the
     // array of coefficients
@@ -121,10 +157,10 @@ public: // Public functions
     const std::vector<blDataType>&                  getCoeffs()const;
 
     // Function that calculates and
-    // applies forces/torques to the
-    // rigid bodies
+    // stores the forces/torques
+    // to apply to the rigid bodies
 
-    virtual void                                    calculateAndApplyForcesAndTorques();
+    virtual void                                    calculateForcesAndTorques();
 
     // Function used to know
     // whether this connection
@@ -137,6 +173,15 @@ public: // Public functions
 
     virtual bool                                    hasConnectionBeenBroken()const;
 
+    // Function used by implicit
+    // integration to get the
+    // spring's stiffness, the
+    // spring has no velocity
+    // dependence
+
+    virtual bool                                    calculateForceJacobians(blDataType (&positionJacobian)[3][3],
+                                                                            blDataType (&velocityJacobian)[3][3]);
+
 protected: // Protected variables
 
     // The spring's natural length
@@ -187,6 +232,15 @@ inline void blPolySpring<blDataType>::setCoeffs(const std::vector<blDataType>& c
 //-------------------------------------------------------------------
 
 
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blPolySpring<blDataType>::setCoeffs(std::vector<blDataType>&& coeffs)
+{
+    m_coeffs = std::move(coeffs);
+}
+//-------------------------------------------------------------------
+
+
 //-------------------------------------------------------------------
 template<typename blDataType>
 inline const std::vector<blDataType>& blPolySpring<blDataType>::getCoeffs()const
@@ -198,18 +252,22 @@ inline const std::vector<blDataType>& blPolySpring<blDataType>::getCoeffs()const
 
 //-------------------------------------------------------------------
 template<typename blDataType>
-inline void blPolySpring<blDataType>::calculateAndApplyForcesAndTorques()
+inline void blPolySpring<blDataType>::calculateForcesAndTorques()
 {
     // Step 1:  Check that we have valid
     //          rigid bodies
 
-    if(this->m_rigidBody1.use_count() <= 0 ||
-       this->m_rigidBody2.use_count() <= 0)
+    blRigidBody<blDataType>* rigidBody1 = this->getRigidBody1();
+    blRigidBody<blDataType>* rigidBody2 = this->getRigidBody2();
+
+    if(!rigidBody1 || !rigidBody2)
     {
         // Error -- Not all rigid bodies
         //          are attached to this
         //          spring
 
+        this->clearStoredForcesAndTorques();
+
         return;
     }
 
@@ -221,8 +279,8 @@ inline void blPolySpring<blDataType>::calculateAndApplyForcesAndTorques()
     blMathAPI::blVector3d<blDataType> Pos1 = this->m_rigidBody1ConnectionPosition;
     blMathAPI::blVector3d<blDataType> Pos2 = this->m_rigidBody2ConnectionPosition;
 
-    this->m_rigidBody1->fromBodyToSystemCoordinates(Pos1);
-    this->m_rigidBody2->fromBodyToSystemCoordinates(Pos2);
+    rigidBody1->fromBodyToSystemCoordinates(Pos1);
+    rigidBody2->fromBodyToSystemCoordinates(Pos2);
 
     // Step 2:  calculate the spring's
     //          distance vector
@@ -248,12 +306,13 @@ inline void blPolySpring<blDataType>::calculateAndApplyForcesAndTorques()
         force += m_coeffs[i] * std::pow(elongation,i);
     }
 
-    // Step 5:  Finally we apply the calculated
-    //          force both as a force and torque
-    //          to the rigid bodies
+    // Step 5:  Finally we store the calculated
+    //          force, it gets applied both as a
+    //          force and torque to the rigid bodies
+    //          by applyForcesAndTorques
 
-    this->m_rigidBody1->addForceAndTorque(force*distanceVector,this->m_rigidBody1ConnectionPosition);
-    this->m_rigidBody2->addForceAndTorque(-force*distanceVector,this->m_rigidBody2ConnectionPosition);
+    this->storeForcesAndTorques(force*distanceVector,Pos1,
+                                -force*distanceVector,Pos2);
 }
 //-------------------------------------------------------------------
 
@@ -270,4 +329,18 @@ inline bool blPolySpring<blDataType>::hasConnectionBeenBroken()const
 //-------------------------------------------------------------------
 
 
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blPolySpring<blDataType>::calculateForceJacobians(blDataType (&positionJacobian)[3][3],
+                                                              blDataType (&velocityJacobian)[3][3])
+{
+    return this->calculatePolySpringJacobians(m_coeffs.data(),
+                                              m_coeffs.size(),
+                                              m_naturalLength,
+                                              positionJacobian,
+                                              velocityJacobian);
+}
+//-------------------------------------------------------------------
+
+
 #endif // BL_POLYSPRING_HPP
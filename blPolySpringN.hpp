@@ -0,0 +1,347 @@
+#ifndef BL_POLYSPRINGN_HPP
+#define BL_POLYSPRINGN_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blPolySpringN.hpp
+// CLASS:           blPolySpringN
+//                  blPolynomialEvaluator
+// BASE CLASS:      blConnection
+//
+// PURPOSE:         Based on blConnection, a polynomial spring like
+//                  blPolySpring whose degree is fixed at compile time,
+//                  so its coefficients live inside the spring and its
+//                  force is evaluated by an unrolled Horner's method
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blConnection and all its dependencies
+//
+// NOTES:           - The coefficients are a std::array of
+//                    polynomialDegree + 1 values, so building or
+//                    copying a spring allocates nothing
+//                  - The force c0 + x*(c1 + x*(c2 + ...)) is expanded
+//                    by blPolynomialEvaluator one template per
+//                    coefficient, a linear spring is one multiply-add
+//                    and a cubic one is three
+//                  - Setting fewer coefficients than the spring holds
+//                    zeroes the rest, setting more doesn't compile
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Evaluates the polynomial from
+// the coefficient at index on,
+// c[index] + x*(c[index + 1] + ...)
+//-------------------------------------------------------------------
+template<typename blDataType,int polynomialDegree,int index = 0>
+struct blPolynomialEvaluator
+{
+    static blDataType evaluate(const std::array<blDataType,polynomialDegree + 1>& coeffs,
+                               const blDataType& x)
+    {
+        return coeffs[index] + x * blPolynomialEvaluator<blDataType,polynomialDegree,index + 1>::evaluate(coeffs,x);
+    }
+};
+
+template<typename blDataType,int polynomialDegree>
+struct blPolynomialEvaluator<blDataType,polynomialDegree,polynomialDegree>
+{
+    static blDataType evaluate(const std::array<blDataType,polynomialDegree + 1>& coeffs,
+                               const blDataType& /*x*/)
+    {
+        return coeffs[polynomialDegree];
+    }
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int polynomialDegree>
+class blPolySpringN : public blConnection<blDataType>
+{
+public: // Public typedefs
+
+    typedef std::array<blDataType,polynomialDegree + 1>    blCoeffsType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blPolySpringN(const blDataType& naturalLength = 1,
+                  const typename blConnection<blDataType>::blBodyHandle& rigidBody1Handle = blRigidBodyTable<blDataType>::getNullHandle(),
+                  const typename blConnection<blDataType>::blBodyHandle& rigidBody2Handle = blRigidBodyTable<blDataType>::getNullHandle(),
+                  const blMathAPI::blVector3d<blDataType>& rigidBody1ConnectionPosition = blMathAPI::blVector3d<blDataType>(0,0,0),
+                  const blMathAPI::blVector3d<blDataType>& rigidBody2ConnectionPosition = blMathAPI::blVector3d<blDataType>(0,0,0))
+                  : blConnection<blDataType>(rigidBody1Handle,
+                                             rigidBody2Handle,
+                                             rigidBody1ConnectionPosition,
+                                             rigidBody2ConnectionPosition)
+    {
+        // set the natural length
+
+        setNaturalLength(naturalLength);
+
+        // Initialize the coefficients
+        // to represent a linear spring
+        // (a constant force when the
+        // degree is zero)
+
+        m_coeffs.fill(0);
+        m_coeffs[polynomialDegree > 0 ? 1 : 0] = 1;
+    }
+
+    // Copy constructor
+
+    blPolySpringN(const blPolySpringN<blDataType,polynomialDegree>& spring1)
+                  : blConnection<blDataType>(spring1)
+    {
+        // Copy the spring's
+        // natural length
+
+        setNaturalLength(spring1.getNaturalLength());
+
+        // Copy the coefficients
+
+        setCoeffs(spring1.getCoeffs());
+    }
+
+    // Move constructor
+
+    blPolySpringN(blPolySpringN<blDataType,polynomialDegree>&& spring1) = default;
+
+    // Copy and move
+    // assignments
+
+    blPolySpringN<blDataType,polynomialDegree>&     operator=(const blPolySpringN<blDataType,polynomialDegree>& spring1) = default;
+    blPolySpringN<blDataType,polynomialDegree>&     operator=(blPolySpringN<blDataType,polynomialDegree>&& spring1) = default;
+
+    // Destructor
+
+    ~blPolySpringN()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to set/get
+    // the spring's natural length
+
+    void                                            setNaturalLength(const blDataType& naturalLength);
+    const blDataType&                               getNaturalLength()const;
+
+    // Functions used to set the
+    // array of coefficients
+
+    template<int numOfCoeffs>
+    void                                            setCoeffs(const blDataType(&coeffs)[numOfCoeffs]);
+    void                                            setCoeffs(const blCoeffsType& coeffs);
+
+    // Function used to get the
+    // array of coefficients
+
+    const blCoeffsType&                             getCoeffs()const;
+
+    // Function used to get
+    // the force magnitude for
+    // an elongation
+
+    blDataType                                      getForce(const blDataType& elongation)const;
+
+    // Function that calculates and
+    // stores the forces/torques
+    // to apply to the rigid bodies
+
+    virtual void                                    calculateForcesAndTorques();
+
+    // Function used to know
+    // whether this connection
+    // has broken or not
+
+    virtual bool                                    hasConnectionBeenBroken()const;
+
+    // Function used by implicit
+    // integration to get the
+    // spring's stiffness, the
+    // spring has no velocity
+    // dependence
+
+    virtual bool                                    calculateForceJacobians(blDataType (&positionJacobian)[3][3],
+                                                                            blDataType (&velocityJacobian)[3][3]);
+
+protected: // Protected variables
+
+    // The spring's natural length
+
+    blDataType                                      m_naturalLength;
+
+    // The array of coefficients
+
+    blCoeffsType                                    m_coeffs;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int polynomialDegree>
+inline void blPolySpringN<blDataType,polynomialDegree>::setNaturalLength(const blDataType& naturalLength)
+{
+    m_naturalLength = naturalLength;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int polynomialDegree>
+inline const blDataType& blPolySpringN<blDataType,polynomialDegree>::getNaturalLength()const
+{
+    return m_naturalLength;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int polynomialDegree>
+template<int numOfCoeffs>
+inline void blPolySpringN<blDataType,polynomialDegree>::setCoeffs(const blDataType(&coeffs)[numOfCoeffs])
+{
+    static_assert(numOfCoeffs <= polynomialDegree + 1,"blPolySpringN: too many coefficients for the spring's degree");
+
+    m_coeffs.fill(0);
+    std::copy(coeffs,coeffs + numOfCoeffs,m_coeffs.begin());
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int polynomialDegree>
+inline void blPolySpringN<blDataType,polynomialDegree>::setCoeffs(const blCoeffsType& coeffs)
+{
+    m_coeffs = coeffs;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int polynomialDegree>
+inline const typename blPolySpringN<blDataType,polynomialDegree>::blCoeffsType& blPolySpringN<blDataType,polynomialDegree>::getCoeffs()const
+{
+    return m_coeffs;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int polynomialDegree>
+inline blDataType blPolySpringN<blDataType,polynomialDegree>::getForce(const blDataType& elongation)const
+{
+    return blPolynomialEvaluator<blDataType,polynomialDegree>::evaluate(m_coeffs,elongation);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int polynomialDegree>
+inline void blPolySpringN<blDataType,polynomialDegree>::calculateForcesAndTorques()
+{
+    // Step 1:  Check that we have valid
+    //          rigid bodies
+
+    blRigidBody<blDataType>* rigidBody1 = this->getRigidBody1();
+    blRigidBody<blDataType>* rigidBody2 = this->getRigidBody2();
+
+    if(!rigidBody1 || !rigidBody2)
+    {
+        // Error -- Not all rigid bodies
+        //          are attached to this
+        //          spring
+
+        this->clearStoredForcesAndTorques();
+
+        return;
+    }
+
+    // Step 2:  Transform the connection
+    //          positions from body
+    //          coordinates to system
+    //          coordinates
+
+    blMathAPI::blVector3d<blDataType> Pos1 = this->m_rigidBody1ConnectionPosition;
+    blMathAPI::blVector3d<blDataType> Pos2 = this->m_rigidBody2ConnectionPosition;
+
+    rigidBody1->fromBodyToSystemCoordinates(Pos1);
+    rigidBody2->fromBodyToSystemCoordinates(Pos2);
+
+    // Step 3:  calculate the spring's
+    //          distance vector and
+    //          elongation
+
+    blMathAPI::blVector3d<blDataType> distanceVector = Pos2 - Pos1;
+
+    blDataType elongation = distanceVector.getMagnitude() - m_naturalLength;
+
+    distanceVector.normalize();
+
+    // Step 4:  calculate the
+    //          force magnitude
+
+    blDataType force = getForce(elongation);
+
+    // Step 5:  Store the force, it gets
+    //          applied both as a force
+    //          and torque to the rigid
+    //          bodies by applyForcesAndTorques
+
+    this->storeForcesAndTorques(force*distanceVector,Pos1,
+                                -force*distanceVector,Pos2);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int polynomialDegree>
+inline bool blPolySpringN<blDataType,polynomialDegree>::hasConnectionBeenBroken()const
+{
+    // As a default we make
+    // this connection unbreakable
+
+    return false;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int polynomialDegree>
+inline bool blPolySpringN<blDataType,polynomialDegree>::calculateForceJacobians(blDataType (&positionJacobian)[3][3],
+                                                                                blDataType (&velocityJacobian)[3][3])
+{
+    return this->calculatePolySpringJacobians(m_coeffs.data(),
+                                              m_coeffs.size(),
+                                              m_naturalLength,
+                                              positionJacobian,
+                                              velocityJacobian);
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_POLYSPRINGN_HPP
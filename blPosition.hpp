@@ -70,6 +70,16 @@ public: // Constructors and destructors
     template<typename blDataType2>
     blPosition(const blPosition<blDataType2>& position);
 
+    // Copy and move
+    // constructors
+    blPosition(const blPosition<blDataType>& position) = default;
+    blPosition(blPosition<blDataType>&& position) = default;
+
+    // Copy and move
+    // assignments
+    blPosition<blDataType>&                         operator=(const blPosition<blDataType>& position) = default;
+    blPosition<blDataType>&                         operator=(blPosition<blDataType>&& position) = default;
+
     // Destructor
     ~blPosition()
     {
@@ -0,0 +1,317 @@
+#ifndef BL_QUATERNIONARRAY_HPP
+#define BL_QUATERNIONARRAY_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blQuaternionArray.hpp
+// CLASS:           blQuaternionArray
+// BASE CLASS:      None
+//
+// PURPOSE:         A structure-of-arrays container of quaternions,
+//                  where the w, x, y and z components of all the
+//                  quaternions are stored in four separate
+//                  contiguous arrays
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    blMathAPI::blQuaternion -- From the blMathAPI used to
+//                                             get/set single quaternions
+//                  std::vector -- Used to store each component
+//
+// NOTES:
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blQuaternionArray
+{
+public: // Public typedefs
+
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+    typedef blMathAPI::blQuaternion<blDataType>         blQuaternionType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blQuaternionArray(const std::size_t& numberOfQuaternions = 0);
+
+    // Destructor
+
+    ~blQuaternionArray()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // get/change the
+    // number of quaternions
+
+    std::size_t                                         size()const;
+    void                                                resize(const std::size_t& numberOfQuaternions);
+    void                                                reserve(const std::size_t& numberOfQuaternions);
+    void                                                clear();
+
+    // Functions used to
+    // add/remove quaternions
+    // at the end of the
+    // arrays
+
+    void                                                push_back(const blQuaternionType& quaternion);
+    void                                                pop_back();
+
+    // Functions used to
+    // get/set a single
+    // quaternion
+
+    blQuaternionType                                    getQuaternion(const std::size_t& index)const;
+    void                                                setQuaternion(const std::size_t& index,
+                                                                      const blQuaternionType& quaternion);
+
+    // Function used to
+    // copy one quaternion
+    // onto another one
+
+    void                                                copyQuaternion(const std::size_t& fromIndex,
+                                                                       const std::size_t& toIndex);
+
+    // Functions used to
+    // get the component
+    // arrays
+
+    std::vector<blDataType>&                            w();
+    std::vector<blDataType>&                            x();
+    std::vector<blDataType>&                            y();
+    std::vector<blDataType>&                            z();
+
+    const std::vector<blDataType>&                      w()const;
+    const std::vector<blDataType>&                      x()const;
+    const std::vector<blDataType>&                      y()const;
+    const std::vector<blDataType>&                      z()const;
+
+private: // Private variables
+
+    // The component
+    // arrays
+
+    std::vector<blDataType>                             m_w;
+    std::vector<blDataType>                             m_x;
+    std::vector<blDataType>                             m_y;
+    std::vector<blDataType>                             m_z;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blQuaternionArray<blDataType>::blQuaternionArray(const std::size_t& numberOfQuaternions)
+{
+    resize(numberOfQuaternions);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blQuaternionArray<blDataType>::size()const
+{
+    return m_w.size();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blQuaternionArray<blDataType>::resize(const std::size_t& numberOfQuaternions)
+{
+    // New quaternions
+    // start out as the
+    // identity rotation
+
+    m_w.resize(numberOfQuaternions,1);
+    m_x.resize(numberOfQuaternions,0);
+    m_y.resize(numberOfQuaternions,0);
+    m_z.resize(numberOfQuaternions,0);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blQuaternionArray<blDataType>::reserve(const std::size_t& numberOfQuaternions)
+{
+    m_w.reserve(numberOfQuaternions);
+    m_x.reserve(numberOfQuaternions);
+    m_y.reserve(numberOfQuaternions);
+    m_z.reserve(numberOfQuaternions);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blQuaternionArray<blDataType>::clear()
+{
+    m_w.clear();
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blQuaternionArray<blDataType>::push_back(const blQuaternionType& quaternion)
+{
+    m_w.push_back(quaternion.w());
+    m_x.push_back(quaternion.m_xyz.x());
+    m_y.push_back(quaternion.m_xyz.y());
+    m_z.push_back(quaternion.m_xyz.z());
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blQuaternionArray<blDataType>::pop_back()
+{
+    m_w.pop_back();
+    m_x.pop_back();
+    m_y.pop_back();
+    m_z.pop_back();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blQuaternionArray<blDataType>::blQuaternionType blQuaternionArray<blDataType>::getQuaternion(const std::size_t& index)const
+{
+    return blQuaternionType(m_w[index],
+                            blVectorType(m_x[index],m_y[index],m_z[index]));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blQuaternionArray<blDataType>::setQuaternion(const std::size_t& index,
+                                                         const blQuaternionType& quaternion)
+{
+    m_w[index] = quaternion.w();
+    m_x[index] = quaternion.m_xyz.x();
+    m_y[index] = quaternion.m_xyz.y();
+    m_z[index] = quaternion.m_xyz.z();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blQuaternionArray<blDataType>::copyQuaternion(const std::size_t& fromIndex,
+                                                          const std::size_t& toIndex)
+{
+    m_w[toIndex] = m_w[fromIndex];
+    m_x[toIndex] = m_x[fromIndex];
+    m_y[toIndex] = m_y[fromIndex];
+    m_z[toIndex] = m_z[fromIndex];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blQuaternionArray<blDataType>::w()
+{
+    return m_w;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blQuaternionArray<blDataType>::x()
+{
+    return m_x;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blQuaternionArray<blDataType>::y()
+{
+    return m_y;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blQuaternionArray<blDataType>::z()
+{
+    return m_z;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blQuaternionArray<blDataType>::w()const
+{
+    return m_w;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blQuaternionArray<blDataType>::x()const
+{
+    return m_x;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blQuaternionArray<blDataType>::y()const
+{
+    return m_y;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blQuaternionArray<blDataType>::z()const
+{
+    return m_z;
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_QUATERNIONARRAY_HPP
@@ -62,6 +62,14 @@ public: // Constructors and destructors
     // Copy constructor
     blRestitution(const blRestitution<blDataType>& restitution);
 
+    // Move constructor
+    blRestitution(blRestitution<blDataType>&& restitution) = default;
+
+    // Copy and move
+    // assignments
+    blRestitution<blDataType>&                              operator=(const blRestitution<blDataType>& restitution) = default;
+    blRestitution<blDataType>&                              operator=(blRestitution<blDataType>&& restitution) = default;
+
     // Destructor
     ~blRestitution()
     {
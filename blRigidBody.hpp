@@ -14,10 +14,11 @@
 //                  - blInertia
 //                  - blDamping
 //                  - blRestitution
+//                  - blSleeping
 //
 // PURPOSE:         Based on classes blIDSystem,blPosition,blVelocity,
 //                  blOrientation,blAngularVelocity and blInertia,
-//                  blDamping, blRestitution, it combines all these
+//                  blDamping, blRestitution, blSleeping, it combines all these
 //                  properties into an object to represent a rigid
 //                  body and its dynamics
 //
@@ -30,7 +31,7 @@
 //
 // DEPENDENCIES:
 //
-// NOTES:
+// NOTES:           - Adding a force or torque wakes the body up
 //
 // DATE CREATED:    Nov/08/2010
 // DATE UPDATED:
@@ -50,7 +51,8 @@
     // Enum used for choosing integration methods
     enum {BL_EULER = 0,
           BL_RK4 = 1,
-          BL_VERLET = 2};
+          BL_VERLET = 2,
+          BL_IMPLICIT_EULER = 3};
 
 //-------------------------------------------------------------------
 
@@ -64,7 +66,8 @@ class blRigidBody : public blPosition<blDataType>,
                     public blSize<blDataType>,
                     public blInertia<blDataType>,
                     public blDamping<blDataType>,
-                    public blRestitution<blDataType>
+                    public blRestitution<blDataType>,
+                    public blSleeping<blDataType>
 {
 protected: // Protected typedefs
 
@@ -82,6 +85,16 @@ public: // Constructors and destructors
 
     blRigidBody(const blRigidBody<blDataType>& rigidBody);
 
+    // Move constructor
+
+    blRigidBody(blRigidBody<blDataType>&& rigidBody) = default;
+
+    // Copy and move
+    // assignments
+
+    blRigidBody<blDataType>&                            operator=(const blRigidBody<blDataType>& rigidBody) = default;
+    blRigidBody<blDataType>&                            operator=(blRigidBody<blDataType>&& rigidBody) = default;
+
     // Destructor
 
     ~blRigidBody()
@@ -109,6 +122,15 @@ public: // Public functions
     void                                                addForceAndTorque(const blVectorType& force,
                                                                           const blVectorType& forcePosition);
 
+    // Functions used to
+    // get the forces/torques
+    // added so far and to
+    // clear them
+
+    const blVectorType&                                 getTotalForce()const;
+    const blVectorType&                                 getTotalTorque()const;
+    void                                                clearForcesAndTorques();
+
     // Function used to
     // simulate this
     // rigid body
@@ -135,6 +157,22 @@ public: // Public functions
 
     void                                                fromBodyToSystemCoordinates(blVectorType& vectorToTransform);
 
+    // Functions used to
+    // bring the cached
+    // inverse inertia in
+    // system coordinates up
+    // to date with the body's
+    // orientation and to
+    // multiply vectors by
+    // the inertia and its
+    // inverse in system
+    // coordinates, R*I*R^T*v
+    // and R*I^-1*R^T*v
+
+    void                                                updateWorldInertia()const;
+    blVectorType                                        applyWorldInertia(const blVectorType& vector)const;
+    blVectorType                                        applyWorldInertiaInverse(const blVectorType& vector)const;
+
 protected: // Protected functions
 
     // Eurler integration
@@ -144,6 +182,18 @@ protected: // Protected functions
                                                                                     const sf::Time& totalTime,
                                                                                     const blVectorType& accelerationField);
 
+    // Semi-implicit (leapfrog)
+    // Verlet method, velocities
+    // are updated first and the
+    // new velocities move the
+    // body, which keeps the energy
+    // of oscillating systems
+    // bounded over long runs
+
+    virtual void                                        calculateNewStateUsingVerlet(const sf::Time& timeStep,
+                                                                                     const sf::Time& totalTime,
+                                                                                     const blVectorType& accelerationField);
+
     // Runga-Kutta 4th
     // order method
 
@@ -172,8 +222,10 @@ inline blRigidBody<blDataType>::blRigidBody() : blPosition<blDataType>(),
                                                 blAngularVelocity<blDataType>(),
                                                 blInertia<blDataType>(),
                                                 blDamping<blDataType>(),
-                                                blRestitution<blDataType>()
+                                                blRestitution<blDataType>(),
+                                                blSleeping<blDataType>()
 {
+    clearForcesAndTorques();
 }
 //-------------------------------------------------------------------
 
@@ -188,8 +240,10 @@ inline blRigidBody<blDataType>::blRigidBody(const blRigidBody& rigidBody)
                                               blSize<blDataType>(rigidBody),
                                               blInertia<blDataType>(rigidBody),
                                               blDamping<blDataType>(rigidBody),
-                                              blRestitution<blDataType>(rigidBody)
+                                              blRestitution<blDataType>(rigidBody),
+                                              blSleeping<blDataType>(rigidBody)
 {
+    clearForcesAndTorques();
 }
 //-------------------------------------------------------------------
 
@@ -199,6 +253,8 @@ template<typename blDataType>
 inline void blRigidBody<blDataType>::addForce(const blVectorType& force)
 {
     m_totalForce += force;
+
+    this->setIsAwake(true);
 }
 //-------------------------------------------------------------------
 
@@ -208,6 +264,8 @@ template<typename blDataType>
 inline void blRigidBody<blDataType>::addTorque(const blVectorType& torque)
 {
     m_totalTorque += torque;
+
+    this->setIsAwake(true);
 }
 //-------------------------------------------------------------------
 
@@ -219,6 +277,41 @@ inline void blRigidBody<blDataType>::addForceAndTorque(const blVectorType& force
 {
     m_totalForce += force;
     m_totalTorque += crossProduct((forcePosition - this->getPosition()),force);
+
+    this->setIsAwake(true);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const typename blRigidBody<blDataType>::blVectorType& blRigidBody<blDataType>::getTotalForce()const
+{
+    return m_totalForce;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const typename blRigidBody<blDataType>::blVectorType& blRigidBody<blDataType>::getTotalTorque()const
+{
+    return m_totalTorque;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBody<blDataType>::clearForcesAndTorques()
+{
+    m_totalForce.x() = 0;
+    m_totalForce.y() = 0;
+    m_totalForce.z() = 0;
+
+    m_totalTorque.x() = 0;
+    m_totalTorque.y() = 0;
+    m_totalTorque.z() = 0;
 }
 //-------------------------------------------------------------------
 
@@ -256,6 +349,18 @@ inline void blRigidBody<blDataType>::simulateRigidBody(const sf::Time& timeStep,
         calculateNewStateUsingRK4(timeStep,totalTime,accelerationField);
         break;
 
+    case BL_VERLET:
+        calculateNewStateUsingVerlet(timeStep,totalTime,accelerationField);
+        break;
+
+    case BL_IMPLICIT_EULER:
+        // A body on its own has
+        // no connections to solve
+        // implicitly, so it takes
+        // the kick-drift step
+        calculateNewStateUsingVerlet(timeStep,totalTime,accelerationField);
+        break;
+
     default:
         calculateNewStateUsingEuler(timeStep,totalTime,accelerationField);
         break;
@@ -269,20 +374,10 @@ inline void blRigidBody<blDataType>::simulateRigidBody(const sf::Time& timeStep,
     resolveAngularMotionLimits();
 
     // Reset the total
-    // force acting on
-    // rigid body
-
-    m_totalForce.x() = 0;
-    m_totalForce.y() = 0;
-    m_totalForce.z() = 0;
-
-    // Reset the total
-    // torque acting on
-    // rigid body
+    // force and torque
+    // acting on rigid body
 
-    m_totalTorque.x() = 0;
-    m_totalTorque.y() = 0;
-    m_totalTorque.z() = 0;
+    clearForcesAndTorques();
 }
 //-------------------------------------------------------------------
 
@@ -290,39 +385,24 @@ inline void blRigidBody<blDataType>::simulateRigidBody(const sf::Time& timeStep,
 //-------------------------------------------------------------------
 template<typename blDataType>
 inline void blRigidBody<blDataType>::calculateNewStateUsingEuler(const sf::Time& timeStep,
-                                                                 const sf::Time& totalTime,
+                                                                 const sf::Time& /*totalTime*/,
                                                                  const blVectorType& accelerationField)
 {
-    // Step 1:  Integrate the
-    //          position
-
-    this->translate(this->getVelocity() * timeStep.asSeconds());
-
-    // Step 2:  Integrate the
-    //          velocity
-
-    this->changeVelocity((m_totalForce/this->getMass() + accelerationField) * timeStep.asSeconds());
-
-    // Step 3:  Integrate the
-    //          angular position
-
-        // Form a quaternion
-        // out of the angular
-        // velocity
-
-        blDataType theta = blMathAPI::norm2(this->getAngularVelocity()) * timeStep.asSeconds();
-
-        blQuaternionType angVelQtn(std::cos(theta/2.0),
-                                   this->getAngularVelocity() * std::sin(theta/2.0));
+    blEulerIntegrator::integrateState(*this,timeStep,accelerationField);
+}
+//-------------------------------------------------------------------
 
-        this->rotate(angVelQtn);
 
-    // Step 4:  Integrate the
-    //          angular velocity
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBody<blDataType>::calculateNewStateUsingVerlet(const sf::Time& timeStep,
+                                                                  const sf::Time& /*totalTime*/,
+                                                                  const blVectorType& accelerationField)
+{
+    // The leapfrog (kick-drift)
+    // form of velocity Verlet
 
-    this->changeAngularVelocity(this->getInertiaInverse() *
-                                (m_totalTorque - crossProduct(this->getAngularVelocity(),this->getInertia() * this->getAngularVelocity())) *
-                                timeStep.asSeconds());
+    blSemiImplicitEulerIntegrator::integrateState(*this,timeStep,accelerationField);
 }
 //-------------------------------------------------------------------
 
@@ -330,7 +410,7 @@ inline void blRigidBody<blDataType>::calculateNewStateUsingEuler(const sf::Time&
 //-------------------------------------------------------------------
 template<typename blDataType>
 inline void blRigidBody<blDataType>::calculateNewStateUsingRK4(const sf::Time& timeStep,
-                                                               const sf::Time& totalTime,
+                                                               const sf::Time& /*totalTime*/,
                                                                const blVectorType& accelerationField)
 {
     // calculate the
@@ -400,19 +480,18 @@ inline void blRigidBody<blDataType>::fromBodyToSystemCoordinates(blVectorType& v
     //          rigid body by
     //          scaling the vector
 
-    vectorToTransform.x() *= this->m_Size.x();
-    vectorToTransform.y() *= this->m_Size.y();
-    vectorToTransform.z() *= this->m_Size.z();
+    vectorToTransform.x() *= this->getSize().x();
+    vectorToTransform.y() *= this->getSize().y();
+    vectorToTransform.z() *= this->getSize().z();
 
     // Step 2:  Account for the
     //          rotation of this
     //          rigid body by
     //          rotating the vector
 
-    vectorToTransform = vectorToTransform.getMagnitude() *
-                        (this->m_RotQtn *
+    vectorToTransform = (this->getRotQtn() *
                          blQuaternionType(0,vectorToTransform) *
-                         this->m_RotQtn.getConjugate()).m_xyz;
+                         this->getRotQtn().getConjugate()).m_xyz;
 
     // Step 3:  Account for the
     //          position of this
@@ -425,6 +504,56 @@ inline void blRigidBody<blDataType>::fromBodyToSystemCoordinates(blVectorType& v
 //-------------------------------------------------------------------
 
 
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBody<blDataType>::updateWorldInertia()const
+{
+    // Only calculated again
+    // when the body has
+    // rotated or its inertia
+    // has changed
+
+    blInertia<blDataType>::updateWorldInertia(this->getxAxis(),
+                                              this->getyAxis(),
+                                              this->getzAxis(),
+                                              this->getOrientationVersion());
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBody<blDataType>::blVectorType blRigidBody<blDataType>::applyWorldInertia(const blVectorType& vector)const
+{
+    // Bring the vector into
+    // body coordinates, apply
+    // the inertia there and
+    // bring it back
+
+    const blVectorType& xAxis = this->getxAxis();
+    const blVectorType& yAxis = this->getyAxis();
+    const blVectorType& zAxis = this->getzAxis();
+
+    blVectorType bodyVector = this->applyInertia(blVectorType(xAxis * vector,
+                                                              yAxis * vector,
+                                                              zAxis * vector));
+
+    return xAxis * bodyVector.x() + yAxis * bodyVector.y() + zAxis * bodyVector.z();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBody<blDataType>::blVectorType blRigidBody<blDataType>::applyWorldInertiaInverse(const blVectorType& vector)const
+{
+    updateWorldInertia();
+
+    return this->applyCachedWorldInertiaInverse(vector);
+}
+//-------------------------------------------------------------------
+
+
 //-------------------------------------------------------------------
 template<typename blDataType>
 inline void blRigidBody<blDataType>::resolveMotionLimits()
@@ -28,6 +28,39 @@
 //-------------------------------------------------------------------
 // Includes and libs needed for this file
 //-------------------------------------------------------------------
+
+#include <vector>
+#include <array>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <utility>
+#include <deque>
+#include <cstdint>
+#include <cassert>
+#include <cstddef>
+
+// SIMD instruction sets used by
+// the batch integration kernels,
+// define BL_RIGIDBODYAPI_DISABLE_SIMD
+// to force the scalar code path
+
+#if !defined(BL_RIGIDBODYAPI_DISABLE_SIMD)
+    #if defined(__AVX2__)
+        #define BL_RIGIDBODYAPI_USE_AVX2
+        #include <immintrin.h>
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define BL_RIGIDBODYAPI_USE_SSE2
+        #include <emmintrin.h>
+    #endif
+#endif
+
 //-------------------------------------------------------------------
 
 
@@ -101,6 +134,65 @@ namespace blRigidBodyAPI
 
 
 
+    // A base class to let an object at
+    // rest fall asleep until something
+    // wakes it up
+
+    #include "blSleeping.hpp"
+
+
+
+    // Structure-of-arrays containers of
+    // vectors, quaternions and matrices
+    // used for batched body storage
+
+    #include "blVector3dArray.hpp"
+    #include "blQuaternionArray.hpp"
+    #include "blMatrix3dArray.hpp"
+
+
+
+    // SIMD register wrappers and the
+    // batch integration kernels built
+    // on top of them
+
+    #include "blSimdPack.hpp"
+    #include "blBatchIntegrator.hpp"
+
+
+
+    // Executors used to run loops over
+    // ranges of items, either serially,
+    // on a pool of worker threads or on
+    // workers stealing each other's work
+
+    #include "blExecutor.hpp"
+    #include "blThreadPool.hpp"
+    #include "blWorkStealingScheduler.hpp"
+
+
+
+
+    // A fixed-block memory pool and the allocator
+    // used to create bodies and connections
+    // without the global new/delete
+
+    #include "blMemoryPool.hpp"
+
+
+
+    // Integrator policies used to pick the
+    // integration method at compile time,
+    // and the adapter that keeps picking
+    // it at run time
+
+    #include "blIntegratorPolicy.hpp"
+    #include "blEulerIntegrator.hpp"
+    #include "blSemiImplicitEulerIntegrator.hpp"
+    #include "blRuntimeIntegrator.hpp"
+
+
+
     // Based on classes blIDSystem,blPosition,blVelocity,
     // blOrientation,blAngularVelocity and blInertia,
     // blDamping, blRestitution, it combines all these
@@ -111,6 +203,14 @@ namespace blRigidBodyAPI
 
 
 
+    // A table of slots handing out generational
+    // handles to the bodies of a system, used by
+    // the connections to refer to their bodies
+
+    #include "blRigidBodyTable.hpp"
+
+
+
     // Based on blIDSystem, it forms a base class
     // used to connect rigid bodies using springs,
     // dampers, kinematic constraints and more
@@ -129,11 +229,101 @@ namespace blRigidBodyAPI
 
 
 
+    // Based on blConnection, a polynomial
+    // spring whose degree is fixed at compile
+    // time, with its coefficients kept in a
+    // std::array and its force evaluated by
+    // an unrolled Horner's method
+
+    #include "blPolySpringN.hpp"
+
+
+
+    // Axis aligned bounding boxes used
+    // by the broadphase
+
+    #include "blAABB.hpp"
+
+
+
+    // Broadphase collision detection, an
+    // incremental sweep-and-prune for coherent
+    // scenes, a spatial hash grid for
+    // uniform crowds of bodies and a dynamic
+    // AABB tree for queries and ray casts
+
+    #include "blSweepAndPrune.hpp"
+    #include "blSpatialHashGrid.hpp"
+    #include "blDynamicAABBTree.hpp"
+
+
+
+    // Narrowphase collision detection, oriented
+    // box contacts found with the separating
+    // axis test
+
+    #include "blContactManifold.hpp"
+    #include "blBoxBoxNarrowphase.hpp"
+
+
+
+    // Islands of linked bodies, put to
+    // sleep when they come to rest
+
+    #include "blIslandManager.hpp"
+
+
+
+    // Ball joints, and the sequential impulse
+    // solver that keeps contacts and joints
+    // together, warm started from the last
+    // step's impulses
+
+    #include "blBallJoint.hpp"
+    #include "blConstraintSolver.hpp"
+
+
+
+    // Sparse 3x3 block matrices and the
+    // preconditioned conjugate gradient solver
+    // used by the implicit Euler method
+
+    #include "blSparseBlockMatrix.hpp"
+    #include "blConjugateGradientSolver.hpp"
+
+
+
     // Based on blRigidBody, it adds a set of rigid
     // bodies used to simulate a system of rigid
     // bodies
 
     #include "blRigidBodySystem.hpp"
+
+
+
+    // A structure-of-arrays storage for
+    // large numbers of rigid bodies, with
+    // an integration loop over its arrays
+
+    #include "blRigidBodyWorld.hpp"
+
+
+
+    // A structure-of-arrays network of
+    // polynomial springs between the
+    // bodies of a blRigidBodyWorld,
+    // evaluated in batches
+
+    #include "blSpringNetwork.hpp"
+
+
+
+    // A set of spatially varying
+    // acceleration fields acting on
+    // the bodies of a blRigidBodyWorld,
+    // evaluated in one batched pass
+
+    #include "blForceFieldSet.hpp"
 }
 //-------------------------------------------------------------------
 
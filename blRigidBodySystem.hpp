@@ -20,8 +20,127 @@
 //
 // DEPENDENCIES:    - std::set
 //                  - blRigidBody and all its dependencies
+//                  - blExecutor -- Used to run the simulation
+//                                  step in parallel
+//                  - blConstraintSolver -- Used to resolve contacts
+//                                          and joints
+//                  - blIslandManager -- Used to put resting bodies
+//                                       to sleep
+//                  - blMemoryPool -- Used to create children bodies
+//                                    and connections
+//                  - blSparseBlockMatrix and blConjugateGradientSolver --
+//                                       Used by the implicit Euler
+//                                       method
+//                  - blRigidBodyTable -- Used to resolve the connections'
+//                                        body handles
 //
-// NOTES:
+// NOTES:           - When an executor with more than one thread
+//                    is set, the connections are calculated in
+//                    parallel and their forces are then applied in
+//                    the order the connections are stored, and the
+//                    children systems are simulated in parallel
+//                  - The parallel step gives the same results as
+//                    the serial one bit for bit, a system's connections
+//                    can only reach the bodies of its own table (see
+//                    below), so the connections of a child never touch
+//                    bodies outside that child's sub-tree
+//                  - Connections refer to their bodies by handles into
+//                    the table of the system that owns them, the table
+//                    holds the system itself, its children and its
+//                    static and kinematic bodies, getRigidBodyHandle
+//                    gives the handle of one of them, the table is kept
+//                    in step with the managers at each step and a body
+//                    taken out of the managers leaves its handles stale,
+//                    which debug builds assert on when a connection
+//                    still uses them
+//                  - A body is meant to be held by one system, its
+//                    handle in that system's table is kept in the body
+//                    itself, so a body held by two systems keeps taking
+//                    new slots and the handles to it keep going stale
+//                  - simulate() advances the system in fixed time
+//                    steps, the elapsed wall-clock time is collected
+//                    in an accumulator and at most a maximum number
+//                    of sub-steps is taken per frame, any time left
+//                    over past that is dropped so a slow frame can't
+//                    snowball into slower and slower frames
+//                  - The integrator policy (second template parameter)
+//                    picks how each body is integrated, the default
+//                    blRuntimeIntegrator uses the integration method
+//                    set at run time, while compile-time policies such
+//                    as blEulerIntegrator or blSemiImplicitEulerIntegrator
+//                    inline the whole step and ignore that setting
+//                  - With BL_RK4 the system integrates itself and all
+//                    its simulated children as one set of equations,
+//                    the connection forces and damping are evaluated
+//                    again at each of the four stages and orientation
+//                    and angular velocity are integrated along with
+//                    position and velocity, the children's own
+//                    integration methods are ignored in that case,
+//                    forces added before the step act at every stage
+//                    and bodies without mass are not moved
+//                  - With BL_IMPLICIT_EULER the system also integrates
+//                    its whole tree at once, the velocity changes of
+//                    all the bodies solve
+//
+//                    (M - dt*dF/dv - dt^2*dF/dx)*dv = dt*(F + dt*dF/dx*v)
+//
+//                    where the force derivatives come from the
+//                    connections that provide Jacobians (the springs),
+//                    the system is assembled into a blSparseBlockMatrix
+//                    and solved by blConjugateGradientSolver warm
+//                    started from the last step's velocity changes, so
+//                    stiff springs stay stable at large time steps
+//                  - The implicit Euler method only treats translation
+//                    implicitly, spring anchors are taken to move with
+//                    the body centers and torques and rotation are
+//                    integrated explicitly like the semi-implicit Euler
+//                    method, connections without Jacobians are applied
+//                    explicitly and bodies without mass are not moved
+//                  - When a constraint solver is set, after each step
+//                    it finds the contacts among the bodies of this
+//                    system's tree and corrects their velocities and
+//                    positions along with the tree's joints, with every
+//                    integration method the contacts are found where
+//                    the bodies started the step, and the bodies the
+//                    solver pushes move from there with their corrected
+//                    velocities
+//                  - When an island manager is set, after each step
+//                    the bodies of this system's tree are grouped into
+//                    islands by their connections, joints and contacts
+//                    and islands at rest are put to sleep, sleeping
+//                    bodies are not integrated until they wake up
+//                  - When memory pools are set, createRigidBody and
+//                    createConnection build the new objects and their
+//                    shared_ptr control blocks in blocks of the pools,
+//                    so spawning and despawning bodies and connections
+//                    reuses the pools' blocks instead of going through
+//                    the global new/delete, children created this way
+//                    share their parent's pools
+//                  - Static and kinematic bodies are kept in their
+//                    own managers, apart from the dynamic children,
+//                    so the dynamic loops never see them, static
+//                    bodies are never moved and kinematic bodies are
+//                    moved by their own velocities, without forces,
+//                    damping or limits, both are created without mass
+//                    so the constraint solver and the island manager
+//                    treat them as immovable, and their own children
+//                    are not simulated
+//                  - A force field set acts on the awake bodies of the
+//                    tree of the system it is set on, the fields are
+//                    sampled at all the bodies in one batched pass and
+//                    mass*acceleration is added to their forces next to
+//                    the additional field, at each RK4 stage and in the
+//                    implicit Euler right hand side too, bodies without
+//                    mass get no force
+//                  - Moving a system, or passing a manager to its
+//                    setter as an rvalue, hands the managers' vectors
+//                    over as they are, systems can't be copied since
+//                    a copy would share the children, connections and
+//                    joints with the original
+//                  - The position/orientation before the last step
+//                    is kept so that render state can be interpolated
+//                    between the last two steps using
+//                    getInterpolationAlpha()
 //
 // DATE CREATED:    May/16/2011
 // DATE UPDATED:
@@ -31,6 +150,10 @@
 //-------------------------------------------------------------------
 // Includes and libs needed for this file
 //-------------------------------------------------------------------
+
+template<typename blDataType>
+class blForceFieldSet;
+
 //-------------------------------------------------------------------
 
 
@@ -41,15 +164,21 @@
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
+template<typename blDataType,typename blIntegratorPolicy = blRuntimeIntegrator>
 class blRigidBodySystem : public blRigidBody<blDataType>
 {
 protected: // Protected typedefs
 
     typedef typename blRigidBody<blDataType>::blVectorType              blVectorType;
+    typedef typename blRigidBody<blDataType>::blQuaternionType          blQuaternionType;
+
+    typedef std::vector< std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> > >     blRigidBodyContainerType;
+    typedef std::vector< std::shared_ptr< blConnection<blDataType> > >          blConnectionContainerType;
+    typedef std::vector< std::shared_ptr< blBallJoint<blDataType> > >           blJointContainerType;
+
+public: // Public typedefs
 
-    typedef std::vector< blRigidBodySystem<blDataType> >                blRigidBodyContainerType;
-    typedef std::vector< blConnection<blDataType> >                     blConnectionContainerType;
+    typedef typename blRigidBodyTable<blDataType>::blBodyHandle         blBodyHandle;
 
 public: // Constructors and destructors
 
@@ -60,8 +189,18 @@ public: // Constructors and destructors
                       const int& integrationMethod = BL_EULER,
                       const sf::Time& startingSimulationTime = sf::seconds(0));
 
-    // Copy constructor
-    blRigidBodySystem(const blRigidBodySystem<blDataType>& rigidBodySystem);
+    // No copies, the children,
+    // connections and joints
+    // are shared objects that
+    // a copy would share too
+    blRigidBodySystem(const blRigidBodySystem<blDataType,blIntegratorPolicy>& rigidBodySystem) = delete;
+    blRigidBodySystem<blDataType,blIntegratorPolicy>&   operator=(const blRigidBodySystem<blDataType,blIntegratorPolicy>& rigidBodySystem) = delete;
+
+    // Move constructor and
+    // assignment, they take
+    // over the managers
+    blRigidBodySystem(blRigidBodySystem<blDataType,blIntegratorPolicy>&& rigidBodySystem);
+    blRigidBodySystem<blDataType,blIntegratorPolicy>&   operator=(blRigidBodySystem<blDataType,blIntegratorPolicy>&& rigidBodySystem);
 
     // Destructor
     ~blRigidBodySystem();
@@ -72,6 +211,7 @@ public: // Public functions
     // functions
 
     void                                                simulate();
+    void                                                simulateFrame(const sf::Time& frameTime);
 
     virtual void                                        simulateWithTime(const sf::Time& deltaTime,
                                                                          const sf::Time& totalTime);
@@ -82,6 +222,7 @@ public: // Public functions
     // bodies
 
     void                                                setRigidBodyManager(const blRigidBodyContainerType& rigidBodyManager);
+    void                                                setRigidBodyManager(blRigidBodyContainerType&& rigidBodyManager);
 
     blRigidBodyContainerType&                           getRigidBodyManager();
     const blRigidBodyContainerType&                     getRigidBodyManager()const;
@@ -92,9 +233,94 @@ public: // Public functions
     // body connections
 
     void                                                setConnectionsManager(const blConnectionContainerType& connectionsManager);
+    void                                                setConnectionsManager(blConnectionContainerType&& connectionsManager);
     blConnectionContainerType&                          getConnectionsManager();
     const blConnectionContainerType&                    getConnectionsManager()const;
 
+    // Functions used to
+    // set/get the managers
+    // holding the joints
+    // solved by the
+    // constraint solver
+
+    void                                                setJointsManager(const blJointContainerType& jointsManager);
+    void                                                setJointsManager(blJointContainerType&& jointsManager);
+    blJointContainerType&                               getJointsManager();
+    const blJointContainerType&                         getJointsManager()const;
+
+    // Functions used to
+    // set/get the managers
+    // holding the static
+    // bodies (never moved)
+    // and the kinematic ones
+    // (moved by their own
+    // velocities only)
+
+    void                                                setStaticBodyManager(const blRigidBodyContainerType& staticBodyManager);
+    void                                                setStaticBodyManager(blRigidBodyContainerType&& staticBodyManager);
+    blRigidBodyContainerType&                           getStaticBodyManager();
+    const blRigidBodyContainerType&                     getStaticBodyManager()const;
+
+    void                                                setKinematicBodyManager(const blRigidBodyContainerType& kinematicBodyManager);
+    void                                                setKinematicBodyManager(blRigidBodyContainerType&& kinematicBodyManager);
+    blRigidBodyContainerType&                           getKinematicBodyManager();
+    const blRigidBodyContainerType&                     getKinematicBodyManager()const;
+
+    // Functions used to
+    // set/get the memory
+    // pools the children
+    // bodies and connections
+    // are created from (a
+    // null pool means they
+    // are created with
+    // std::make_shared)
+
+    void                                                setBodyMemoryPool(const std::shared_ptr<blMemoryPool>& bodyMemoryPool);
+    const std::shared_ptr<blMemoryPool>&                getBodyMemoryPool()const;
+
+    void                                                setConnectionMemoryPool(const std::shared_ptr<blMemoryPool>& connectionMemoryPool);
+    const std::shared_ptr<blMemoryPool>&                getConnectionMemoryPool()const;
+
+    // Functions used to
+    // create a child body
+    // or a connection from
+    // the pools and add it
+    // to this system, the
+    // arguments are passed
+    // to the constructor
+
+    template<typename... blArgumentTypes>
+    std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> >    createRigidBody(blArgumentTypes&&... arguments);
+
+    template<typename blConnectionType,typename... blArgumentTypes>
+    std::shared_ptr<blConnectionType>                   createConnection(blArgumentTypes&&... arguments);
+
+    // Functions used to get
+    // the handle connections
+    // use to refer to this
+    // system or one of the
+    // bodies of its managers
+    // (the null handle for
+    // any other body), and
+    // the table the handles
+    // point into
+
+    blBodyHandle                                        getRigidBodyHandle(const blRigidBodySystem<blDataType,blIntegratorPolicy>* rigidBody);
+    const blRigidBodyTable<blDataType>&                 getRigidBodyTable()const;
+
+    // Functions used to
+    // create a static or a
+    // kinematic body from the
+    // pools and add it to its
+    // manager, the body is
+    // left without mass
+
+    template<typename... blArgumentTypes>
+    std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> >    createStaticBody(blArgumentTypes&&... arguments);
+
+    template<typename... blArgumentTypes>
+    std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> >    createKinematicBody(blArgumentTypes&&... arguments);
+
     // Functions used to
     // set/get the total
     // simulation time
@@ -124,6 +350,224 @@ public: // Public functions
     void                                                setAdditionalField(const blVectorType& additionalField);
     void                                                setIntegrationMethod(const int& integrationMethod);
 
+    // Functions used to
+    // set/get the executor
+    // used to run the
+    // simulation step in
+    // parallel (a null
+    // executor means the
+    // step runs serially)
+
+    void                                                setExecutor(const std::shared_ptr<blExecutor>& executor);
+    const std::shared_ptr<blExecutor>&                  getExecutor()const;
+
+    // Functions used to
+    // set/get the solver
+    // used to resolve the
+    // contacts and joints
+    // of this system's tree
+    // after each step (a
+    // null solver means no
+    // contacts and joints)
+
+    void                                                setConstraintSolver(const std::shared_ptr< blConstraintSolver<blDataType> >& constraintSolver);
+    const std::shared_ptr< blConstraintSolver<blDataType> >&    getConstraintSolver()const;
+
+    // Functions used to
+    // set/get the island
+    // manager used to put
+    // resting bodies of this
+    // system's tree to sleep
+    // (a null manager means
+    // bodies never sleep)
+
+    void                                                setIslandManager(const std::shared_ptr< blIslandManager<blDataType> >& islandManager);
+    const std::shared_ptr< blIslandManager<blDataType> >&       getIslandManager()const;
+
+    // Functions used to
+    // set/get the force
+    // fields acting on the
+    // bodies of this system's
+    // tree (a null set means
+    // no fields)
+
+    void                                                setForceFieldSet(const std::shared_ptr< blForceFieldSet<blDataType> >& forceFieldSet);
+    const std::shared_ptr< blForceFieldSet<blDataType> >&       getForceFieldSet()const;
+
+    // Functions used to get
+    // the linear solver used
+    // by the implicit Euler
+    // method, to tune it or
+    // to see how it went
+
+    blConjugateGradientSolver<blDataType>&              getImplicitSolver();
+    const blConjugateGradientSolver<blDataType>&        getImplicitSolver()const;
+
+    // Functions used to
+    // set/get the fixed
+    // time step and the
+    // maximum number of
+    // steps taken per frame
+
+    void                                                setFixedTimeStep(const sf::Time& fixedTimeStep);
+    const sf::Time&                                     getFixedTimeStep()const;
+
+    void                                                setMaxNumberOfSubSteps(const int& maxNumberOfSubSteps);
+    const int&                                          getMaxNumberOfSubSteps()const;
+
+    // Function used to
+    // get the time collected
+    // but not yet simulated
+
+    const sf::Time&                                     getTimeAccumulator()const;
+
+    // Function used to get
+    // how far (0 to 1) the
+    // current frame is between
+    // the last two steps
+
+    const blDataType&                                   getInterpolationAlpha()const;
+
+    // Functions used to get
+    // the render state between
+    // the last two steps, for
+    // children use the alpha
+    // of the root system
+
+    blVectorType                                        getInterpolatedPosition(const blDataType& alpha)const;
+    blQuaternionType                                    getInterpolatedRotQtn(const blDataType& alpha)const;
+
+    // Function used to store
+    // the current state of this
+    // system and all its children
+    // as the previous state
+
+    void                                                storePreviousState();
+
+    // Functions used to
+    // collect all the bodies
+    // in this system's tree
+    // (children first, depth
+    // first, not including
+    // this system) and their
+    // bounding boxes in the
+    // same order
+
+    void                                                gatherRigidBodies(std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>& rigidBodies);
+    void                                                calculateBoundingBoxes(std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>& rigidBodies,
+                                                                               std::vector< blAABB<blDataType> >& boundingBoxes);
+
+protected: // Protected functions
+
+    // Functions used to
+    // run the connections
+    // and the children
+    // either serially or
+    // with the executor
+
+    void                                                calculateAndApplyConnectionForces();
+    void                                                simulateChildren(const sf::Time& deltaTime,
+                                                                         const sf::Time& totalTime);
+
+    // Functions used to
+    // keep the body table in
+    // step with the managers
+    // and to point our
+    // connections and joints
+    // to it
+
+    void                                                updateRigidBodyTable();
+    void                                                addSelfToRigidBodyTable();
+    void                                                addToRigidBodyTable(blRigidBodySystem<blDataType,blIntegratorPolicy>* rigidBody);
+    void                                                takeOverRigidBodyTable(blRigidBodySystem<blDataType,blIntegratorPolicy>& rigidBodySystem);
+
+    // Function used to
+    // move the kinematic
+    // bodies by their
+    // velocities
+
+    void                                                moveKinematicBodies(const sf::Time& deltaTime);
+
+    // Function used to
+    // sample the force field
+    // set at the bodies of
+    // this system's tree and
+    // add their forces
+
+    void                                                applyForceFieldForces(const sf::Time& totalTime);
+
+    // Function used by the
+    // create functions to
+    // build a body from the
+    // body pool
+
+    template<typename... blArgumentTypes>
+    std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> >    allocateRigidBody(blArgumentTypes&&... arguments);
+
+    // Runge-Kutta 4th order
+    // method for the whole
+    // tree of bodies
+
+    void                                                simulateWithRK4(const sf::Time& deltaTime,
+                                                                        const sf::Time& totalTime);
+
+    // Functions used by the
+    // RK4 method to collect
+    // the bodies to integrate
+    // and the systems whose
+    // connections act on them
+
+    void                                                gatherSimulatedSystems(std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>& systems,
+                                                                               std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>& bodies);
+
+    // Function used by the
+    // RK4 method to evaluate
+    // the state derivatives
+    // of all the bodies at
+    // their current state
+
+    void                                                calculateStateDerivatives(const std::size_t& stage,
+                                                                                  const sf::Time& stageTime);
+
+    // Backward Euler method
+    // for the whole tree of
+    // bodies, with the springs
+    // solved implicitly
+
+    void                                                simulateWithImplicitEuler(const sf::Time& deltaTime,
+                                                                                  const sf::Time& totalTime);
+
+    // Functions used to
+    // collect the joints of
+    // this system's tree and
+    // to solve them along
+    // with the contacts, the
+    // bodies' starting poses
+    // are stored before the
+    // step so the solver sees
+    // them where they started
+
+    void                                                gatherJoints(std::vector<blBallJoint<blDataType>*>& joints);
+    void                                                storeConstraintStartingPoses();
+    void                                                solveConstraints(const sf::Time& deltaTime);
+
+    // Functions used to
+    // collect the connections
+    // of this system's tree
+    // and to update its
+    // islands
+
+    void                                                gatherConnections(std::vector<blConnection<blDataType>*>& connections);
+    void                                                updateIslands(const sf::Time& deltaTime);
+
+    // Function used by the
+    // move constructor and
+    // assignment to copy
+    // everything but the
+    // managers
+
+    void                                                copySimulationSettings(const blRigidBodySystem<blDataType,blIntegratorPolicy>& rigidBodySystem);
+
 protected: // Protected variables
 
     // additional field
@@ -139,12 +583,157 @@ protected: // Protected variables
 
     blRigidBodyContainerType                            m_rigidBodyManager;
 
+    // Managers holding
+    // our static and
+    // kinematic bodies
+
+    blRigidBodyContainerType                            m_staticBodyManager;
+    blRigidBodyContainerType                            m_kinematicBodyManager;
+
     // Manager holding
     // our rigid body
     // connections
 
     blConnectionContainerType                           m_connectionsManager;
 
+    // The executor used
+    // to run the step
+    // in parallel
+
+    std::shared_ptr<blExecutor>                         m_executor;
+
+    // Manager holding
+    // our joints and
+    // the solver for
+    // them and the
+    // contacts
+
+    blJointContainerType                                m_jointsManager;
+    std::shared_ptr< blConstraintSolver<blDataType> >   m_constraintSolver;
+
+    // The island manager
+    // putting bodies
+    // to sleep
+
+    std::shared_ptr< blIslandManager<blDataType> >      m_islandManager;
+
+    // The force fields
+    // acting on the
+    // bodies of our tree
+
+    std::shared_ptr< blForceFieldSet<blDataType> >      m_forceFieldSet;
+
+    // The memory pools
+    // used to create
+    // children bodies
+    // and connections
+
+    std::shared_ptr<blMemoryPool>                       m_bodyMemoryPool;
+    std::shared_ptr<blMemoryPool>                       m_connectionMemoryPool;
+
+    // The linear solver
+    // used by the implicit
+    // Euler method
+
+    blConjugateGradientSolver<blDataType>               m_implicitSolver;
+
+    // The table our
+    // connections' handles
+    // point into, our own
+    // handle in it and our
+    // handle in the table
+    // of the system that
+    // holds us
+
+    blRigidBodyTable<blDataType>                        m_rigidBodyTable;
+    blBodyHandle                                        m_selfHandle;
+    blBodyHandle                                        m_parentTableHandle;
+
+protected: // Protected temp variables
+
+    // Temporary buffers used
+    // by the RK4 method, kept
+    // around to avoid allocating
+    // them every step
+
+    std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>         m_rk4Systems;
+    std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>         m_rk4Bodies;
+
+    std::vector<blVectorType>                           m_rk4StartingPositions;
+    std::vector<blVectorType>                           m_rk4StartingVelocities;
+    std::vector<blQuaternionType>                       m_rk4StartingRotQtns;
+    std::vector<blVectorType>                           m_rk4StartingAngularVelocities;
+
+    std::vector<blVectorType>                           m_rk4ExternalForces;
+    std::vector<blVectorType>                           m_rk4ExternalTorques;
+
+    // Temporary buffer used
+    // to mark the table slots
+    // still held by a body
+    // of our managers
+
+    std::vector<std::uint8_t>                           m_isTableSlotUsed;
+
+    // Temporary buffers used
+    // to sample the force
+    // field set
+
+    std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>         m_forceFieldSystems;
+    std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>         m_forceFieldBodies;
+    blVector3dArray<blDataType>                         m_forceFieldPositions;
+
+    std::vector<blVectorType>                           m_rk4PositionRates[4];
+    std::vector<blVectorType>                           m_rk4VelocityRates[4];
+    std::vector<blQuaternionType>                       m_rk4RotQtnRates[4];
+    std::vector<blVectorType>                           m_rk4AngularVelocityRates[4];
+
+    // Temporary buffers used
+    // by the implicit Euler
+    // method, the velocity
+    // changes are kept from
+    // the last step to warm
+    // start the solver
+
+    std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>         m_implicitSystems;
+    std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>         m_implicitBodies;
+    std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>         m_implicitPreviousBodies;
+    std::vector< std::pair<blRigidBody<blDataType>*,std::size_t> >         m_implicitBodyLookup;
+
+    blSparseBlockMatrix<blDataType>                     m_implicitMatrix;
+    std::vector<blVectorType>                           m_implicitRightHandSide;
+    std::vector<blVectorType>                           m_implicitVelocityChanges;
+
+    // Temporary buffers used
+    // to hand the bodies and
+    // joints to the constraint
+    // solver
+
+    std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>         m_constraintBodies;
+    std::vector<blBallJoint<blDataType>*>               m_constraintJoints;
+
+    // The bodies' poses at
+    // the start of the step,
+    // turned into the moves
+    // the integrators made
+    // (and the orientations
+    // they left) while the
+    // solver runs, and the
+    // velocities they left
+
+    std::vector<blVectorType>                           m_constraintPositionSteps;
+    std::vector<blQuaternionType>                       m_constraintRotQtns;
+    std::vector<std::size_t>                            m_constraintOrientationVersions;
+    std::vector<blVectorType>                           m_constraintVelocities;
+    std::vector<blVectorType>                           m_constraintAngularVelocities;
+
+    // Temporary buffers used
+    // to build the islands
+
+    std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>         m_islandBodies;
+    std::vector<blConnection<blDataType>*>              m_islandConnections;
+    std::vector< std::pair<blRigidBody<blDataType>*,std::size_t> >         m_islandBodyLookup;
+    std::vector< std::pair<std::size_t,std::size_t> >   m_islandLinks;
+
 private: // Private variables
 
     // Clock and time
@@ -154,6 +743,22 @@ private: // Private variables
     sf::Clock                                           m_simulationClock;
     sf::Time                                            m_totalSimulationTime;
 
+    // Fixed step
+    // scheduling
+
+    sf::Time                                            m_fixedTimeStep;
+    int                                                 m_maxNumberOfSubSteps;
+    sf::Time                                            m_timeAccumulator;
+    blDataType                                          m_interpolationAlpha;
+
+    // State before the
+    // last step, used
+    // for interpolation
+
+    blVectorType                                        m_previousPosition;
+    blQuaternionType                                    m_previousRotQtn;
+    bool                                                m_hasPreviousState;
+
     // additional parameters
     // needed when simulating
 
@@ -166,40 +771,116 @@ private: // Private variables
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline blRigidBodySystem<blDataType>::blRigidBodySystem(const bool& shouldParentBodyBeSimulated,
-                                                        const bool& shouldChildrenBodiesBeSimulated,
-                                                        const blVectorType& additionalField,
-                                                        const int& integrationMethod,
-                                                        const sf::Time& startingSimulationTime)
-                                                        : blRigidBody<blDataType>()
+template<typename blDataType,typename blIntegratorPolicy>
+inline blRigidBodySystem<blDataType,blIntegratorPolicy>::blRigidBodySystem(const bool& shouldParentBodyBeSimulated,
+                                                                           const bool& shouldChildrenBodiesBeSimulated,
+                                                                           const blVectorType& additionalField,
+                                                                           const int& integrationMethod,
+                                                                           const sf::Time& startingSimulationTime)
+                                                                           : blRigidBody<blDataType>()
 {
     setShouldParentBodyBeSimulated(shouldParentBodyBeSimulated);
     setShouldChildrenBodiesBeSimulated(shouldChildrenBodiesBeSimulated);
     setAdditionalField(additionalField);
     setIntegrationMethod(integrationMethod);
 
+    setFixedTimeStep(sf::seconds(1.0f/60.0f));
+    setMaxNumberOfSubSteps(5);
+    m_interpolationAlpha = 0;
+    m_hasPreviousState = false;
+
     setTotalSimulationTime(startingSimulationTime);
     m_simulationClock.restart();
+
+    // The body table is
+    // only filled once the
+    // system has bodies or
+    // connections of its own
+
+    m_selfHandle = blRigidBodyTable<blDataType>::getNullHandle();
+    m_parentTableHandle = blRigidBodyTable<blDataType>::getNullHandle();
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline blRigidBodySystem<blDataType>::blRigidBodySystem(const blRigidBodySystem<blDataType>& rigidBodySystem)
-                                                        : blRigidBody<blDataType>(rigidBodySystem)
+template<typename blDataType,typename blIntegratorPolicy>
+inline blRigidBodySystem<blDataType,blIntegratorPolicy>::blRigidBodySystem(blRigidBodySystem<blDataType,blIntegratorPolicy>&& rigidBodySystem)
+                                                                           : blRigidBody<blDataType>(std::move(rigidBodySystem))
 {
-    // Copy the rigid
-    // bodies manager
+    // Take over the
+    // managers, the bodies,
+    // connections and joints
+    // aren't touched
 
-    setRigidBodyManager(rigidBodySystem.getRigidBodyManager());
+    setRigidBodyManager(std::move(rigidBodySystem.m_rigidBodyManager));
+    setStaticBodyManager(std::move(rigidBodySystem.m_staticBodyManager));
+    setKinematicBodyManager(std::move(rigidBodySystem.m_kinematicBodyManager));
+    setConnectionsManager(std::move(rigidBodySystem.m_connectionsManager));
+    setJointsManager(std::move(rigidBodySystem.m_jointsManager));
 
-    // Copy the
-    // connections
-    // manager
+    // Take over the body
+    // table, the handles
+    // the connections hold
+    // stay valid
+
+    m_parentTableHandle = blRigidBodyTable<blDataType>::getNullHandle();
+    takeOverRigidBodyTable(rigidBodySystem);
+
+    // Copy everything
+    // else
+
+    copySimulationSettings(rigidBodySystem);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline blRigidBodySystem<blDataType,blIntegratorPolicy>& blRigidBodySystem<blDataType,blIntegratorPolicy>::operator=(blRigidBodySystem<blDataType,blIntegratorPolicy>&& rigidBodySystem)
+{
+    if(this == &rigidBodySystem)
+        return *this;
+
+    blRigidBody<blDataType>::operator=(std::move(rigidBodySystem));
+
+    setRigidBodyManager(std::move(rigidBodySystem.m_rigidBodyManager));
+    setStaticBodyManager(std::move(rigidBodySystem.m_staticBodyManager));
+    setKinematicBodyManager(std::move(rigidBodySystem.m_kinematicBodyManager));
+    setConnectionsManager(std::move(rigidBodySystem.m_connectionsManager));
+    setJointsManager(std::move(rigidBodySystem.m_jointsManager));
+
+    takeOverRigidBodyTable(rigidBodySystem);
+
+    copySimulationSettings(rigidBodySystem);
+
+    return *this;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::copySimulationSettings(const blRigidBodySystem<blDataType,blIntegratorPolicy>& rigidBodySystem)
+{
+    // Share the
+    // constraint solver
+
+    setConstraintSolver(rigidBodySystem.getConstraintSolver());
+    setIslandManager(rigidBodySystem.getIslandManager());
+    setForceFieldSet(rigidBodySystem.getForceFieldSet());
+
+    // Share the memory
+    // pools
 
-    setConnectionsManager(rigidBodySystem.getConnectionsManager());
+    setBodyMemoryPool(rigidBodySystem.getBodyMemoryPool());
+    setConnectionMemoryPool(rigidBodySystem.getConnectionMemoryPool());
+
+    // Copy the implicit
+    // solver's settings
+
+    m_implicitSolver.setMaxNumberOfIterations(rigidBodySystem.getImplicitSolver().getMaxNumberOfIterations());
+    m_implicitSolver.setTolerance(rigidBodySystem.getImplicitSolver().getTolerance());
 
     // Copy the additional
     // parameters needed
@@ -209,6 +890,18 @@ inline blRigidBodySystem<blDataType>::blRigidBodySystem(const blRigidBodySystem<
     setShouldChildrenBodiesBeSimulated(rigidBodySystem.getShouldChildrenBodiesBeSimulated());
     setAdditionalField(rigidBodySystem.getAdditionalField());
     setIntegrationMethod(rigidBodySystem.getIntegrationMethod());
+    setExecutor(rigidBodySystem.getExecutor());
+
+    // Copy the fixed
+    // step scheduling
+
+    setFixedTimeStep(rigidBodySystem.getFixedTimeStep());
+    setMaxNumberOfSubSteps(rigidBodySystem.getMaxNumberOfSubSteps());
+    m_timeAccumulator = rigidBodySystem.m_timeAccumulator;
+    m_interpolationAlpha = rigidBodySystem.m_interpolationAlpha;
+    m_previousPosition = rigidBodySystem.m_previousPosition;
+    m_previousRotQtn = rigidBodySystem.m_previousRotQtn;
+    m_hasPreviousState = rigidBodySystem.m_hasPreviousState;
 
     // Copy the total
     // simulation time
@@ -220,16 +913,16 @@ inline blRigidBodySystem<blDataType>::blRigidBodySystem(const blRigidBodySystem<
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline blRigidBodySystem<blDataType>::~blRigidBodySystem()
+template<typename blDataType,typename blIntegratorPolicy>
+inline blRigidBodySystem<blDataType,blIntegratorPolicy>::~blRigidBodySystem()
 {
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline void blRigidBodySystem<blDataType>::setTotalSimulationTime(const sf::Time& totalSimulationTime)
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setTotalSimulationTime(const sf::Time& totalSimulationTime)
 {
     m_totalSimulationTime = totalSimulationTime;
 }
@@ -237,8 +930,8 @@ inline void blRigidBodySystem<blDataType>::setTotalSimulationTime(const sf::Time
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline const sf::Time& blRigidBodySystem<blDataType>::getTotalSimulationTime()const
+template<typename blDataType,typename blIntegratorPolicy>
+inline const sf::Time& blRigidBodySystem<blDataType,blIntegratorPolicy>::getTotalSimulationTime()const
 {
     return m_totalSimulationTime;
 }
@@ -246,8 +939,8 @@ inline const sf::Time& blRigidBodySystem<blDataType>::getTotalSimulationTime()co
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline const bool& blRigidBodySystem<blDataType>::getShouldParentBodyBeSimulated()const
+template<typename blDataType,typename blIntegratorPolicy>
+inline const bool& blRigidBodySystem<blDataType,blIntegratorPolicy>::getShouldParentBodyBeSimulated()const
 {
     return m_shouldParentBodyBeSimulated;
 }
@@ -255,8 +948,8 @@ inline const bool& blRigidBodySystem<blDataType>::getShouldParentBodyBeSimulated
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline const bool& blRigidBodySystem<blDataType>::getShouldChildrenBodiesBeSimulated()const
+template<typename blDataType,typename blIntegratorPolicy>
+inline const bool& blRigidBodySystem<blDataType,blIntegratorPolicy>::getShouldChildrenBodiesBeSimulated()const
 {
     return m_shouldChildrenBodiesBeSimulated;
 }
@@ -264,8 +957,8 @@ inline const bool& blRigidBodySystem<blDataType>::getShouldChildrenBodiesBeSimul
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline const typename blRigidBodySystem<blDataType>::blVectorType& blRigidBodySystem<blDataType>::getAdditionalField()const
+template<typename blDataType,typename blIntegratorPolicy>
+inline const typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blVectorType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getAdditionalField()const
 {
     return m_additionalField;
 }
@@ -273,8 +966,8 @@ inline const typename blRigidBodySystem<blDataType>::blVectorType& blRigidBodySy
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline const int& blRigidBodySystem<blDataType>::getIntegrationMethod()const
+template<typename blDataType,typename blIntegratorPolicy>
+inline const int& blRigidBodySystem<blDataType,blIntegratorPolicy>::getIntegrationMethod()const
 {
     return m_integrationMethod;
 }
@@ -282,8 +975,8 @@ inline const int& blRigidBodySystem<blDataType>::getIntegrationMethod()const
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline void blRigidBodySystem<blDataType>::setShouldParentBodyBeSimulated(const bool& shouldParentBodyBeSimulated)
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setShouldParentBodyBeSimulated(const bool& shouldParentBodyBeSimulated)
 {
     m_shouldParentBodyBeSimulated = shouldParentBodyBeSimulated;
 }
@@ -291,8 +984,8 @@ inline void blRigidBodySystem<blDataType>::setShouldParentBodyBeSimulated(const
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline void blRigidBodySystem<blDataType>::setShouldChildrenBodiesBeSimulated(const bool& shouldChildrenBodiesBeSimulated)
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setShouldChildrenBodiesBeSimulated(const bool& shouldChildrenBodiesBeSimulated)
 {
     m_shouldChildrenBodiesBeSimulated = shouldChildrenBodiesBeSimulated;
 }
@@ -300,8 +993,8 @@ inline void blRigidBodySystem<blDataType>::setShouldChildrenBodiesBeSimulated(co
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline void blRigidBodySystem<blDataType>::setAdditionalField(const blVectorType& additionalField)
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setAdditionalField(const blVectorType& additionalField)
 {
     m_additionalField = additionalField;
 }
@@ -309,8 +1002,8 @@ inline void blRigidBodySystem<blDataType>::setAdditionalField(const blVectorType
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline void blRigidBodySystem<blDataType>::setIntegrationMethod(const int& integrationMethod)
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setIntegrationMethod(const int& integrationMethod)
 {
     m_integrationMethod = integrationMethod;
 }
@@ -318,163 +1011,1911 @@ inline void blRigidBodySystem<blDataType>::setIntegrationMethod(const int& integ
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline typename blRigidBodySystem<blDataType>::blRigidBodyContainerType& blRigidBodySystem<blDataType>::getRigidBodyManager()
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setExecutor(const std::shared_ptr<blExecutor>& executor)
 {
-    return m_rigidBodyManager;
+    m_executor = executor;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline const typename blRigidBodySystem<blDataType>::blRigidBodyContainerType& blRigidBodySystem<blDataType>::getRigidBodyManager()const
+template<typename blDataType,typename blIntegratorPolicy>
+inline const std::shared_ptr<blExecutor>& blRigidBodySystem<blDataType,blIntegratorPolicy>::getExecutor()const
 {
-    return m_rigidBodyManager;
+    return m_executor;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline typename blRigidBodySystem<blDataType>::blConnectionContainerType& blRigidBodySystem<blDataType>::getConnectionsManager()
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setConstraintSolver(const std::shared_ptr< blConstraintSolver<blDataType> >& constraintSolver)
 {
-    return m_connectionsManager;
+    m_constraintSolver = constraintSolver;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline const typename blRigidBodySystem<blDataType>::blConnectionContainerType& blRigidBodySystem<blDataType>::getConnectionsManager()const
+template<typename blDataType,typename blIntegratorPolicy>
+inline const std::shared_ptr< blConstraintSolver<blDataType> >& blRigidBodySystem<blDataType,blIntegratorPolicy>::getConstraintSolver()const
 {
-    return m_connectionsManager;
+    return m_constraintSolver;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline void blRigidBodySystem<blDataType>::setRigidBodyManager(const blRigidBodyContainerType& rigidBodyManager)
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setIslandManager(const std::shared_ptr< blIslandManager<blDataType> >& islandManager)
 {
-    m_rigidBodyManager = rigidBodyManager;
+    m_islandManager = islandManager;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline void blRigidBodySystem<blDataType>::setConnectionsManager(const blConnectionContainerType& connectionsManager)
+template<typename blDataType,typename blIntegratorPolicy>
+inline const std::shared_ptr< blIslandManager<blDataType> >& blRigidBodySystem<blDataType,blIntegratorPolicy>::getIslandManager()const
 {
-    m_connectionsManager = connectionsManager;
+    return m_islandManager;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline void blRigidBodySystem<blDataType>::simulate()
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setForceFieldSet(const std::shared_ptr< blForceFieldSet<blDataType> >& forceFieldSet)
 {
-    m_totalSimulationTime += m_simulationClock.getElapsedTime();
+    m_forceFieldSet = forceFieldSet;
+}
+//-------------------------------------------------------------------
 
-    simulateWithTime(m_simulationClock.getElapsedTime(),
-                     m_totalSimulationTime);
 
-    m_simulationClock.restart();
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const std::shared_ptr< blForceFieldSet<blDataType> >& blRigidBodySystem<blDataType,blIntegratorPolicy>::getForceFieldSet()const
+{
+    return m_forceFieldSet;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline void blRigidBodySystem<blDataType>::simulateWithTime(const sf::Time& deltaTime,
-                                                            const sf::Time& totalTime)
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setBodyMemoryPool(const std::shared_ptr<blMemoryPool>& bodyMemoryPool)
 {
-    // Go through all the
-    // connections and
-    // calculate/apply all
-    // the forces/torques
-    // to the rigid bodies
-    // due to the connections
+    m_bodyMemoryPool = bodyMemoryPool;
+}
+//-------------------------------------------------------------------
 
-    for(auto myConnections = m_connectionsManager.begin();
-        myConnections != m_connectionsManager.end();
-        ++myConnections)
-    {
-        if(*myConnections)
-        {
-            (*myConnections)->calculateAndApplyForcesAndTorques();
-        }
-    }
 
-    // Call the base function
-    // if the parent object is
-    // to be simulated
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const std::shared_ptr<blMemoryPool>& blRigidBodySystem<blDataType,blIntegratorPolicy>::getBodyMemoryPool()const
+{
+    return m_bodyMemoryPool;
+}
+//-------------------------------------------------------------------
 
-    if(m_shouldParentBodyBeSimulated)
-        this->simulateRigidBody(deltaTime,
-                                totalTime,
-                                m_additionalField,
-                                m_integrationMethod);
 
-    // Call the childrens'
-    // simulation functions
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setConnectionMemoryPool(const std::shared_ptr<blMemoryPool>& connectionMemoryPool)
+{
+    m_connectionMemoryPool = connectionMemoryPool;
+}
+//-------------------------------------------------------------------
 
-    if(m_shouldChildrenBodiesBeSimulated)
-    {
-        // simulate all the rigid
-        // bodies managed by this
-        // rigid body system
 
-        for(auto myRigidBodies = m_rigidBodyManager.begin();
-            myRigidBodies != m_rigidBodyManager.end();
-            ++myRigidBodies)
-        {
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const std::shared_ptr<blMemoryPool>& blRigidBodySystem<blDataType,blIntegratorPolicy>::getConnectionMemoryPool()const
+{
+    return m_connectionMemoryPool;
+}
+//-------------------------------------------------------------------
 
-            if(*myRigidBodies)
-            {
-                (*myRigidBodies)->simulateWithTime(deltaTime,
-                                                   totalTime);
-            }
-        }
-    }
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+template<typename... blArgumentTypes>
+inline std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> > blRigidBodySystem<blDataType,blIntegratorPolicy>::createRigidBody(blArgumentTypes&&... arguments)
+{
+    std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> > rigidBody = allocateRigidBody(std::forward<blArgumentTypes>(arguments)...);
+
+    m_rigidBodyManager.push_back(rigidBody);
+    addToRigidBodyTable(rigidBody.get());
+
+    return rigidBody;
 }
 //-------------------------------------------------------------------
 
 
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline void blRigidBodySystem<blDataType>::resolveMotionLimits()
+template<typename blDataType,typename blIntegratorPolicy>
+template<typename... blArgumentTypes>
+inline std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> > blRigidBodySystem<blDataType,blIntegratorPolicy>::createStaticBody(blArgumentTypes&&... arguments)
 {
-    // Loop through the
-    // sub-rigid bodies
-    // and resolve their
-    // individual
-    // motion limits
+    std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> > rigidBody = allocateRigidBody(std::forward<blArgumentTypes>(arguments)...);
 
-    for(auto myRigidBodies = m_rigidBodyManager.begin();
-        myRigidBodies != m_rigidBodyManager.end();
-        ++myRigidBodies)
-    {
+    // Without mass or
+    // inverse inertia the
+    // solvers never move
+    // or turn the body
 
-        if(*myRigidBodies)
-        {
-            (*myRigidBodies)->resolveMotionLimits();
-        }
-    }
+    rigidBody->setMass(0);
+    rigidBody->zeroInertiaInverse();
 
-    // Now we resolve this rigid
-    // body's motion limits
+    m_staticBodyManager.push_back(rigidBody);
+    addToRigidBodyTable(rigidBody.get());
 
-    blRigidBody<blDataType>::resolveMotionLimits();
+    return rigidBody;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+template<typename... blArgumentTypes>
+inline std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> > blRigidBodySystem<blDataType,blIntegratorPolicy>::createKinematicBody(blArgumentTypes&&... arguments)
+{
+    std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> > rigidBody = allocateRigidBody(std::forward<blArgumentTypes>(arguments)...);
+
+    // Without mass or
+    // inverse inertia the
+    // solvers never push
+    // or turn the body
+
+    rigidBody->setMass(0);
+    rigidBody->zeroInertiaInverse();
+
+    m_kinematicBodyManager.push_back(rigidBody);
+    addToRigidBodyTable(rigidBody.get());
+
+    return rigidBody;
 }
+//-------------------------------------------------------------------
+
 
 //-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+template<typename... blArgumentTypes>
+inline std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> > blRigidBodySystem<blDataType,blIntegratorPolicy>::allocateRigidBody(blArgumentTypes&&... arguments)
+{
+    std::shared_ptr< blRigidBodySystem<blDataType,blIntegratorPolicy> > rigidBody =
+        blAllocateShared< blRigidBodySystem<blDataType,blIntegratorPolicy> >(m_bodyMemoryPool,
+                                                                             std::forward<blArgumentTypes>(arguments)...);
 
+    // The child creates
+    // its own children
+    // from the same pools
 
+    rigidBody->setBodyMemoryPool(m_bodyMemoryPool);
+    rigidBody->setConnectionMemoryPool(m_connectionMemoryPool);
+
+    return rigidBody;
+}
 //-------------------------------------------------------------------
-template<typename blDataType>
-inline void blRigidBodySystem<blDataType>::resolveAngularMotionLimits()
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+template<typename blConnectionType,typename... blArgumentTypes>
+inline std::shared_ptr<blConnectionType> blRigidBodySystem<blDataType,blIntegratorPolicy>::createConnection(blArgumentTypes&&... arguments)
+{
+    std::shared_ptr<blConnectionType> connection = blAllocateShared<blConnectionType>(m_connectionMemoryPool,
+                                                                                      std::forward<blArgumentTypes>(arguments)...);
+
+    connection->setRigidBodyTable(&m_rigidBodyTable);
+    m_connectionsManager.push_back(connection);
+
+    return connection;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blBodyHandle blRigidBodySystem<blDataType,blIntegratorPolicy>::getRigidBodyHandle(const blRigidBodySystem<blDataType,blIntegratorPolicy>* rigidBody)
+{
+    if(!rigidBody)
+        return blRigidBodyTable<blDataType>::getNullHandle();
+
+    if(rigidBody == this)
+    {
+        addSelfToRigidBodyTable();
+        return m_selfHandle;
+    }
+
+    // A body put in a manager
+    // by hand gets its slot
+    // when the table is next
+    // brought up to date
+
+    if(!m_rigidBodyTable.isHandleValid(rigidBody->m_parentTableHandle) ||
+       m_rigidBodyTable.getRigidBody(rigidBody->m_parentTableHandle) != rigidBody)
+    {
+        updateRigidBodyTable();
+    }
+
+    if(!m_rigidBodyTable.isHandleValid(rigidBody->m_parentTableHandle) ||
+       m_rigidBodyTable.getRigidBody(rigidBody->m_parentTableHandle) != rigidBody)
+    {
+        return blRigidBodyTable<blDataType>::getNullHandle();
+    }
+
+    return rigidBody->m_parentTableHandle;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const blRigidBodyTable<blDataType>& blRigidBodySystem<blDataType,blIntegratorPolicy>::getRigidBodyTable()const
+{
+    return m_rigidBodyTable;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::addToRigidBodyTable(blRigidBodySystem<blDataType,blIntegratorPolicy>* rigidBody)
+{
+    if(!rigidBody)
+        return;
+
+    addSelfToRigidBodyTable();
+
+    // Nothing to do when
+    // the body already has
+    // a slot in our table
+
+    if(m_rigidBodyTable.isHandleValid(rigidBody->m_parentTableHandle) &&
+       m_rigidBodyTable.getRigidBody(rigidBody->m_parentTableHandle) == rigidBody)
+    {
+        return;
+    }
+
+    rigidBody->m_parentTableHandle = m_rigidBodyTable.addRigidBody(rigidBody);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::addSelfToRigidBodyTable()
+{
+    // The system itself
+    // takes the first slot
+    // of its table
+
+    if(m_selfHandle == blRigidBodyTable<blDataType>::getNullHandle())
+        m_selfHandle = m_rigidBodyTable.addRigidBody(this);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::updateRigidBodyTable()
+{
+    // A system without bodies,
+    // connections or joints
+    // (a leaf of the tree)
+    // doesn't need a table,
+    // so spawning bodies
+    // doesn't allocate one
+    // for each of them
+
+    if(m_selfHandle == blRigidBodyTable<blDataType>::getNullHandle() &&
+       m_rigidBodyManager.empty() &&
+       m_staticBodyManager.empty() &&
+       m_kinematicBodyManager.empty() &&
+       m_connectionsManager.empty() &&
+       m_jointsManager.empty())
+    {
+        return;
+    }
+
+    addSelfToRigidBodyTable();
+
+    // Step 1:  Give a slot to
+    //          every body of our
+    //          managers that doesn't
+    //          have one yet and mark
+    //          the slots in use
+
+    m_isTableSlotUsed.assign(m_rigidBodyTable.getNumberOfHandleSlots(),0);
+    m_isTableSlotUsed[blRigidBodyTable<blDataType>::getHandleSlot(m_selfHandle)] = 1;
+
+    const blRigidBodyContainerType* managers[] = {&m_rigidBodyManager,
+                                                  &m_staticBodyManager,
+                                                  &m_kinematicBodyManager};
+
+    for(int i = 0; i < 3; ++i)
+    {
+        for(auto myRigidBodies = managers[i]->begin();
+            myRigidBodies != managers[i]->end();
+            ++myRigidBodies)
+        {
+            if(!(*myRigidBodies))
+                continue;
+
+            addToRigidBodyTable(myRigidBodies->get());
+
+            std::size_t slot = blRigidBodyTable<blDataType>::getHandleSlot((*myRigidBodies)->m_parentTableHandle);
+
+            if(slot >= m_isTableSlotUsed.size())
+                m_isTableSlotUsed.resize(slot + 1,0);
+
+            m_isTableSlotUsed[slot] = 1;
+        }
+    }
+
+    // Step 2:  Free the slots
+    //          of the bodies that
+    //          left the managers,
+    //          the handles to them
+    //          become stale
+
+    for(std::size_t slot = 0; slot < m_isTableSlotUsed.size(); ++slot)
+    {
+        if(!m_isTableSlotUsed[slot])
+            m_rigidBodyTable.removeRigidBody(m_rigidBodyTable.getBodyHandle(slot));
+    }
+
+    // Step 3:  Point our
+    //          connections and
+    //          joints to the table
+
+    for(auto myConnections = m_connectionsManager.begin();
+        myConnections != m_connectionsManager.end();
+        ++myConnections)
+    {
+        if(*myConnections)
+            (*myConnections)->setRigidBodyTable(&m_rigidBodyTable);
+    }
+
+    for(auto myJoints = m_jointsManager.begin();
+        myJoints != m_jointsManager.end();
+        ++myJoints)
+    {
+        if(*myJoints)
+            (*myJoints)->setRigidBodyTable(&m_rigidBodyTable);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::takeOverRigidBodyTable(blRigidBodySystem<blDataType,blIntegratorPolicy>& rigidBodySystem)
+{
+    m_rigidBodyTable = std::move(rigidBodySystem.m_rigidBodyTable);
+    m_selfHandle = rigidBodySystem.m_selfHandle;
+
+    // Our own slot points
+    // to us now, the other
+    // system starts over
+    // with an empty table
+
+    if(m_selfHandle != blRigidBodyTable<blDataType>::getNullHandle())
+        m_rigidBodyTable.setRigidBody(m_selfHandle,this);
+
+    rigidBodySystem.m_rigidBodyTable = blRigidBodyTable<blDataType>();
+    rigidBodySystem.m_selfHandle = blRigidBodyTable<blDataType>::getNullHandle();
+
+    updateRigidBodyTable();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline blConjugateGradientSolver<blDataType>& blRigidBodySystem<blDataType,blIntegratorPolicy>::getImplicitSolver()
+{
+    return m_implicitSolver;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const blConjugateGradientSolver<blDataType>& blRigidBodySystem<blDataType,blIntegratorPolicy>::getImplicitSolver()const
+{
+    return m_implicitSolver;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setFixedTimeStep(const sf::Time& fixedTimeStep)
+{
+    // A non-positive step
+    // would never drain the
+    // accumulator
+
+    if(fixedTimeStep > sf::Time())
+        m_fixedTimeStep = fixedTimeStep;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const sf::Time& blRigidBodySystem<blDataType,blIntegratorPolicy>::getFixedTimeStep()const
+{
+    return m_fixedTimeStep;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setMaxNumberOfSubSteps(const int& maxNumberOfSubSteps)
+{
+    m_maxNumberOfSubSteps = std::max(1,maxNumberOfSubSteps);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const int& blRigidBodySystem<blDataType,blIntegratorPolicy>::getMaxNumberOfSubSteps()const
+{
+    return m_maxNumberOfSubSteps;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const sf::Time& blRigidBodySystem<blDataType,blIntegratorPolicy>::getTimeAccumulator()const
+{
+    return m_timeAccumulator;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const blDataType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getInterpolationAlpha()const
+{
+    return m_interpolationAlpha;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blVectorType blRigidBodySystem<blDataType,blIntegratorPolicy>::getInterpolatedPosition(const blDataType& alpha)const
+{
+    if(!m_hasPreviousState)
+        return this->getPosition();
+
+    return m_previousPosition + (this->getPosition() - m_previousPosition) * alpha;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blQuaternionType blRigidBodySystem<blDataType,blIntegratorPolicy>::getInterpolatedRotQtn(const blDataType& alpha)const
+{
+    if(!m_hasPreviousState)
+        return this->getRotQtn();
+
+    const blQuaternionType& currentRotQtn = this->getRotQtn();
+
+    // Take the shortest
+    // way around
+
+    blDataType sign = 1;
+
+    if(m_previousRotQtn.w() * currentRotQtn.w() + m_previousRotQtn.m_xyz * currentRotQtn.m_xyz < 0)
+        sign = -1;
+
+    // Normalized linear
+    // interpolation
+
+    blDataType w = m_previousRotQtn.w() * (1 - alpha) + sign * currentRotQtn.w() * alpha;
+    blVectorType xyz = m_previousRotQtn.m_xyz * (1 - alpha) + currentRotQtn.m_xyz * (sign * alpha);
+
+    blDataType magnitude = std::sqrt(w * w + xyz * xyz);
+
+    if(magnitude <= 0)
+        return currentRotQtn;
+
+    return blQuaternionType(w / magnitude,xyz / magnitude);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::storePreviousState()
+{
+    m_previousPosition = this->getPosition();
+    m_previousRotQtn = this->getRotQtn();
+    m_hasPreviousState = true;
+
+    for(auto myRigidBodies = m_rigidBodyManager.begin();
+        myRigidBodies != m_rigidBodyManager.end();
+        ++myRigidBodies)
+    {
+        if(*myRigidBodies)
+        {
+            (*myRigidBodies)->storePreviousState();
+        }
+    }
+
+    // The static bodies
+    // never move, so only
+    // the kinematic ones
+    // are interpolated
+
+    for(auto myRigidBodies = m_kinematicBodyManager.begin();
+        myRigidBodies != m_kinematicBodyManager.end();
+        ++myRigidBodies)
+    {
+        if(*myRigidBodies)
+        {
+            (*myRigidBodies)->storePreviousState();
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::gatherRigidBodies(std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>& rigidBodies)
+{
+    for(auto myRigidBodies = m_rigidBodyManager.begin();
+        myRigidBodies != m_rigidBodyManager.end();
+        ++myRigidBodies)
+    {
+        if(*myRigidBodies)
+        {
+            rigidBodies.push_back(myRigidBodies->get());
+            (*myRigidBodies)->gatherRigidBodies(rigidBodies);
+        }
+    }
+
+    // The static and
+    // kinematic bodies
+    // are collected too,
+    // without their children,
+    // so the dynamic ones
+    // can touch them
+
+    for(auto myRigidBodies = m_staticBodyManager.begin();
+        myRigidBodies != m_staticBodyManager.end();
+        ++myRigidBodies)
+    {
+        if(*myRigidBodies)
+            rigidBodies.push_back(myRigidBodies->get());
+    }
+
+    for(auto myRigidBodies = m_kinematicBodyManager.begin();
+        myRigidBodies != m_kinematicBodyManager.end();
+        ++myRigidBodies)
+    {
+        if(*myRigidBodies)
+            rigidBodies.push_back(myRigidBodies->get());
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::calculateBoundingBoxes(std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>& rigidBodies,
+                                                                                     std::vector< blAABB<blDataType> >& boundingBoxes)
+{
+    rigidBodies.clear();
+    gatherRigidBodies(rigidBodies);
+
+    boundingBoxes.resize(rigidBodies.size());
+
+    for(std::size_t i = 0; i < rigidBodies.size(); ++i)
+        boundingBoxes[i].setFromRigidBody(*rigidBodies[i]);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::gatherJoints(std::vector<blBallJoint<blDataType>*>& joints)
+{
+    for(auto myJoints = m_jointsManager.begin();
+        myJoints != m_jointsManager.end();
+        ++myJoints)
+    {
+        if(*myJoints)
+            joints.push_back(myJoints->get());
+    }
+
+    for(auto myRigidBodies = m_rigidBodyManager.begin();
+        myRigidBodies != m_rigidBodyManager.end();
+        ++myRigidBodies)
+    {
+        if(*myRigidBodies)
+            (*myRigidBodies)->gatherJoints(joints);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::storeConstraintStartingPoses()
+{
+    // The solver looks for
+    // contacts among all the
+    // bodies in this tree
+
+    m_constraintBodies.clear();
+
+    gatherRigidBodies(m_constraintBodies);
+
+    std::size_t numberOfBodies = m_constraintBodies.size();
+
+    m_constraintPositionSteps.resize(numberOfBodies);
+    m_constraintRotQtns.resize(numberOfBodies);
+    m_constraintOrientationVersions.resize(numberOfBodies);
+    m_constraintVelocities.resize(numberOfBodies);
+    m_constraintAngularVelocities.resize(numberOfBodies);
+
+    for(std::size_t i = 0; i < numberOfBodies; ++i)
+    {
+        m_constraintPositionSteps[i] = m_constraintBodies[i]->getPosition();
+        m_constraintRotQtns[i] = m_constraintBodies[i]->getRotQtn();
+        m_constraintOrientationVersions[i] = m_constraintBodies[i]->getOrientationVersion();
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::solveConstraints(const sf::Time& deltaTime)
+{
+    // The integrators have
+    // already moved the bodies,
+    // solving the contacts there
+    // and adding the velocity
+    // change on top keeps stacks
+    // jittering, so the contacts
+    // and joints are solved where
+    // the bodies started and the
+    // bodies they push move from
+    // there with their corrected
+    // velocities, the others keep
+    // the move their integrator
+    // made
+
+    std::size_t numberOfBodies = m_constraintBodies.size();
+
+    // Step 1:  Take the bodies
+    //          back to where they
+    //          started, keeping
+    //          the moves the
+    //          integrators made
+
+    for(std::size_t i = 0; i < numberOfBodies; ++i)
+    {
+        blRigidBodySystem<blDataType,blIntegratorPolicy>* body = m_constraintBodies[i];
+
+        blVectorType startingPosition = m_constraintPositionSteps[i];
+
+        m_constraintPositionSteps[i] = body->getPosition() - startingPosition;
+
+        if(m_constraintPositionSteps[i] * m_constraintPositionSteps[i] > 0)
+            body->translate(-m_constraintPositionSteps[i]);
+
+        if(body->getOrientationVersion() != m_constraintOrientationVersions[i])
+        {
+            blQuaternionType startingRotQtn = m_constraintRotQtns[i];
+
+            m_constraintRotQtns[i] = body->getRotQtn();
+
+            body->blOrientation<blDataType>::rotateTo(startingRotQtn);
+        }
+
+        m_constraintVelocities[i] = body->getVelocity();
+        m_constraintAngularVelocities[i] = body->getAngularVelocity();
+    }
+
+    // Step 2:  Solve the contacts
+    //          with all the tree's
+    //          joints, the solver
+    //          moves the bodies by
+    //          the velocity change
+    //          times the time step
+
+    m_constraintJoints.clear();
+
+    gatherJoints(m_constraintJoints);
+
+    m_constraintSolver->step(m_constraintBodies,
+                             m_constraintJoints,
+                             blDataType(deltaTime.asSeconds()));
+
+    // Step 3:  Move the bodies,
+    //          the solver already
+    //          moved the ones it
+    //          pushed by their
+    //          velocity change, so
+    //          their integrated
+    //          velocities are what's
+    //          left of the corrected
+    //          ones, the others make
+    //          their integrator's move
+
+    blDataType dt = blDataType(deltaTime.asSeconds());
+
+    for(std::size_t i = 0; i < numberOfBodies; ++i)
+    {
+        blRigidBodySystem<blDataType,blIntegratorPolicy>* body = m_constraintBodies[i];
+
+        blVectorType velocityChange = body->getVelocity() - m_constraintVelocities[i];
+        blVectorType angularVelocityChange = body->getAngularVelocity() - m_constraintAngularVelocities[i];
+
+        if(velocityChange * velocityChange > 0 ||
+           angularVelocityChange * angularVelocityChange > 0)
+        {
+            body->translate(m_constraintVelocities[i] * dt);
+
+            blDataType angularSpeed = blMathAPI::norm2(m_constraintAngularVelocities[i]);
+
+            if(angularSpeed > 0)
+            {
+                blDataType theta = angularSpeed * dt;
+
+                blQuaternionType rotQtn(std::cos(theta/blDataType(2)),
+                                        m_constraintAngularVelocities[i] * (std::sin(theta/blDataType(2)) / angularSpeed));
+
+                body->blOrientation<blDataType>::rotate(rotQtn);
+            }
+
+            continue;
+        }
+
+        if(m_constraintPositionSteps[i] * m_constraintPositionSteps[i] > 0)
+            body->translate(m_constraintPositionSteps[i]);
+
+        if(body->getOrientationVersion() != m_constraintOrientationVersions[i])
+            body->blOrientation<blDataType>::rotateTo(m_constraintRotQtns[i]);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::gatherConnections(std::vector<blConnection<blDataType>*>& connections)
+{
+    for(auto myConnections = m_connectionsManager.begin();
+        myConnections != m_connectionsManager.end();
+        ++myConnections)
+    {
+        if(*myConnections)
+            connections.push_back(myConnections->get());
+    }
+
+    for(auto myJoints = m_jointsManager.begin();
+        myJoints != m_jointsManager.end();
+        ++myJoints)
+    {
+        if(*myJoints)
+            connections.push_back(myJoints->get());
+    }
+
+    for(auto myRigidBodies = m_rigidBodyManager.begin();
+        myRigidBodies != m_rigidBodyManager.end();
+        ++myRigidBodies)
+    {
+        if(*myRigidBodies)
+            (*myRigidBodies)->gatherConnections(connections);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::updateIslands(const sf::Time& deltaTime)
+{
+    // Step 1:  Collect the
+    //          bodies, in the
+    //          same order the
+    //          constraint solver
+    //          got them
+
+    m_islandBodies.clear();
+    gatherRigidBodies(m_islandBodies);
+
+    m_islandLinks.clear();
+
+    // Step 2:  Link the bodies
+    //          touching each other
+
+    if(m_constraintSolver)
+    {
+        m_islandManager->findTouchingPairs(m_constraintSolver->getBoundingBoxes(),
+                                           m_constraintSolver->getPairs(),
+                                           m_islandLinks);
+    }
+
+    // Step 3:  Link the bodies
+    //          held together by
+    //          connections and joints
+
+    m_islandConnections.clear();
+    gatherConnections(m_islandConnections);
+
+    if(!m_islandConnections.empty())
+    {
+        m_islandBodyLookup.clear();
+
+        for(std::size_t i = 0; i < m_islandBodies.size(); ++i)
+            m_islandBodyLookup.push_back(std::make_pair(static_cast<blRigidBody<blDataType>*>(m_islandBodies[i]),i));
+
+        std::sort(m_islandBodyLookup.begin(),m_islandBodyLookup.end());
+
+        for(std::size_t i = 0; i < m_islandConnections.size(); ++i)
+        {
+            auto body1 = std::lower_bound(m_islandBodyLookup.begin(),
+                                          m_islandBodyLookup.end(),
+                                          std::make_pair(m_islandConnections[i]->getRigidBody1(),std::size_t(0)));
+
+            auto body2 = std::lower_bound(m_islandBodyLookup.begin(),
+                                          m_islandBodyLookup.end(),
+                                          std::make_pair(m_islandConnections[i]->getRigidBody2(),std::size_t(0)));
+
+            if(body1 == m_islandBodyLookup.end() || body1->first != m_islandConnections[i]->getRigidBody1() ||
+               body2 == m_islandBodyLookup.end() || body2->first != m_islandConnections[i]->getRigidBody2())
+                continue;
+
+            m_islandLinks.push_back(std::make_pair(body1->second,body2->second));
+        }
+    }
+
+    // Step 4:  Build the islands
+    //          and update their
+    //          sleeping state
+
+    m_islandManager->update(m_islandBodies,
+                            m_islandLinks,
+                            blDataType(deltaTime.asSeconds()));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blRigidBodyContainerType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getRigidBodyManager()
+{
+    return m_rigidBodyManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blRigidBodyContainerType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getRigidBodyManager()const
+{
+    return m_rigidBodyManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blConnectionContainerType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getConnectionsManager()
+{
+    return m_connectionsManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blConnectionContainerType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getConnectionsManager()const
+{
+    return m_connectionsManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setRigidBodyManager(const blRigidBodyContainerType& rigidBodyManager)
+{
+    m_rigidBodyManager = rigidBodyManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setRigidBodyManager(blRigidBodyContainerType&& rigidBodyManager)
+{
+    m_rigidBodyManager = std::move(rigidBodyManager);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setConnectionsManager(const blConnectionContainerType& connectionsManager)
+{
+    m_connectionsManager = connectionsManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setConnectionsManager(blConnectionContainerType&& connectionsManager)
+{
+    m_connectionsManager = std::move(connectionsManager);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blJointContainerType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getJointsManager()
+{
+    return m_jointsManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blJointContainerType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getJointsManager()const
+{
+    return m_jointsManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setJointsManager(const blJointContainerType& jointsManager)
+{
+    m_jointsManager = jointsManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setJointsManager(blJointContainerType&& jointsManager)
+{
+    m_jointsManager = std::move(jointsManager);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setStaticBodyManager(const blRigidBodyContainerType& staticBodyManager)
+{
+    m_staticBodyManager = staticBodyManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setStaticBodyManager(blRigidBodyContainerType&& staticBodyManager)
+{
+    m_staticBodyManager = std::move(staticBodyManager);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blRigidBodyContainerType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getStaticBodyManager()
+{
+    return m_staticBodyManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blRigidBodyContainerType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getStaticBodyManager()const
+{
+    return m_staticBodyManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setKinematicBodyManager(const blRigidBodyContainerType& kinematicBodyManager)
+{
+    m_kinematicBodyManager = kinematicBodyManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::setKinematicBodyManager(blRigidBodyContainerType&& kinematicBodyManager)
+{
+    m_kinematicBodyManager = std::move(kinematicBodyManager);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blRigidBodyContainerType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getKinematicBodyManager()
+{
+    return m_kinematicBodyManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline const typename blRigidBodySystem<blDataType,blIntegratorPolicy>::blRigidBodyContainerType& blRigidBodySystem<blDataType,blIntegratorPolicy>::getKinematicBodyManager()const
+{
+    return m_kinematicBodyManager;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::simulate()
+{
+    simulateFrame(m_simulationClock.restart());
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::simulateFrame(const sf::Time& frameTime)
+{
+    // Step 1:  Collect the
+    //          frame's time
+
+    m_timeAccumulator += frameTime;
+
+    // Step 2:  Take as many
+    //          fixed steps as fit,
+    //          up to the maximum
+
+    int numberOfSubSteps = 0;
+
+    while(m_timeAccumulator >= m_fixedTimeStep &&
+          numberOfSubSteps < m_maxNumberOfSubSteps)
+    {
+        storePreviousState();
+
+        m_totalSimulationTime += m_fixedTimeStep;
+
+        simulateWithTime(m_fixedTimeStep,
+                         m_totalSimulationTime);
+
+        m_timeAccumulator -= m_fixedTimeStep;
+        ++numberOfSubSteps;
+    }
+
+    // Step 3:  If we hit the
+    //          maximum, drop the
+    //          whole steps we
+    //          couldn't take
+
+    if(m_timeAccumulator >= m_fixedTimeStep)
+        m_timeAccumulator = sf::microseconds(m_timeAccumulator.asMicroseconds() % m_fixedTimeStep.asMicroseconds());
+
+    // Step 4:  How far we are
+    //          between the last
+    //          two steps
+
+    m_interpolationAlpha = static_cast<blDataType>(m_timeAccumulator.asSeconds() / m_fixedTimeStep.asSeconds());
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::simulateWithTime(const sf::Time& deltaTime,
+                                                                               const sf::Time& totalTime)
+{
+    // Remember where the
+    // bodies start, the
+    // contacts and joints
+    // are solved there
+
+    // Bring the body table
+    // up to date before any
+    // connection looks up
+    // its bodies
+
+    updateRigidBodyTable();
+
+    if(m_constraintSolver)
+        storeConstraintStartingPoses();
+
+    // The RK4 and implicit
+    // Euler methods take
+    // care of the whole tree
+    // at once
+
+    if(blIntegratorPolicy::isRuntimeSelected && m_integrationMethod == BL_RK4)
+    {
+        simulateWithRK4(deltaTime,totalTime);
+
+        for(std::size_t i = 0; i < m_rk4Systems.size(); ++i)
+            m_rk4Systems[i]->moveKinematicBodies(deltaTime);
+    }
+    else if(blIntegratorPolicy::isRuntimeSelected && m_integrationMethod == BL_IMPLICIT_EULER)
+    {
+        simulateWithImplicitEuler(deltaTime,totalTime);
+
+        for(std::size_t i = 0; i < m_implicitSystems.size(); ++i)
+            m_implicitSystems[i]->moveKinematicBodies(deltaTime);
+    }
+    else
+    {
+        // Add the forces of
+        // our force fields to
+        // our tree's bodies,
+        // the children add
+        // their own fields'
+
+        applyForceFieldForces(totalTime);
+
+        // Go through all the
+        // connections and
+        // calculate/apply all
+        // the forces/torques
+        // to the rigid bodies
+        // due to the connections
+
+        calculateAndApplyConnectionForces();
+
+        // Simulate the parent
+        // object with the
+        // integrator policy
+        // if it's to be
+        // simulated
+
+        if(m_shouldParentBodyBeSimulated && this->getIsAwake())
+            blIntegratorPolicy::simulate(*this,
+                                         deltaTime,
+                                         totalTime,
+                                         m_additionalField,
+                                         m_integrationMethod);
+
+        // Call the childrens'
+        // simulation functions
+
+        if(m_shouldChildrenBodiesBeSimulated)
+            simulateChildren(deltaTime,totalTime);
+
+        // Move our kinematic
+        // bodies, the static
+        // ones are never
+        // touched
+
+        moveKinematicBodies(deltaTime);
+    }
+
+    // Fix the velocities
+    // of touching and
+    // jointed bodies before
+    // they move with them
+
+    if(m_constraintSolver)
+        solveConstraints(deltaTime);
+
+    // Put the islands
+    // at rest to sleep
+
+    if(m_islandManager)
+        updateIslands(deltaTime);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::calculateAndApplyConnectionForces()
+{
+    if(!m_executor || m_executor->getNumberOfThreads() <= 1)
+    {
+        for(auto myConnections = m_connectionsManager.begin();
+            myConnections != m_connectionsManager.end();
+            ++myConnections)
+        {
+            if(*myConnections)
+            {
+                (*myConnections)->calculateAndApplyForcesAndTorques();
+            }
+        }
+
+        return;
+    }
+
+    // Step 1:  Calculate the
+    //          forces in parallel,
+    //          each connection only
+    //          reads the bodies and
+    //          writes its own buffer
+
+    m_executor->parallelFor(m_connectionsManager.size(),
+                            [this](const std::size_t& beginIndex,const std::size_t& endIndex)
+                            {
+                                for(std::size_t i = beginIndex; i < endIndex; ++i)
+                                {
+                                    if(m_connectionsManager[i])
+                                        m_connectionsManager[i]->calculateForcesAndTorques();
+                                }
+                            });
+
+    // Step 2:  Apply the forces
+    //          serially, in the same
+    //          order as the serial
+    //          path so the sums are
+    //          the same bit for bit
+
+    for(auto myConnections = m_connectionsManager.begin();
+        myConnections != m_connectionsManager.end();
+        ++myConnections)
+    {
+        if(*myConnections)
+        {
+            (*myConnections)->applyForcesAndTorques();
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::moveKinematicBodies(const sf::Time& deltaTime)
+{
+    blDataType dt = deltaTime.asSeconds();
+
+    for(auto myRigidBodies = m_kinematicBodyManager.begin();
+        myRigidBodies != m_kinematicBodyManager.end();
+        ++myRigidBodies)
+    {
+        if(!(*myRigidBodies))
+            continue;
+
+        blRigidBodySystem<blDataType,blIntegratorPolicy>& rigidBody = **myRigidBodies;
+
+        // Step 1:  Drift the
+        //          position
+
+        rigidBody.translate(rigidBody.getVelocity() * dt);
+
+        // Step 2:  Drift the
+        //          orientation,
+        //          rotating by
+        //          |w|*dt about w
+
+        blDataType angularSpeed = blMathAPI::norm2(rigidBody.getAngularVelocity());
+
+        if(angularSpeed > 0)
+        {
+            blDataType theta = angularSpeed * dt;
+
+            blMathAPI::blQuaternion<blDataType> angVelQtn(std::cos(theta/blDataType(2)),
+                                                          rigidBody.getAngularVelocity() * (std::sin(theta/blDataType(2)) / angularSpeed));
+
+            rigidBody.blOrientation<blDataType>::rotate(angVelQtn);
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::applyForceFieldForces(const sf::Time& totalTime)
+{
+    if(!m_forceFieldSet)
+        return;
+
+    // Step 1:  Collect the
+    //          bodies of our
+    //          tree and their
+    //          positions
+
+    m_forceFieldSystems.clear();
+    m_forceFieldBodies.clear();
+
+    gatherSimulatedSystems(m_forceFieldSystems,m_forceFieldBodies);
+
+    m_forceFieldPositions.resize(m_forceFieldBodies.size());
+
+    for(std::size_t i = 0; i < m_forceFieldBodies.size(); ++i)
+        m_forceFieldPositions.setVector(i,m_forceFieldBodies[i]->getPosition());
+
+    // Step 2:  Sample all the
+    //          fields in one pass
+
+    m_forceFieldSet->calculateAccelerations(m_forceFieldPositions,totalTime);
+
+    // Step 3:  Add mass*acceleration
+    //          to every body's force
+
+    const blVector3dArray<blDataType>& accelerations = m_forceFieldSet->getAccelerations();
+
+    for(std::size_t i = 0; i < m_forceFieldBodies.size(); ++i)
+    {
+        if(m_forceFieldBodies[i]->getMass() > 0)
+            m_forceFieldBodies[i]->addForce(m_forceFieldBodies[i]->getMass() * accelerations.getVector(i));
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::simulateChildren(const sf::Time& deltaTime,
+                                                                               const sf::Time& totalTime)
+{
+    if(!m_executor || m_executor->getNumberOfThreads() <= 1)
+    {
+        // simulate all the rigid
+        // bodies managed by this
+        // rigid body system
+
+        for(auto myRigidBodies = m_rigidBodyManager.begin();
+            myRigidBodies != m_rigidBodyManager.end();
+            ++myRigidBodies)
+        {
+
+            if(*myRigidBodies)
+            {
+                (*myRigidBodies)->simulateWithTime(deltaTime,
+                                                   totalTime);
+            }
+        }
+
+        return;
+    }
+
+    // Partition the children
+    // across the workers, each
+    // child's connections only
+    // reach the bodies of its
+    // own table, so its own
+    // sub-tree
+
+    m_executor->parallelFor(m_rigidBodyManager.size(),
+                            [this,&deltaTime,&totalTime](const std::size_t& beginIndex,const std::size_t& endIndex)
+                            {
+                                for(std::size_t i = beginIndex; i < endIndex; ++i)
+                                {
+                                    if(m_rigidBodyManager[i])
+                                        m_rigidBodyManager[i]->simulateWithTime(deltaTime,
+                                                                                totalTime);
+                                }
+                            });
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::gatherSimulatedSystems(std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>& systems,
+                                                                                     std::vector<blRigidBodySystem<blDataType,blIntegratorPolicy>*>& bodies)
+{
+    systems.push_back(this);
+
+    if(m_shouldParentBodyBeSimulated && this->getIsAwake())
+        bodies.push_back(this);
+
+    if(m_shouldChildrenBodiesBeSimulated)
+    {
+        for(auto myRigidBodies = m_rigidBodyManager.begin();
+            myRigidBodies != m_rigidBodyManager.end();
+            ++myRigidBodies)
+        {
+            if(*myRigidBodies)
+            {
+                (*myRigidBodies)->gatherSimulatedSystems(systems,bodies);
+            }
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::calculateStateDerivatives(const std::size_t& stage,
+                                                                                        const sf::Time& stageTime)
+{
+    // Step 1:  Start from the
+    //          forces added by the
+    //          user before the step
+
+    for(std::size_t i = 0; i < m_rk4Systems.size(); ++i)
+    {
+        m_rk4Systems[i]->clearForcesAndTorques();
+        m_rk4Systems[i]->addForce(m_rk4ExternalForces[i]);
+        m_rk4Systems[i]->addTorque(m_rk4ExternalTorques[i]);
+    }
+
+    // Step 2:  Apply the
+    //          connection forces
+    //          at the current state
+
+    for(std::size_t i = 0; i < m_rk4Systems.size(); ++i)
+        m_rk4Systems[i]->calculateAndApplyConnectionForces();
+
+    // Step 3:  Apply the force
+    //          fields at the
+    //          current positions
+
+    for(std::size_t i = 0; i < m_rk4Systems.size(); ++i)
+        m_rk4Systems[i]->applyForceFieldForces(stageTime);
+
+    // Step 4:  Calculate the
+    //          derivatives of
+    //          every body's state
+
+    for(std::size_t i = 0; i < m_rk4Bodies.size(); ++i)
+    {
+        blRigidBodySystem<blDataType,blIntegratorPolicy>* body = m_rk4Bodies[i];
+
+        const blVectorType& velocity = body->getVelocity();
+        const blVectorType& angularVelocity = body->getAngularVelocity();
+        const blQuaternionType& rotQtn = body->getRotQtn();
+
+        blVectorType totalForce = body->getTotalForce() + body->calculateDamping(velocity);
+        blVectorType totalTorque = body->getTotalTorque() + body->calculateAngularDamping(angularVelocity);
+
+        // dx/dt = v
+        // dv/dt = F/m + field
+
+        m_rk4PositionRates[stage][i] = velocity;
+        m_rk4VelocityRates[stage][i] = totalForce / body->getMass() + body->m_additionalField;
+
+        // dq/dt = 0.5 * (0,w) * q
+
+        m_rk4RotQtnRates[stage][i] = blQuaternionType(blDataType(-0.5) * (angularVelocity * rotQtn.m_xyz),
+                                                      (angularVelocity * rotQtn.w() + crossProduct(angularVelocity,rotQtn.m_xyz)) * blDataType(0.5));
+
+        // dw/dt = I^-1 * (T - w x Iw)
+
+        m_rk4AngularVelocityRates[stage][i] = body->applyWorldInertiaInverse(totalTorque - crossProduct(angularVelocity,body->applyWorldInertia(angularVelocity)));
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::simulateWithRK4(const sf::Time& deltaTime,
+                                                                              const sf::Time& totalTime)
+{
+    // Step 1:  Collect the bodies
+    //          and store their
+    //          starting state, the
+    //          ones without mass are
+    //          left where they are
+
+    m_rk4Systems.clear();
+    m_rk4Bodies.clear();
+
+    gatherSimulatedSystems(m_rk4Systems,m_rk4Bodies);
+
+    // The first system is
+    // this one, its table is
+    // already up to date
+
+    for(std::size_t i = 1; i < m_rk4Systems.size(); ++i)
+        m_rk4Systems[i]->updateRigidBodyTable();
+
+    m_rk4Bodies.erase(std::remove_if(m_rk4Bodies.begin(),
+                                     m_rk4Bodies.end(),
+                                     [](blRigidBodySystem<blDataType,blIntegratorPolicy>* body)
+                                     {
+                                         return body->getMass() <= 0;
+                                     }),
+                      m_rk4Bodies.end());
+
+    std::size_t numberOfBodies = m_rk4Bodies.size();
+
+    // The forces added with
+    // addForce/addTorque before
+    // the step act during every
+    // stage, so we keep them
+    // aside from the connection
+    // forces that get recomputed
+
+    m_rk4ExternalForces.resize(m_rk4Systems.size());
+    m_rk4ExternalTorques.resize(m_rk4Systems.size());
+
+    for(std::size_t i = 0; i < m_rk4Systems.size(); ++i)
+    {
+        m_rk4ExternalForces[i] = m_rk4Systems[i]->getTotalForce();
+        m_rk4ExternalTorques[i] = m_rk4Systems[i]->getTotalTorque();
+    }
+
+    m_rk4StartingPositions.resize(numberOfBodies);
+    m_rk4StartingVelocities.resize(numberOfBodies);
+    m_rk4StartingRotQtns.resize(numberOfBodies);
+    m_rk4StartingAngularVelocities.resize(numberOfBodies);
+
+    for(std::size_t stage = 0; stage < 4; ++stage)
+    {
+        m_rk4PositionRates[stage].resize(numberOfBodies);
+        m_rk4VelocityRates[stage].resize(numberOfBodies);
+        m_rk4RotQtnRates[stage].resize(numberOfBodies);
+        m_rk4AngularVelocityRates[stage].resize(numberOfBodies);
+    }
+
+    for(std::size_t i = 0; i < numberOfBodies; ++i)
+    {
+        m_rk4StartingPositions[i] = m_rk4Bodies[i]->getPosition();
+        m_rk4StartingVelocities[i] = m_rk4Bodies[i]->getVelocity();
+        m_rk4StartingRotQtns[i] = m_rk4Bodies[i]->getRotQtn();
+        m_rk4StartingAngularVelocities[i] = m_rk4Bodies[i]->getAngularVelocity();
+    }
+
+    // Step 2:  Evaluate the four
+    //          stages, each one at
+    //          the state predicted
+    //          by the one before
+    //
+    //          k1 = f(y0)
+    //          k2 = f(y0 + k1*dt/2)
+    //          k3 = f(y0 + k2*dt/2)
+    //          k4 = f(y0 + k3*dt)
+
+    blDataType dt = blDataType(deltaTime.asSeconds());
+    blDataType stageTimeSteps[] = {0,dt/blDataType(2),dt/blDataType(2),dt};
+
+    for(std::size_t stage = 0; stage < 4; ++stage)
+    {
+        if(stage > 0)
+        {
+            for(std::size_t i = 0; i < numberOfBodies; ++i)
+            {
+                blRigidBodySystem<blDataType,blIntegratorPolicy>* body = m_rk4Bodies[i];
+                const blDataType& h = stageTimeSteps[stage];
+
+                body->translate(m_rk4StartingPositions[i] + m_rk4PositionRates[stage - 1][i] * h - body->getPosition());
+                body->setVelocity(m_rk4StartingVelocities[i] + m_rk4VelocityRates[stage - 1][i] * h);
+                body->setAngularVelocity(m_rk4StartingAngularVelocities[i] + m_rk4AngularVelocityRates[stage - 1][i] * h);
+
+                blDataType w = m_rk4StartingRotQtns[i].w() + m_rk4RotQtnRates[stage - 1][i].w() * h;
+                blVectorType xyz = m_rk4StartingRotQtns[i].m_xyz + m_rk4RotQtnRates[stage - 1][i].m_xyz * h;
+                blDataType magnitude = std::sqrt(w * w + xyz * xyz);
+
+                // The axes only matter
+                // for the final state
+
+                body->rotateTo(blQuaternionType(w / magnitude,xyz / magnitude),false,false);
+            }
+        }
+
+        calculateStateDerivatives(stage,
+                                  totalTime + sf::seconds(float(stageTimeSteps[stage])));
+    }
+
+    // Step 3:  Combine the stages
+    //          and move every body
+    //          from its starting
+    //          state to the new one
+    //
+    //          y1 = y0 + (k1 + 2*k2 + 2*k3 + k4)*dt/6
+
+    blDataType weight = dt / blDataType(6);
+
+    for(std::size_t i = 0; i < numberOfBodies; ++i)
+    {
+        blRigidBodySystem<blDataType,blIntegratorPolicy>* body = m_rk4Bodies[i];
+
+        blVectorType positionChange = (m_rk4PositionRates[0][i] + (m_rk4PositionRates[1][i] + m_rk4PositionRates[2][i]) * blDataType(2) + m_rk4PositionRates[3][i]) * weight;
+        blVectorType velocityChange = (m_rk4VelocityRates[0][i] + (m_rk4VelocityRates[1][i] + m_rk4VelocityRates[2][i]) * blDataType(2) + m_rk4VelocityRates[3][i]) * weight;
+        blVectorType angularVelocityChange = (m_rk4AngularVelocityRates[0][i] + (m_rk4AngularVelocityRates[1][i] + m_rk4AngularVelocityRates[2][i]) * blDataType(2) + m_rk4AngularVelocityRates[3][i]) * weight;
+
+        blDataType w = m_rk4StartingRotQtns[i].w() +
+                       (m_rk4RotQtnRates[0][i].w() + (m_rk4RotQtnRates[1][i].w() + m_rk4RotQtnRates[2][i].w()) * blDataType(2) + m_rk4RotQtnRates[3][i].w()) * weight;
+        blVectorType xyz = m_rk4StartingRotQtns[i].m_xyz +
+                           (m_rk4RotQtnRates[0][i].m_xyz + (m_rk4RotQtnRates[1][i].m_xyz + m_rk4RotQtnRates[2][i].m_xyz) * blDataType(2) + m_rk4RotQtnRates[3][i].m_xyz) * weight;
+        blDataType magnitude = std::sqrt(w * w + xyz * xyz);
+
+        // Go back to the starting
+        // state first, so that the
+        // final translation/rotation
+        // is recorded as this step's
+
+        body->translate(m_rk4StartingPositions[i] - body->getPosition());
+        body->rotateTo(m_rk4StartingRotQtns[i],false,false);
+
+        body->translate(positionChange);
+        body->setVelocity(m_rk4StartingVelocities[i] + velocityChange);
+        body->rotateTo(blQuaternionType(w / magnitude,xyz / magnitude));
+        body->setAngularVelocity(m_rk4StartingAngularVelocities[i] + angularVelocityChange);
+
+        // Check the
+        // motion limits
+
+        body->blRigidBody<blDataType>::resolveMotionLimits();
+        body->blRigidBody<blDataType>::resolveAngularMotionLimits();
+    }
+
+    // Step 4:  Clear the forces
+    //          left from the last
+    //          stage
+
+    for(std::size_t i = 0; i < m_rk4Systems.size(); ++i)
+        m_rk4Systems[i]->clearForcesAndTorques();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::simulateWithImplicitEuler(const sf::Time& deltaTime,
+                                                                                        const sf::Time& totalTime)
+{
+    // Step 1:  Collect the bodies,
+    //          the ones without mass
+    //          are left where they are
+
+    m_implicitSystems.clear();
+    m_implicitBodies.clear();
+
+    gatherSimulatedSystems(m_implicitSystems,m_implicitBodies);
+
+    // The first system is
+    // this one, its table is
+    // already up to date
+
+    for(std::size_t i = 1; i < m_implicitSystems.size(); ++i)
+        m_implicitSystems[i]->updateRigidBodyTable();
+
+    m_implicitBodies.erase(std::remove_if(m_implicitBodies.begin(),
+                                          m_implicitBodies.end(),
+                                          [](blRigidBodySystem<blDataType,blIntegratorPolicy>* body)
+                                          {
+                                              return body->getMass() <= 0;
+                                          }),
+                           m_implicitBodies.end());
+
+    std::size_t numberOfBodies = m_implicitBodies.size();
+
+    // The last step's velocity
+    // changes are only a good
+    // guess for the same bodies
+
+    if(m_implicitBodies != m_implicitPreviousBodies)
+    {
+        m_implicitVelocityChanges.assign(numberOfBodies,blVectorType(0,0,0));
+        m_implicitPreviousBodies = m_implicitBodies;
+    }
+
+    m_implicitBodyLookup.clear();
+
+    for(std::size_t i = 0; i < numberOfBodies; ++i)
+        m_implicitBodyLookup.push_back(std::make_pair(static_cast<blRigidBody<blDataType>*>(m_implicitBodies[i]),i));
+
+    std::sort(m_implicitBodyLookup.begin(),m_implicitBodyLookup.end());
+
+    // Step 2:  Apply the connection
+    //          and force field forces
+    //          at the current state
+
+    for(std::size_t i = 0; i < m_implicitSystems.size(); ++i)
+    {
+        m_implicitSystems[i]->calculateAndApplyConnectionForces();
+        m_implicitSystems[i]->applyForceFieldForces(totalTime);
+    }
+
+    // Step 3:  The diagonal holds
+    //          the masses and the
+    //          linear damping, the
+    //          right hand side the
+    //          explicit impulses
+    //
+    //          A_ii = m + dt*c
+    //          b_i = dt*(F + damping + m*field)
+
+    blDataType dt = blDataType(deltaTime.asSeconds());
+
+    m_implicitMatrix.reset(numberOfBodies);
+    m_implicitRightHandSide.resize(numberOfBodies);
+
+    for(std::size_t i = 0; i < numberOfBodies; ++i)
+    {
+        blRigidBodySystem<blDataType,blIntegratorPolicy>* body = m_implicitBodies[i];
+
+        m_implicitMatrix.addToDiagonal(i,body->getMass() + dt * body->getDampingCoefficient());
+
+        m_implicitRightHandSide[i] = (body->getTotalForce() +
+                                      body->calculateDamping(body->getVelocity()) +
+                                      body->getMass() * body->m_additionalField) * dt;
+    }
+
+    // Step 4:  Add the Jacobians
+    //          of the connections,
+    //          with J = dF1/dx2 and
+    //          Jv = dF1/dv2
+    //
+    //          C = dt*Jv + dt^2*J
+    //          A_11 += C, A_22 += C
+    //          A_12 -= C, A_21 -= C
+    //          b_1 += dt^2*J*(v2 - v1)
+    //          b_2 -= dt^2*J*(v2 - v1)
+
+    const std::size_t noBody = std::numeric_limits<std::size_t>::max();
+
+    blDataType positionJacobian[3][3];
+    blDataType velocityJacobian[3][3];
+    blDataType combinedJacobian[3][3];
+
+    for(std::size_t i = 0; i < m_implicitSystems.size(); ++i)
+    {
+        const blConnectionContainerType& connections = m_implicitSystems[i]->m_connectionsManager;
+
+        for(std::size_t j = 0; j < connections.size(); ++j)
+        {
+            if(!connections[j] ||
+               !connections[j]->getRigidBody1() ||
+               !connections[j]->getRigidBody2())
+            {
+                continue;
+            }
+
+            blRigidBody<blDataType>* body1 = connections[j]->getRigidBody1();
+            blRigidBody<blDataType>* body2 = connections[j]->getRigidBody2();
+
+            auto lookup1 = std::lower_bound(m_implicitBodyLookup.begin(),
+                                            m_implicitBodyLookup.end(),
+                                            std::make_pair(body1,std::size_t(0)));
+
+            auto lookup2 = std::lower_bound(m_implicitBodyLookup.begin(),
+                                            m_implicitBodyLookup.end(),
+                                            std::make_pair(body2,std::size_t(0)));
+
+            std::size_t index1 = (lookup1 != m_implicitBodyLookup.end() && lookup1->first == body1) ? lookup1->second : noBody;
+            std::size_t index2 = (lookup2 != m_implicitBodyLookup.end() && lookup2->first == body2) ? lookup2->second : noBody;
+
+            if(index1 == noBody && index2 == noBody)
+                continue;
+
+            if(!connections[j]->calculateForceJacobians(positionJacobian,velocityJacobian))
+                continue;
+
+            for(int row = 0; row < 3; ++row)
+                for(int column = 0; column < 3; ++column)
+                    combinedJacobian[row][column] = dt * velocityJacobian[row][column] + dt * dt * positionJacobian[row][column];
+
+            // The bodies not being
+            // solved for keep their
+            // velocity
+
+            blVectorType relativeVelocity = body2->getVelocity() - body1->getVelocity();
+
+            blVectorType stiffnessImpulse = blVectorType(positionJacobian[0][0] * relativeVelocity.x() + positionJacobian[0][1] * relativeVelocity.y() + positionJacobian[0][2] * relativeVelocity.z(),
+                                                         positionJacobian[1][0] * relativeVelocity.x() + positionJacobian[1][1] * relativeVelocity.y() + positionJacobian[1][2] * relativeVelocity.z(),
+                                                         positionJacobian[2][0] * relativeVelocity.x() + positionJacobian[2][1] * relativeVelocity.y() + positionJacobian[2][2] * relativeVelocity.z()) * (dt * dt);
+
+            if(index1 != noBody)
+            {
+                m_implicitMatrix.addBlock(index1,index1,combinedJacobian,blDataType(1));
+                m_implicitRightHandSide[index1] += stiffnessImpulse;
+            }
+
+            if(index2 != noBody)
+            {
+                m_implicitMatrix.addBlock(index2,index2,combinedJacobian,blDataType(1));
+                m_implicitRightHandSide[index2] -= stiffnessImpulse;
+            }
+
+            if(index1 != noBody && index2 != noBody)
+            {
+                m_implicitMatrix.addBlock(index1,index2,combinedJacobian,blDataType(-1));
+                m_implicitMatrix.addBlock(index2,index1,combinedJacobian,blDataType(-1));
+            }
+        }
+    }
+
+    m_implicitMatrix.finalize();
+
+    // Step 5:  Solve for the
+    //          velocity changes,
+    //          starting from the
+    //          last step's
+
+    m_implicitSolver.setExecutor(m_executor);
+    m_implicitSolver.solve(m_implicitMatrix,m_implicitRightHandSide,m_implicitVelocityChanges);
+
+    // Step 6:  Move the bodies with
+    //          their new velocities,
+    //          the torques are kicked
+    //          explicitly
+
+    for(std::size_t i = 0; i < numberOfBodies; ++i)
+    {
+        blRigidBodySystem<blDataType,blIntegratorPolicy>* body = m_implicitBodies[i];
+
+        blVectorType totalTorque = body->getTotalTorque() + body->calculateAngularDamping(body->getAngularVelocity());
+
+        body->clearForcesAndTorques();
+        body->addTorque(totalTorque);
+
+        body->changeVelocity(m_implicitVelocityChanges[i]);
+
+        blSemiImplicitEulerIntegrator::integrateState(*body,deltaTime,blVectorType(0,0,0));
+
+        // Check the
+        // motion limits
+
+        body->blRigidBody<blDataType>::resolveMotionLimits();
+        body->blRigidBody<blDataType>::resolveAngularMotionLimits();
+    }
+
+    // Step 7:  Clear the forces
+    //          left on the rest
+    //          of the tree
+
+    for(std::size_t i = 0; i < m_implicitSystems.size(); ++i)
+        m_implicitSystems[i]->clearForcesAndTorques();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::resolveMotionLimits()
+{
+    // Loop through the
+    // sub-rigid bodies
+    // and resolve their
+    // individual
+    // motion limits
+
+    for(auto myRigidBodies = m_rigidBodyManager.begin();
+        myRigidBodies != m_rigidBodyManager.end();
+        ++myRigidBodies)
+    {
+
+        if(*myRigidBodies)
+        {
+            (*myRigidBodies)->resolveMotionLimits();
+        }
+    }
+
+    // Now we resolve this rigid
+    // body's motion limits
+
+    blRigidBody<blDataType>::resolveMotionLimits();
+}
+
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,typename blIntegratorPolicy>
+inline void blRigidBodySystem<blDataType,blIntegratorPolicy>::resolveAngularMotionLimits()
 {
     // Loop through the
     // sub-rigid bodies
@@ -0,0 +1,266 @@
+#ifndef BL_RIGIDBODYTABLE_HPP
+#define BL_RIGIDBODYTABLE_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blRigidBodyTable.hpp
+// CLASS:           blRigidBodyTable
+// BASE CLASS:      None
+//
+// PURPOSE:         A table of slots pointing to rigid bodies, handing
+//                  out generational handles so connections can refer
+//                  to the bodies of a blRigidBodySystem with plain
+//                  integers instead of shared pointers
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blRigidBody -- The bodies the slots point to
+//
+// NOTES:           - A handle is a 64-bit integer holding a slot
+//                    (low 32 bits) and the slot's generation (high 32
+//                    bits), the same layout as the handles of
+//                    blRigidBodyWorld, removing a body bumps its slot's
+//                    generation so old handles to it stay invalid after
+//                    the slot is reused
+//                  - The table doesn't own the bodies, the system that
+//                    owns them keeps the table in step with its managers
+//                  - getRigidBody asserts the handle is valid in debug
+//                    builds, release builds get a null pointer for a
+//                    stale handle, the null handle always gives a null
+//                    pointer
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+
+template<typename blDataType>
+class blRigidBody;
+
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blRigidBodyTable
+{
+public: // Public typedefs
+
+    typedef std::uint64_t                               blBodyHandle;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blRigidBodyTable()
+    {
+    }
+
+    // Destructor
+
+    ~blRigidBodyTable()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // add/remove a body,
+    // adding returns the
+    // body's handle
+
+    blBodyHandle                                        addRigidBody(blRigidBody<blDataType>* rigidBody);
+    void                                                removeRigidBody(const blBodyHandle& bodyHandle);
+
+    // Function used to
+    // point a handle's slot
+    // to another body, for
+    // bodies that moved
+
+    void                                                setRigidBody(const blBodyHandle& bodyHandle,
+                                                                     blRigidBody<blDataType>* rigidBody);
+
+    // Functions used to
+    // look up a body by
+    // its handle
+
+    bool                                                isHandleValid(const blBodyHandle& bodyHandle)const;
+    blRigidBody<blDataType>*                            getRigidBody(const blBodyHandle& bodyHandle)const;
+
+    // Function used to get
+    // the current handle of
+    // a slot, valid only if
+    // the slot has a body
+
+    blBodyHandle                                        getBodyHandle(const std::size_t& slot)const;
+
+    // Functions used to get
+    // the handle that refers
+    // to no body and the slot
+    // of a handle
+
+    static blBodyHandle                                 getNullHandle();
+    static std::size_t                                  getHandleSlot(const blBodyHandle& bodyHandle);
+    std::size_t                                         getNumberOfHandleSlots()const;
+
+private: // Private variables
+
+    // The body of each
+    // slot, the current
+    // generation of each
+    // slot and the list of
+    // slots that can be
+    // reused
+
+    std::vector<blRigidBody<blDataType>*>               m_rigidBodies;
+    std::vector<std::uint32_t>                          m_handleGenerations;
+    std::vector<std::size_t>                            m_freeHandles;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBodyTable<blDataType>::blBodyHandle blRigidBodyTable<blDataType>::addRigidBody(blRigidBody<blDataType>* rigidBody)
+{
+    // Get a slot for
+    // the body, reusing
+    // a freed one if
+    // we can
+
+    std::size_t slot;
+
+    if(m_freeHandles.empty())
+    {
+        slot = m_rigidBodies.size();
+        m_rigidBodies.push_back(rigidBody);
+        m_handleGenerations.push_back(0);
+    }
+    else
+    {
+        slot = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        m_rigidBodies[slot] = rigidBody;
+    }
+
+    return getBodyHandle(slot);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyTable<blDataType>::removeRigidBody(const blBodyHandle& bodyHandle)
+{
+    if(!isHandleValid(bodyHandle))
+        return;
+
+    // Invalidate and
+    // recycle the slot,
+    // with a new generation
+    // so old handles to it
+    // stay invalid
+
+    std::size_t slot = getHandleSlot(bodyHandle);
+
+    m_rigidBodies[slot] = nullptr;
+    ++m_handleGenerations[slot];
+    m_freeHandles.push_back(slot);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyTable<blDataType>::setRigidBody(const blBodyHandle& bodyHandle,
+                                                       blRigidBody<blDataType>* rigidBody)
+{
+    assert(isHandleValid(bodyHandle) && "blRigidBodyTable: invalid or stale body handle");
+
+    m_rigidBodies[getHandleSlot(bodyHandle)] = rigidBody;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blRigidBodyTable<blDataType>::isHandleValid(const blBodyHandle& bodyHandle)const
+{
+    std::size_t slot = getHandleSlot(bodyHandle);
+
+    return (slot < m_rigidBodies.size() &&
+            m_handleGenerations[slot] == std::uint32_t(bodyHandle >> 32) &&
+            m_rigidBodies[slot] != nullptr);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blRigidBody<blDataType>* blRigidBodyTable<blDataType>::getRigidBody(const blBodyHandle& bodyHandle)const
+{
+    if(bodyHandle == getNullHandle())
+        return nullptr;
+
+    assert(isHandleValid(bodyHandle) && "blRigidBodyTable: invalid or stale body handle");
+
+    if(!isHandleValid(bodyHandle))
+        return nullptr;
+
+    return m_rigidBodies[getHandleSlot(bodyHandle)];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBodyTable<blDataType>::blBodyHandle blRigidBodyTable<blDataType>::getBodyHandle(const std::size_t& slot)const
+{
+    return (blBodyHandle(m_handleGenerations[slot]) << 32) | blBodyHandle(slot);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBodyTable<blDataType>::blBodyHandle blRigidBodyTable<blDataType>::getNullHandle()
+{
+    return std::numeric_limits<blBodyHandle>::max();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blRigidBodyTable<blDataType>::getHandleSlot(const blBodyHandle& bodyHandle)
+{
+    return std::size_t(bodyHandle & 0xffffffff);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blRigidBodyTable<blDataType>::getNumberOfHandleSlots()const
+{
+    return m_rigidBodies.size();
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_RIGIDBODYTABLE_HPP
@@ -0,0 +1,1110 @@
+#ifndef BL_RIGIDBODYWORLD_HPP
+#define BL_RIGIDBODYWORLD_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blRigidBodyWorld.hpp
+// CLASS:           blRigidBodyWorld
+// BASE CLASS:      None
+//
+// PURPOSE:         A structure-of-arrays storage for large numbers
+//                  of rigid bodies, where positions, velocities,
+//                  rotation quaternions, angular velocities, inverse
+//                  masses and inertias are each kept in their own
+//                  contiguous arrays and indexed through body handles
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blVector3dArray, blQuaternionArray, blMatrix3dArray
+//                  - blBatchIntegrator -- The integration kernels
+//                  - blRigidBody -- Used to import/export the state
+//                                   of single rigid bodies
+//
+// NOTES:           - Body handles stay valid while other bodies are
+//                    added/removed, but the dense index of a body
+//                    changes when a body is removed, since the last
+//                    body is moved into the freed slot to keep the
+//                    arrays contiguous
+//                  - A handle is a 64-bit integer holding a slot in
+//                    the handle table (low 32 bits) and the slot's
+//                    generation (high 32 bits), removing a body bumps
+//                    its slot's generation so old handles to it stay
+//                    invalid after the slot is reused, and handles can
+//                    be copied and stored as plain integers
+//                  - Debug builds check every handle passed to the
+//                    accessors with assert, release builds trust them
+//                  - The masses are kept next to the inverse masses
+//                    (both zero for bodies without mass), so passes
+//                    that need either don't divide, setMass keeps
+//                    them in step and code writing the arrays directly
+//                    has to do the same
+//                  - The integration loop follows the same Euler
+//                    scheme as blRigidBody::calculateNewStateUsingEuler
+//                    but is split in blBatchIntegrator passes so each
+//                    pass only streams the arrays it needs
+//                  - The inertias in system coordinates are calculated
+//                    once per step for all the bodies, from the
+//                    orientations at the beginning of the step, and
+//                    kept for other solvers to reuse until the next
+//                    step
+//                  - Damping is not added as a force, each step the
+//                    velocities are scaled by exp(-c*dt/m) and the
+//                    angular velocities, along the body axes, by
+//                    exp(-c*dt/I), which can never overshoot however
+//                    large the damping coefficients are
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blRigidBodyWorld
+{
+public: // Public typedefs
+
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+    typedef blMathAPI::blQuaternion<blDataType>         blQuaternionType;
+    typedef blMathAPI::blMatrix3d<blDataType>           blMatrixType;
+
+    typedef std::uint64_t                               blBodyHandle;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blRigidBodyWorld(const blVectorType& additionalField = blVectorType(0,0,0));
+
+    // Destructor
+
+    virtual ~blRigidBodyWorld()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // add/remove rigid
+    // bodies
+
+    blBodyHandle                                        addRigidBody(const blRigidBody<blDataType>& rigidBody);
+
+    blBodyHandle                                        addRigidBody(const blVectorType& position,
+                                                                     const blVectorType& velocity,
+                                                                     const blQuaternionType& rotQtn,
+                                                                     const blVectorType& angularVelocity,
+                                                                     const blDataType& mass,
+                                                                     const blMatrixType& inertia,
+                                                                     const blMatrixType& inertiaInverse,
+                                                                     const blDataType& dampingCoefficient = 0,
+                                                                     const blDataType& angularDampingCoefficient = 0);
+
+    void                                                removeRigidBody(const blBodyHandle& bodyHandle);
+
+    // Function used to
+    // reserve space for
+    // a number of bodies
+
+    void                                                reserve(const std::size_t& numberOfBodies);
+
+    // Functions used to
+    // query the bodies
+
+    std::size_t                                         getNumberOfBodies()const;
+    bool                                                isHandleValid(const blBodyHandle& bodyHandle)const;
+    std::size_t                                         getBodyIndex(const blBodyHandle& bodyHandle)const;
+    blBodyHandle                                        getBodyHandle(const std::size_t& bodyIndex)const;
+
+    // Functions used to
+    // get the slot of a
+    // handle and the number
+    // of slots, so that
+    // per-body tables can
+    // be indexed by slot
+
+    static std::size_t                                  getHandleSlot(const blBodyHandle& bodyHandle);
+    std::size_t                                         getNumberOfHandleSlots()const;
+
+    // Functions used to
+    // get/set the state
+    // of a single body
+
+    blVectorType                                        getPosition(const blBodyHandle& bodyHandle)const;
+    blVectorType                                        getVelocity(const blBodyHandle& bodyHandle)const;
+    blQuaternionType                                    getRotQtn(const blBodyHandle& bodyHandle)const;
+    blVectorType                                        getAngularVelocity(const blBodyHandle& bodyHandle)const;
+    const blDataType&                                   getMass(const blBodyHandle& bodyHandle)const;
+    const blDataType&                                   getInverseMass(const blBodyHandle& bodyHandle)const;
+    const blDataType&                                   getDampingCoefficient(const blBodyHandle& bodyHandle)const;
+    const blDataType&                                   getAngularDampingCoefficient(const blBodyHandle& bodyHandle)const;
+
+    void                                                setPosition(const blBodyHandle& bodyHandle,
+                                                                    const blVectorType& position);
+    void                                                setVelocity(const blBodyHandle& bodyHandle,
+                                                                    const blVectorType& velocity);
+    void                                                setRotQtn(const blBodyHandle& bodyHandle,
+                                                                  const blQuaternionType& rotQtn);
+    void                                                setAngularVelocity(const blBodyHandle& bodyHandle,
+                                                                           const blVectorType& angularVelocity);
+    void                                                setMass(const blBodyHandle& bodyHandle,
+                                                                const blDataType& mass);
+    void                                                setInertia(const blBodyHandle& bodyHandle,
+                                                                   const blMatrixType& inertia,
+                                                                   const blMatrixType& inertiaInverse);
+    void                                                setDampingCoefficients(const blBodyHandle& bodyHandle,
+                                                                               const blDataType& dampingCoefficient,
+                                                                               const blDataType& angularDampingCoefficient);
+
+    // Functions used to
+    // add forces/torques
+    // to a single body
+
+    void                                                addForce(const blBodyHandle& bodyHandle,
+                                                                 const blVectorType& force);
+
+    void                                                addTorque(const blBodyHandle& bodyHandle,
+                                                                  const blVectorType& torque);
+
+    void                                                addForceAndTorque(const blBodyHandle& bodyHandle,
+                                                                          const blVectorType& force,
+                                                                          const blVectorType& forcePosition);
+
+    // Function used to
+    // zero out all the
+    // forces/torques
+
+    void                                                clearForcesAndTorques();
+
+    // Function used to
+    // copy the state of
+    // a body back into
+    // a blRigidBody
+
+    void                                                copyStateToRigidBody(const blBodyHandle& bodyHandle,
+                                                                             blRigidBody<blDataType>& rigidBody)const;
+
+    // Functions used to
+    // set/get the additional
+    // acceleration field
+    // (for ex. gravity)
+
+    void                                                setAdditionalField(const blVectorType& additionalField);
+    const blVectorType&                                 getAdditionalField()const;
+
+    // Function used to
+    // integrate all the
+    // bodies by one step
+    // and then clear the
+    // forces/torques
+
+    void                                                integrate(const sf::Time& timeStep,
+                                                                  const int& integrationMethod = BL_EULER);
+
+    // Functions used to
+    // get the per-field
+    // arrays directly,
+    // for batched algorithms
+
+    blVector3dArray<blDataType>&                        getPositions();
+    blVector3dArray<blDataType>&                        getVelocities();
+    blQuaternionArray<blDataType>&                      getRotQtns();
+    blVector3dArray<blDataType>&                        getAngularVelocities();
+    std::vector<blDataType>&                            getMasses();
+    std::vector<blDataType>&                            getInverseMasses();
+    blMatrix3dArray<blDataType>&                        getInertias();
+    blMatrix3dArray<blDataType>&                        getInertiaInverses();
+    std::vector<blDataType>&                            getDampingCoefficients();
+    std::vector<blDataType>&                            getAngularDampingCoefficients();
+    blVector3dArray<blDataType>&                        getTotalForces();
+    blVector3dArray<blDataType>&                        getTotalTorques();
+
+    const blVector3dArray<blDataType>&                  getPositions()const;
+    const blVector3dArray<blDataType>&                  getVelocities()const;
+    const blQuaternionArray<blDataType>&                getRotQtns()const;
+    const blVector3dArray<blDataType>&                  getAngularVelocities()const;
+    const std::vector<blDataType>&                      getMasses()const;
+    const std::vector<blDataType>&                      getInverseMasses()const;
+    const blMatrix3dArray<blDataType>&                  getInertias()const;
+    const blMatrix3dArray<blDataType>&                  getInertiaInverses()const;
+    const std::vector<blDataType>&                      getDampingCoefficients()const;
+    const std::vector<blDataType>&                      getAngularDampingCoefficients()const;
+    const blVector3dArray<blDataType>&                  getTotalForces()const;
+    const blVector3dArray<blDataType>&                  getTotalTorques()const;
+
+    // Functions used to get
+    // the inertias and inverse
+    // inertias in system
+    // coordinates calculated
+    // by the last step
+
+    const blMatrix3dArray<blDataType>&                  getWorldInertias()const;
+    const blMatrix3dArray<blDataType>&                  getWorldInertiaInverses()const;
+
+protected: // Protected functions
+
+    // Functions used to
+    // move a body from
+    // one dense index to
+    // another and to drop
+    // the last body
+
+    virtual void                                        moveBody(const std::size_t& fromIndex,
+                                                                 const std::size_t& toIndex);
+    virtual void                                        popBody();
+
+protected: // Protected variables
+
+    // The per-field
+    // body arrays
+
+    blVector3dArray<blDataType>                         m_positions;
+    blVector3dArray<blDataType>                         m_velocities;
+    blQuaternionArray<blDataType>                       m_rotQtns;
+    blVector3dArray<blDataType>                         m_angularVelocities;
+    std::vector<blDataType>                             m_masses;
+    std::vector<blDataType>                             m_inverseMasses;
+    blMatrix3dArray<blDataType>                         m_inertias;
+    blMatrix3dArray<blDataType>                         m_inertiaInverses;
+    std::vector<blDataType>                             m_dampingCoefficients;
+    std::vector<blDataType>                             m_angularDampingCoefficients;
+
+    // The inertias and inverse
+    // inertias in system
+    // coordinates, calculated
+    // every step
+
+    blMatrix3dArray<blDataType>                         m_worldInertias;
+    blMatrix3dArray<blDataType>                         m_worldInertiaInverses;
+
+    // The force/torque
+    // accumulators
+
+    blVector3dArray<blDataType>                         m_totalForces;
+    blVector3dArray<blDataType>                         m_totalTorques;
+
+    // Tables mapping handle
+    // slots to dense indices
+    // and dense indices back
+    // to handles, the current
+    // generation of each slot
+    // and the list of slots
+    // that can be reused
+
+    std::vector<std::size_t>                            m_handleToIndex;
+    std::vector<blBodyHandle>                           m_indexToHandle;
+    std::vector<std::uint32_t>                          m_handleGenerations;
+    std::vector<std::size_t>                            m_freeHandles;
+
+    // Additional field
+    // added to the total
+    // body acceleration
+
+    blVectorType                                        m_additionalField;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blRigidBodyWorld<blDataType>::blRigidBodyWorld(const blVectorType& additionalField)
+{
+    setAdditionalField(additionalField);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBodyWorld<blDataType>::blBodyHandle blRigidBodyWorld<blDataType>::addRigidBody(const blRigidBody<blDataType>& rigidBody)
+{
+    return addRigidBody(rigidBody.getPosition(),
+                        rigidBody.getVelocity(),
+                        rigidBody.getRotQtn(),
+                        rigidBody.getAngularVelocity(),
+                        rigidBody.getMass(),
+                        rigidBody.getInertia(),
+                        rigidBody.getInertiaInverse(),
+                        rigidBody.getDampingCoefficient(),
+                        rigidBody.getAngularDampingCoefficient());
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBodyWorld<blDataType>::blBodyHandle blRigidBodyWorld<blDataType>::addRigidBody(const blVectorType& position,
+                                                                                                       const blVectorType& velocity,
+                                                                                                       const blQuaternionType& rotQtn,
+                                                                                                       const blVectorType& angularVelocity,
+                                                                                                       const blDataType& mass,
+                                                                                                       const blMatrixType& inertia,
+                                                                                                       const blMatrixType& inertiaInverse,
+                                                                                                       const blDataType& dampingCoefficient,
+                                                                                                       const blDataType& angularDampingCoefficient)
+{
+    // Step 1:  Append the
+    //          body's state
+    //          to the arrays
+
+    std::size_t bodyIndex = m_inverseMasses.size();
+
+    m_positions.push_back(position);
+    m_velocities.push_back(velocity);
+    m_rotQtns.push_back(rotQtn);
+    m_angularVelocities.push_back(angularVelocity);
+    m_masses.push_back(mass > 0 ? mass : blDataType(0));
+    m_inverseMasses.push_back(mass > 0 ? blDataType(1)/mass : blDataType(0));
+    m_inertias.push_back(inertia);
+    m_inertiaInverses.push_back(inertiaInverse);
+    m_dampingCoefficients.push_back(dampingCoefficient);
+    m_angularDampingCoefficients.push_back(angularDampingCoefficient);
+    m_totalForces.push_back(blVectorType(0,0,0));
+    m_totalTorques.push_back(blVectorType(0,0,0));
+
+    // Step 2:  Get a slot
+    //          for the body,
+    //          reusing a freed
+    //          one if we can
+
+    std::size_t slot;
+
+    if(m_freeHandles.empty())
+    {
+        slot = m_handleToIndex.size();
+        m_handleToIndex.push_back(bodyIndex);
+        m_handleGenerations.push_back(0);
+    }
+    else
+    {
+        slot = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        m_handleToIndex[slot] = bodyIndex;
+    }
+
+    blBodyHandle bodyHandle = (blBodyHandle(m_handleGenerations[slot]) << 32) | blBodyHandle(slot);
+
+    m_indexToHandle.push_back(bodyHandle);
+
+    return bodyHandle;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::removeRigidBody(const blBodyHandle& bodyHandle)
+{
+    if(!isHandleValid(bodyHandle))
+        return;
+
+    std::size_t slot = getHandleSlot(bodyHandle);
+    std::size_t bodyIndex = m_handleToIndex[slot];
+    std::size_t lastIndex = m_inverseMasses.size() - 1;
+
+    // Move the last body
+    // into the freed slot
+    // to keep the arrays
+    // contiguous
+
+    if(bodyIndex != lastIndex)
+    {
+        moveBody(lastIndex,bodyIndex);
+
+        blBodyHandle lastHandle = m_indexToHandle[lastIndex];
+        m_indexToHandle[bodyIndex] = lastHandle;
+        m_handleToIndex[getHandleSlot(lastHandle)] = bodyIndex;
+    }
+
+    popBody();
+    m_indexToHandle.pop_back();
+
+    // Invalidate and
+    // recycle the slot,
+    // with a new generation
+    // so old handles to it
+    // stay invalid
+
+    m_handleToIndex[slot] = std::numeric_limits<std::size_t>::max();
+    ++m_handleGenerations[slot];
+    m_freeHandles.push_back(slot);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::moveBody(const std::size_t& fromIndex,
+                                                   const std::size_t& toIndex)
+{
+    m_positions.copyVector(fromIndex,toIndex);
+    m_velocities.copyVector(fromIndex,toIndex);
+    m_rotQtns.copyQuaternion(fromIndex,toIndex);
+    m_angularVelocities.copyVector(fromIndex,toIndex);
+    m_masses[toIndex] = m_masses[fromIndex];
+    m_inverseMasses[toIndex] = m_inverseMasses[fromIndex];
+    m_inertias.copyMatrix(fromIndex,toIndex);
+    m_inertiaInverses.copyMatrix(fromIndex,toIndex);
+    m_dampingCoefficients[toIndex] = m_dampingCoefficients[fromIndex];
+    m_angularDampingCoefficients[toIndex] = m_angularDampingCoefficients[fromIndex];
+    m_totalForces.copyVector(fromIndex,toIndex);
+    m_totalTorques.copyVector(fromIndex,toIndex);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::popBody()
+{
+    m_positions.pop_back();
+    m_velocities.pop_back();
+    m_rotQtns.pop_back();
+    m_angularVelocities.pop_back();
+    m_masses.pop_back();
+    m_inverseMasses.pop_back();
+    m_inertias.pop_back();
+    m_inertiaInverses.pop_back();
+    m_dampingCoefficients.pop_back();
+    m_angularDampingCoefficients.pop_back();
+    m_totalForces.pop_back();
+    m_totalTorques.pop_back();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::reserve(const std::size_t& numberOfBodies)
+{
+    m_positions.reserve(numberOfBodies);
+    m_velocities.reserve(numberOfBodies);
+    m_rotQtns.reserve(numberOfBodies);
+    m_angularVelocities.reserve(numberOfBodies);
+    m_masses.reserve(numberOfBodies);
+    m_inverseMasses.reserve(numberOfBodies);
+    m_inertias.reserve(numberOfBodies);
+    m_inertiaInverses.reserve(numberOfBodies);
+    m_dampingCoefficients.reserve(numberOfBodies);
+    m_angularDampingCoefficients.reserve(numberOfBodies);
+    m_totalForces.reserve(numberOfBodies);
+    m_totalTorques.reserve(numberOfBodies);
+
+    m_handleToIndex.reserve(numberOfBodies);
+    m_indexToHandle.reserve(numberOfBodies);
+    m_handleGenerations.reserve(numberOfBodies);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blRigidBodyWorld<blDataType>::getNumberOfBodies()const
+{
+    return m_inverseMasses.size();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline bool blRigidBodyWorld<blDataType>::isHandleValid(const blBodyHandle& bodyHandle)const
+{
+    std::size_t slot = getHandleSlot(bodyHandle);
+
+    return (slot < m_handleToIndex.size() &&
+            m_handleGenerations[slot] == std::uint32_t(bodyHandle >> 32) &&
+            m_handleToIndex[slot] < m_inverseMasses.size());
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blRigidBodyWorld<blDataType>::getBodyIndex(const blBodyHandle& bodyHandle)const
+{
+    assert(isHandleValid(bodyHandle) && "blRigidBodyWorld: invalid or stale body handle");
+
+    return m_handleToIndex[getHandleSlot(bodyHandle)];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBodyWorld<blDataType>::blBodyHandle blRigidBodyWorld<blDataType>::getBodyHandle(const std::size_t& bodyIndex)const
+{
+    return m_indexToHandle[bodyIndex];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blRigidBodyWorld<blDataType>::getHandleSlot(const blBodyHandle& bodyHandle)
+{
+    return std::size_t(bodyHandle & 0xffffffff);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blRigidBodyWorld<blDataType>::getNumberOfHandleSlots()const
+{
+    return m_handleToIndex.size();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBodyWorld<blDataType>::blVectorType blRigidBodyWorld<blDataType>::getPosition(const blBodyHandle& bodyHandle)const
+{
+    return m_positions.getVector(getBodyIndex(bodyHandle));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBodyWorld<blDataType>::blVectorType blRigidBodyWorld<blDataType>::getVelocity(const blBodyHandle& bodyHandle)const
+{
+    return m_velocities.getVector(getBodyIndex(bodyHandle));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBodyWorld<blDataType>::blQuaternionType blRigidBodyWorld<blDataType>::getRotQtn(const blBodyHandle& bodyHandle)const
+{
+    return m_rotQtns.getQuaternion(getBodyIndex(bodyHandle));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blRigidBodyWorld<blDataType>::blVectorType blRigidBodyWorld<blDataType>::getAngularVelocity(const blBodyHandle& bodyHandle)const
+{
+    return m_angularVelocities.getVector(getBodyIndex(bodyHandle));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blRigidBodyWorld<blDataType>::getMass(const blBodyHandle& bodyHandle)const
+{
+    return m_masses[getBodyIndex(bodyHandle)];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blRigidBodyWorld<blDataType>::getInverseMass(const blBodyHandle& bodyHandle)const
+{
+    return m_inverseMasses[getBodyIndex(bodyHandle)];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blRigidBodyWorld<blDataType>::getDampingCoefficient(const blBodyHandle& bodyHandle)const
+{
+    return m_dampingCoefficients[getBodyIndex(bodyHandle)];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blRigidBodyWorld<blDataType>::getAngularDampingCoefficient(const blBodyHandle& bodyHandle)const
+{
+    return m_angularDampingCoefficients[getBodyIndex(bodyHandle)];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::setPosition(const blBodyHandle& bodyHandle,
+                                                      const blVectorType& position)
+{
+    m_positions.setVector(getBodyIndex(bodyHandle),position);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::setVelocity(const blBodyHandle& bodyHandle,
+                                                      const blVectorType& velocity)
+{
+    m_velocities.setVector(getBodyIndex(bodyHandle),velocity);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::setRotQtn(const blBodyHandle& bodyHandle,
+                                                    const blQuaternionType& rotQtn)
+{
+    m_rotQtns.setQuaternion(getBodyIndex(bodyHandle),rotQtn);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::setAngularVelocity(const blBodyHandle& bodyHandle,
+                                                             const blVectorType& angularVelocity)
+{
+    m_angularVelocities.setVector(getBodyIndex(bodyHandle),angularVelocity);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::setMass(const blBodyHandle& bodyHandle,
+                                                  const blDataType& mass)
+{
+    std::size_t bodyIndex = getBodyIndex(bodyHandle);
+
+    m_masses[bodyIndex] = (mass > 0 ? mass : blDataType(0));
+    m_inverseMasses[bodyIndex] = (mass > 0 ? blDataType(1)/mass : blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::setInertia(const blBodyHandle& bodyHandle,
+                                                     const blMatrixType& inertia,
+                                                     const blMatrixType& inertiaInverse)
+{
+    m_inertias.setMatrix(getBodyIndex(bodyHandle),inertia);
+    m_inertiaInverses.setMatrix(getBodyIndex(bodyHandle),inertiaInverse);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::setDampingCoefficients(const blBodyHandle& bodyHandle,
+                                                                 const blDataType& dampingCoefficient,
+                                                                 const blDataType& angularDampingCoefficient)
+{
+    m_dampingCoefficients[getBodyIndex(bodyHandle)] = dampingCoefficient;
+    m_angularDampingCoefficients[getBodyIndex(bodyHandle)] = angularDampingCoefficient;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::addForce(const blBodyHandle& bodyHandle,
+                                                   const blVectorType& force)
+{
+    m_totalForces.addToVector(getBodyIndex(bodyHandle),force);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::addTorque(const blBodyHandle& bodyHandle,
+                                                    const blVectorType& torque)
+{
+    m_totalTorques.addToVector(getBodyIndex(bodyHandle),torque);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::addForceAndTorque(const blBodyHandle& bodyHandle,
+                                                            const blVectorType& force,
+                                                            const blVectorType& forcePosition)
+{
+    std::size_t bodyIndex = getBodyIndex(bodyHandle);
+
+    m_totalForces.addToVector(bodyIndex,force);
+    m_totalTorques.addToVector(bodyIndex,
+                               crossProduct(forcePosition - m_positions.getVector(bodyIndex),force));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::clearForcesAndTorques()
+{
+    m_totalForces.setToZero();
+    m_totalTorques.setToZero();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::copyStateToRigidBody(const blBodyHandle& bodyHandle,
+                                                               blRigidBody<blDataType>& rigidBody)const
+{
+    std::size_t bodyIndex = getBodyIndex(bodyHandle);
+
+    // We translate and
+    // rotate the body
+    // instead of setting
+    // its position/orientation
+    // so that its starting
+    // position/rotation,
+    // used by the motion
+    // limits, is preserved
+
+    rigidBody.translate(m_positions.getVector(bodyIndex) - rigidBody.getPosition());
+    rigidBody.rotate(m_rotQtns.getQuaternion(bodyIndex) * rigidBody.getRotQtn().getConjugate());
+
+    rigidBody.setVelocity(m_velocities.getVector(bodyIndex));
+    rigidBody.setAngularVelocity(m_angularVelocities.getVector(bodyIndex));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::setAdditionalField(const blVectorType& additionalField)
+{
+    m_additionalField = additionalField;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const typename blRigidBodyWorld<blDataType>::blVectorType& blRigidBodyWorld<blDataType>::getAdditionalField()const
+{
+    return m_additionalField;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blRigidBodyWorld<blDataType>::integrate(const sf::Time& timeStep,
+                                                   const int& integrationMethod)
+{
+    blDataType dt = timeStep.asSeconds();
+    std::size_t numberOfBodies = getNumberOfBodies();
+
+    // The position and
+    // orientation passes
+    // use the velocities
+    // from the beginning
+    // of the step, just
+    // like the Euler method
+    // in blRigidBody
+
+    if(integrationMethod == BL_RK4)
+    {
+        blBatchIntegrator<blDataType>::integratePositionsRK4(m_positions,m_velocities,m_totalForces,m_inverseMasses,
+                                                             m_additionalField,dt,0,numberOfBodies);
+    }
+    else
+    {
+        blBatchIntegrator<blDataType>::integratePositions(m_positions,m_velocities,dt,0,numberOfBodies);
+    }
+
+    blBatchIntegrator<blDataType>::integrateVelocities(m_velocities,m_totalForces,m_inverseMasses,
+                                                       m_additionalField,dt,0,numberOfBodies);
+
+    // The inertias in system
+    // coordinates are taken
+    // before the bodies rotate
+
+    m_worldInertias.resize(numberOfBodies);
+    m_worldInertiaInverses.resize(numberOfBodies);
+
+    blBatchIntegrator<blDataType>::calculateWorldInertias(m_rotQtns,m_inertias,m_inertiaInverses,
+                                                          m_worldInertias,m_worldInertiaInverses,
+                                                          0,numberOfBodies);
+
+    blBatchIntegrator<blDataType>::integrateOrientations(m_rotQtns,m_angularVelocities,dt,0,numberOfBodies);
+
+    blBatchIntegrator<blDataType>::integrateAngularVelocities(m_angularVelocities,m_totalTorques,
+                                                              m_worldInertias,m_worldInertiaInverses,
+                                                              dt,0,numberOfBodies);
+
+    // The damping decays the
+    // new velocities exactly
+    // over the step, the
+    // angular ones along the
+    // rotated body axes
+
+    blBatchIntegrator<blDataType>::integrateDamping(m_velocities,m_angularVelocities,m_rotQtns,
+                                                    m_inverseMasses,m_inertiaInverses,
+                                                    m_dampingCoefficients,m_angularDampingCoefficients,
+                                                    dt,0,numberOfBodies);
+
+    clearForcesAndTorques();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blVector3dArray<blDataType>& blRigidBodyWorld<blDataType>::getPositions()
+{
+    return m_positions;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blVector3dArray<blDataType>& blRigidBodyWorld<blDataType>::getVelocities()
+{
+    return m_velocities;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blQuaternionArray<blDataType>& blRigidBodyWorld<blDataType>::getRotQtns()
+{
+    return m_rotQtns;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blVector3dArray<blDataType>& blRigidBodyWorld<blDataType>::getAngularVelocities()
+{
+    return m_angularVelocities;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blRigidBodyWorld<blDataType>::getMasses()
+{
+    return m_masses;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blRigidBodyWorld<blDataType>::getInverseMasses()
+{
+    return m_inverseMasses;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blMatrix3dArray<blDataType>& blRigidBodyWorld<blDataType>::getInertias()
+{
+    return m_inertias;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blMatrix3dArray<blDataType>& blRigidBodyWorld<blDataType>::getInertiaInverses()
+{
+    return m_inertiaInverses;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blRigidBodyWorld<blDataType>::getDampingCoefficients()
+{
+    return m_dampingCoefficients;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blRigidBodyWorld<blDataType>::getAngularDampingCoefficients()
+{
+    return m_angularDampingCoefficients;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blVector3dArray<blDataType>& blRigidBodyWorld<blDataType>::getTotalForces()
+{
+    return m_totalForces;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blVector3dArray<blDataType>& blRigidBodyWorld<blDataType>::getTotalTorques()
+{
+    return m_totalTorques;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blVector3dArray<blDataType>& blRigidBodyWorld<blDataType>::getPositions()const
+{
+    return m_positions;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blVector3dArray<blDataType>& blRigidBodyWorld<blDataType>::getVelocities()const
+{
+    return m_velocities;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blQuaternionArray<blDataType>& blRigidBodyWorld<blDataType>::getRotQtns()const
+{
+    return m_rotQtns;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blVector3dArray<blDataType>& blRigidBodyWorld<blDataType>::getAngularVelocities()const
+{
+    return m_angularVelocities;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blRigidBodyWorld<blDataType>::getMasses()const
+{
+    return m_masses;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blRigidBodyWorld<blDataType>::getInverseMasses()const
+{
+    return m_inverseMasses;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blMatrix3dArray<blDataType>& blRigidBodyWorld<blDataType>::getInertias()const
+{
+    return m_inertias;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blMatrix3dArray<blDataType>& blRigidBodyWorld<blDataType>::getInertiaInverses()const
+{
+    return m_inertiaInverses;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blRigidBodyWorld<blDataType>::getDampingCoefficients()const
+{
+    return m_dampingCoefficients;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blRigidBodyWorld<blDataType>::getAngularDampingCoefficients()const
+{
+    return m_angularDampingCoefficients;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blVector3dArray<blDataType>& blRigidBodyWorld<blDataType>::getTotalForces()const
+{
+    return m_totalForces;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blVector3dArray<blDataType>& blRigidBodyWorld<blDataType>::getTotalTorques()const
+{
+    return m_totalTorques;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blMatrix3dArray<blDataType>& blRigidBodyWorld<blDataType>::getWorldInertias()const
+{
+    return m_worldInertias;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blMatrix3dArray<blDataType>& blRigidBodyWorld<blDataType>::getWorldInertiaInverses()const
+{
+    return m_worldInertiaInverses;
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_RIGIDBODYWORLD_HPP
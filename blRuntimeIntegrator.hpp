@@ -0,0 +1,77 @@
+#ifndef BL_RUNTIMEINTEGRATOR_HPP
+#define BL_RUNTIMEINTEGRATOR_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blRuntimeIntegrator.hpp
+// CLASS:           blRuntimeIntegrator
+// BASE CLASS:      None
+//
+// PURPOSE:         An integrator policy that picks the integration
+//                  method at run time, it forwards to the rigid body's
+//                  virtual simulateRigidBody function
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blRigidBody
+//
+// NOTES:           - This is the default policy of blRigidBodySystem,
+//                    it keeps the BL_EULER/BL_RK4/BL_VERLET/
+//                    BL_IMPLICIT_EULER switch and any overridden
+//                    simulateRigidBody working
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+class blRuntimeIntegrator
+{
+public: // Public variables
+
+    // The system's integration
+    // method is used
+
+    enum {isRuntimeSelected = 1};
+
+public: // Public functions
+
+    // Function used to
+    // simulate a rigid
+    // body for one step
+
+    template<typename blDataType>
+    static void                                         simulate(blRigidBody<blDataType>& rigidBody,
+                                                                 const sf::Time& timeStep,
+                                                                 const sf::Time& totalTime,
+                                                                 const blMathAPI::blVector3d<blDataType>& accelerationField,
+                                                                 const int& integrationMethod)
+    {
+        rigidBody.simulateRigidBody(timeStep,
+                                    totalTime,
+                                    accelerationField,
+                                    integrationMethod);
+    }
+};
+//-------------------------------------------------------------------
+
+
+#endif // BL_RUNTIMEINTEGRATOR_HPP
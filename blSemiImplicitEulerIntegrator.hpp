@@ -0,0 +1,126 @@
+#ifndef BL_SEMIIMPLICITEULERINTEGRATOR_HPP
+#define BL_SEMIIMPLICITEULERINTEGRATOR_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blSemiImplicitEulerIntegrator.hpp
+// CLASS:           blSemiImplicitEulerIntegrator
+// BASE CLASS:      blIntegratorPolicy
+//
+// PURPOSE:         Based on blIntegratorPolicy, it integrates a rigid
+//                  body's state using the semi-implicit Euler
+//                  (leapfrog) method, velocities are updated first
+//                  and the new velocities move the body
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blIntegratorPolicy
+//
+// NOTES:           - Also used by blRigidBody for BL_VERLET
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+class blSemiImplicitEulerIntegrator : public blIntegratorPolicy<blSemiImplicitEulerIntegrator>
+{
+public: // Public functions
+
+    // Function used to
+    // calculate the new
+    // state of a rigid
+    // body
+
+    template<typename blDataType>
+    static void                                         integrateState(blRigidBody<blDataType>& rigidBody,
+                                                                       const sf::Time& timeStep,
+                                                                       const blMathAPI::blVector3d<blDataType>& accelerationField);
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSemiImplicitEulerIntegrator::integrateState(blRigidBody<blDataType>& rigidBody,
+                                                          const sf::Time& timeStep,
+                                                          const blMathAPI::blVector3d<blDataType>& accelerationField)
+{
+    // This is the leapfrog
+    // (kick-drift) form of
+    // velocity Verlet, which
+    // only needs the forces
+    // at the current state
+    //
+    // v(t+dt) = v(t) + a(t)*dt
+    // x(t+dt) = x(t) + v(t+dt)*dt
+
+    blDataType dt = blDataType(timeStep.asSeconds());
+
+    // Step 1:  Kick the
+    //          velocity
+
+    rigidBody.changeVelocity((rigidBody.getTotalForce()/rigidBody.getMass() + accelerationField) * dt);
+
+    // Step 2:  Kick the
+    //          angular velocity,
+    //          the inertia is
+    //          taken in system
+    //          coordinates like
+    //          the angular velocity
+    //          and the torque
+
+    rigidBody.changeAngularVelocity(rigidBody.applyWorldInertiaInverse(rigidBody.getTotalTorque() -
+                                                                       crossProduct(rigidBody.getAngularVelocity(),rigidBody.applyWorldInertia(rigidBody.getAngularVelocity()))) *
+                                    dt);
+
+    // Step 3:  Drift the
+    //          position with
+    //          the new velocity
+
+    blMathAPI::blVector3d<blDataType> positionStep = rigidBody.getVelocity() * dt;
+
+    rigidBody.blPosition<blDataType>::translate(positionStep.x(),
+                                                positionStep.y(),
+                                                positionStep.z());
+
+    // Step 4:  Drift the
+    //          orientation with
+    //          the new angular
+    //          velocity, rotating
+    //          by |w|*dt about w
+
+    blDataType angularSpeed = blMathAPI::norm2(rigidBody.getAngularVelocity());
+
+    if(angularSpeed > 0)
+    {
+        blDataType theta = angularSpeed * dt;
+
+        blMathAPI::blQuaternion<blDataType> angVelQtn(std::cos(theta/blDataType(2)),
+                                                      rigidBody.getAngularVelocity() * (std::sin(theta/blDataType(2)) / angularSpeed));
+
+        rigidBody.blOrientation<blDataType>::rotate(angVelQtn);
+    }
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_SEMIIMPLICITEULERINTEGRATOR_HPP
@@ -0,0 +1,226 @@
+#ifndef BL_SIMDPACK_HPP
+#define BL_SIMDPACK_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blSimdPack.hpp
+// CLASS:           blScalarPack
+//                  blSimdPack
+// BASE CLASS:      None
+//
+// PURPOSE:         Thin wrappers around SIMD registers used to
+//                  write batch kernels once and compile them for
+//                  AVX2, SSE2 or plain scalar code
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - immintrin.h/emmintrin.h when compiled with
+//                    AVX2/SSE2 support (included by blRigidBodyAPI.hpp)
+//
+// NOTES:           - blScalarPack works on one value at a time and
+//                    is used both as the fallback and to process the
+//                    tail of a batch that doesn't fill a register
+//                  - blSimdPack<float> and blSimdPack<double> are
+//                    specialized for AVX2 when BL_RIGIDBODYAPI_USE_AVX2
+//                    is defined, or for SSE2 when BL_RIGIDBODYAPI_USE_SSE2
+//                    is defined, otherwise they fall back to blScalarPack
+//                  - Loads and stores are unaligned, since the arrays
+//                    come from std::vectors
+//                  - mulAdd is a separate multiply and add, not a
+//                    fused one, so that lanes processed by a register
+//                    and lanes processed by the scalar tail round
+//                    the same way
+//                  - SSE2 has no floor instruction, floor is done by
+//                    truncating to integers and stepping down where
+//                    that rounded up, so it needs |a| < 2^31
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blScalarPack
+{
+public: // Public typedefs
+
+    typedef blDataType                                  blRegisterType;
+
+    // Number of values
+    // held in a register
+
+    enum {width = 1};
+
+public: // Public functions
+
+    static blRegisterType                               set1(const blDataType& value){return value;}
+    static blRegisterType                               load(const blDataType* data){return *data;}
+    static void                                         store(blDataType* data,const blRegisterType& value){*data = value;}
+
+    static blRegisterType                               add(const blRegisterType& a,const blRegisterType& b){return a + b;}
+    static blRegisterType                               sub(const blRegisterType& a,const blRegisterType& b){return a - b;}
+    static blRegisterType                               mul(const blRegisterType& a,const blRegisterType& b){return a * b;}
+    static blRegisterType                               div(const blRegisterType& a,const blRegisterType& b){return a / b;}
+    static blRegisterType                               sqrt(const blRegisterType& a){return std::sqrt(a);}
+    static blRegisterType                               max(const blRegisterType& a,const blRegisterType& b){return std::max(a,b);}
+    static blRegisterType                               floor(const blRegisterType& a){return std::floor(a);}
+
+    // a * b + c
+
+    static blRegisterType                               mulAdd(const blRegisterType& a,const blRegisterType& b,const blRegisterType& c){return a * b + c;}
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blSimdPack : public blScalarPack<blDataType>
+{
+};
+//-------------------------------------------------------------------
+
+
+#if defined(BL_RIGIDBODYAPI_USE_AVX2)
+
+
+//-------------------------------------------------------------------
+template<>
+class blSimdPack<float>
+{
+public: // Public typedefs
+
+    typedef __m256                                      blRegisterType;
+
+    enum {width = 8};
+
+public: // Public functions
+
+    static blRegisterType                               set1(const float& value){return _mm256_set1_ps(value);}
+    static blRegisterType                               load(const float* data){return _mm256_loadu_ps(data);}
+    static void                                         store(float* data,const blRegisterType& value){_mm256_storeu_ps(data,value);}
+
+    static blRegisterType                               add(const blRegisterType& a,const blRegisterType& b){return _mm256_add_ps(a,b);}
+    static blRegisterType                               sub(const blRegisterType& a,const blRegisterType& b){return _mm256_sub_ps(a,b);}
+    static blRegisterType                               mul(const blRegisterType& a,const blRegisterType& b){return _mm256_mul_ps(a,b);}
+    static blRegisterType                               div(const blRegisterType& a,const blRegisterType& b){return _mm256_div_ps(a,b);}
+    static blRegisterType                               sqrt(const blRegisterType& a){return _mm256_sqrt_ps(a);}
+    static blRegisterType                               max(const blRegisterType& a,const blRegisterType& b){return _mm256_max_ps(a,b);}
+    static blRegisterType                               floor(const blRegisterType& a){return _mm256_floor_ps(a);}
+
+    static blRegisterType                               mulAdd(const blRegisterType& a,const blRegisterType& b,const blRegisterType& c){return _mm256_add_ps(_mm256_mul_ps(a,b),c);}
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<>
+class blSimdPack<double>
+{
+public: // Public typedefs
+
+    typedef __m256d                                     blRegisterType;
+
+    enum {width = 4};
+
+public: // Public functions
+
+    static blRegisterType                               set1(const double& value){return _mm256_set1_pd(value);}
+    static blRegisterType                               load(const double* data){return _mm256_loadu_pd(data);}
+    static void                                         store(double* data,const blRegisterType& value){_mm256_storeu_pd(data,value);}
+
+    static blRegisterType                               add(const blRegisterType& a,const blRegisterType& b){return _mm256_add_pd(a,b);}
+    static blRegisterType                               sub(const blRegisterType& a,const blRegisterType& b){return _mm256_sub_pd(a,b);}
+    static blRegisterType                               mul(const blRegisterType& a,const blRegisterType& b){return _mm256_mul_pd(a,b);}
+    static blRegisterType                               div(const blRegisterType& a,const blRegisterType& b){return _mm256_div_pd(a,b);}
+    static blRegisterType                               sqrt(const blRegisterType& a){return _mm256_sqrt_pd(a);}
+    static blRegisterType                               max(const blRegisterType& a,const blRegisterType& b){return _mm256_max_pd(a,b);}
+    static blRegisterType                               floor(const blRegisterType& a){return _mm256_floor_pd(a);}
+
+    static blRegisterType                               mulAdd(const blRegisterType& a,const blRegisterType& b,const blRegisterType& c){return _mm256_add_pd(_mm256_mul_pd(a,b),c);}
+};
+//-------------------------------------------------------------------
+
+
+#elif defined(BL_RIGIDBODYAPI_USE_SSE2)
+
+
+//-------------------------------------------------------------------
+template<>
+class blSimdPack<float>
+{
+public: // Public typedefs
+
+    typedef __m128                                      blRegisterType;
+
+    enum {width = 4};
+
+public: // Public functions
+
+    static blRegisterType                               set1(const float& value){return _mm_set1_ps(value);}
+    static blRegisterType                               load(const float* data){return _mm_loadu_ps(data);}
+    static void                                         store(float* data,const blRegisterType& value){_mm_storeu_ps(data,value);}
+
+    static blRegisterType                               add(const blRegisterType& a,const blRegisterType& b){return _mm_add_ps(a,b);}
+    static blRegisterType                               sub(const blRegisterType& a,const blRegisterType& b){return _mm_sub_ps(a,b);}
+    static blRegisterType                               mul(const blRegisterType& a,const blRegisterType& b){return _mm_mul_ps(a,b);}
+    static blRegisterType                               div(const blRegisterType& a,const blRegisterType& b){return _mm_div_ps(a,b);}
+    static blRegisterType                               sqrt(const blRegisterType& a){return _mm_sqrt_ps(a);}
+    static blRegisterType                               max(const blRegisterType& a,const blRegisterType& b){return _mm_max_ps(a,b);}
+    static blRegisterType                               floor(const blRegisterType& a){blRegisterType t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a)); return _mm_sub_ps(t,_mm_and_ps(_mm_cmpgt_ps(t,a),_mm_set1_ps(1.0f)));}
+
+    static blRegisterType                               mulAdd(const blRegisterType& a,const blRegisterType& b,const blRegisterType& c){return _mm_add_ps(_mm_mul_ps(a,b),c);}
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<>
+class blSimdPack<double>
+{
+public: // Public typedefs
+
+    typedef __m128d                                     blRegisterType;
+
+    enum {width = 2};
+
+public: // Public functions
+
+    static blRegisterType                               set1(const double& value){return _mm_set1_pd(value);}
+    static blRegisterType                               load(const double* data){return _mm_loadu_pd(data);}
+    static void                                         store(double* data,const blRegisterType& value){_mm_storeu_pd(data,value);}
+
+    static blRegisterType                               add(const blRegisterType& a,const blRegisterType& b){return _mm_add_pd(a,b);}
+    static blRegisterType                               sub(const blRegisterType& a,const blRegisterType& b){return _mm_sub_pd(a,b);}
+    static blRegisterType                               mul(const blRegisterType& a,const blRegisterType& b){return _mm_mul_pd(a,b);}
+    static blRegisterType                               div(const blRegisterType& a,const blRegisterType& b){return _mm_div_pd(a,b);}
+    static blRegisterType                               sqrt(const blRegisterType& a){return _mm_sqrt_pd(a);}
+    static blRegisterType                               max(const blRegisterType& a,const blRegisterType& b){return _mm_max_pd(a,b);}
+    static blRegisterType                               floor(const blRegisterType& a){blRegisterType t = _mm_cvtepi32_pd(_mm_cvttpd_epi32(a)); return _mm_sub_pd(t,_mm_and_pd(_mm_cmpgt_pd(t,a),_mm_set1_pd(1.0)));}
+
+    static blRegisterType                               mulAdd(const blRegisterType& a,const blRegisterType& b,const blRegisterType& c){return _mm_add_pd(_mm_mul_pd(a,b),c);}
+};
+//-------------------------------------------------------------------
+
+
+#endif
+
+
+#endif // BL_SIMDPACK_HPP
@@ -64,6 +64,16 @@ public: // Constructors and destructors
 
     blSize(const blSize<blDataType>& size);
 
+    // Move constructor
+
+    blSize(blSize<blDataType>&& size) = default;
+
+    // Copy and move
+    // assignments
+
+    blSize<blDataType>&                                         operator=(const blSize<blDataType>& size) = default;
+    blSize<blDataType>&                                         operator=(blSize<blDataType>&& size) = default;
+
     // Destructor
 
     ~blSize()
@@ -0,0 +1,174 @@
+#ifndef BL_SLEEPING_HPP
+#define BL_SLEEPING_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blSleeping.hpp
+// CLASS:           blSleeping
+// BASE CLASS:      None
+//
+// PURPOSE:         A base class to let an object at rest fall
+//                  asleep, so it can be skipped by the simulation
+//                  until something wakes it up
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:
+//
+// NOTES:           - Waking an object up resets the time it has
+//                    spent at rest
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blSleeping
+{
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blSleeping(const bool& isAwake = true);
+
+    // Copy constructor
+
+    blSleeping(const blSleeping<blDataType>& sleeping);
+
+    // Move constructor
+
+    blSleeping(blSleeping<blDataType>&& sleeping) = default;
+
+    // Copy and move
+    // assignments
+
+    blSleeping<blDataType>&                                     operator=(const blSleeping<blDataType>& sleeping) = default;
+    blSleeping<blDataType>&                                     operator=(blSleeping<blDataType>&& sleeping) = default;
+
+    // Destructor
+
+    ~blSleeping()
+    {
+    }
+
+public: // Public function
+
+    // Functions used to
+    // put the object to
+    // sleep/wake it up
+
+    void                                                        setIsAwake(const bool& isAwake);
+    const bool&                                                 getIsAwake()const;
+
+    void                                                        wakeUp();
+
+    // Functions used to
+    // set/get how long the
+    // object has been at
+    // rest
+
+    void                                                        setSleepTime(const blDataType& sleepTime);
+    const blDataType&                                           getSleepTime()const;
+
+private: // Private variables
+
+    // Whether the object
+    // is awake and for how
+    // long it has been
+    // at rest
+
+    bool                                                        m_isAwake;
+    blDataType                                                  m_sleepTime;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blSleeping<blDataType>::blSleeping(const bool& isAwake)
+{
+    m_isAwake = isAwake;
+    m_sleepTime = 0;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blSleeping<blDataType>::blSleeping(const blSleeping<blDataType>& sleeping)
+{
+    m_isAwake = sleeping.getIsAwake();
+    m_sleepTime = sleeping.getSleepTime();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSleeping<blDataType>::setIsAwake(const bool& isAwake)
+{
+    if(isAwake && !m_isAwake)
+        m_sleepTime = 0;
+
+    m_isAwake = isAwake;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const bool& blSleeping<blDataType>::getIsAwake()const
+{
+    return m_isAwake;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSleeping<blDataType>::wakeUp()
+{
+    m_isAwake = true;
+    m_sleepTime = 0;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSleeping<blDataType>::setSleepTime(const blDataType& sleepTime)
+{
+    m_sleepTime = sleepTime;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blSleeping<blDataType>::getSleepTime()const
+{
+    return m_sleepTime;
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_SLEEPING_HPP
@@ -0,0 +1,339 @@
+#ifndef BL_SPARSEBLOCKMATRIX_HPP
+#define BL_SPARSEBLOCKMATRIX_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blSparseBlockMatrix.hpp
+// CLASS:           blSparseBlockMatrix
+// BASE CLASS:      None
+//
+// PURPOSE:         A sparse square matrix made of 3x3 blocks, one
+//                  block row/column per body, used to assemble the
+//                  linear system solved by implicit integration
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - std::vector
+//                  - std::algorithm
+//
+// NOTES:           - The diagonal blocks are stored apart, one per
+//                    row, the off-diagonal blocks are added in any
+//                    order and finalize() sorts them by row/column,
+//                    adds up repeated ones and builds the row starts
+//                  - multiply() works on a range of rows so the rows
+//                    can be split across the workers of an executor,
+//                    each row only writes its own result
+//                  - Blocks are plain 3x3 arrays, the matrix never
+//                    needs blMathAPI matrices
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blSparseBlockMatrix
+{
+public: // Public typedefs
+
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+
+    // A 3x3 block
+
+    struct blBlock
+    {
+        blDataType                                      m_values[3][3];
+    };
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blSparseBlockMatrix();
+
+    // Destructor
+
+    ~blSparseBlockMatrix()
+    {
+    }
+
+public: // Public functions
+
+    // Function used to empty
+    // the matrix and size it
+    // to a number of block rows
+
+    void                                                reset(const std::size_t& numberOfRows);
+
+    // Function used to get
+    // the number of block rows
+
+    std::size_t                                         getNumberOfRows()const;
+
+    // Functions used to add
+    // to the blocks, addBlock
+    // adds scale*block at row
+    // and column
+
+    void                                                addToDiagonal(const std::size_t& row,
+                                                                      const blDataType& value);
+
+    void                                                addBlock(const std::size_t& row,
+                                                                 const std::size_t& column,
+                                                                 const blDataType (&block)[3][3],
+                                                                 const blDataType& scale);
+
+    // Function used to get the
+    // matrix ready to multiply
+    // after all the blocks
+    // have been added
+
+    void                                                finalize();
+
+    // Function used to get
+    // a diagonal block
+
+    const blBlock&                                      getDiagonalBlock(const std::size_t& row)const;
+
+    // Function used to
+    // calculate y = A*x
+    // for a range of rows
+
+    void                                                multiply(const std::vector<blVectorType>& x,
+                                                                 std::vector<blVectorType>& y,
+                                                                 const std::size_t& beginRow,
+                                                                 const std::size_t& endRow)const;
+
+    // Function used to
+    // calculate block*x
+
+    static blVectorType                                 multiplyBlock(const blBlock& block,
+                                                                      const blVectorType& x);
+
+private: // Private types
+
+    // An off-diagonal block
+
+    struct blEntry
+    {
+        std::size_t                                     m_row;
+        std::size_t                                     m_column;
+        blBlock                                         m_block;
+    };
+
+private: // Private variables
+
+    // The diagonal blocks
+
+    std::vector<blBlock>                                m_diagonalBlocks;
+
+    // The off-diagonal blocks,
+    // sorted by row/column once
+    // the matrix is finalized
+
+    std::vector<blEntry>                                m_entries;
+
+    // Where each row's blocks
+    // start in the entries
+
+    std::vector<std::size_t>                            m_rowStarts;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blSparseBlockMatrix<blDataType>::blSparseBlockMatrix()
+{
+    // The matrix starts empty,
+    // without allocating, until
+    // it's reset to a size
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSparseBlockMatrix<blDataType>::reset(const std::size_t& numberOfRows)
+{
+    blBlock zeroBlock = {{{0,0,0},{0,0,0},{0,0,0}}};
+
+    m_diagonalBlocks.assign(numberOfRows,zeroBlock);
+    m_entries.clear();
+    m_rowStarts.assign(numberOfRows + 1,0);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blSparseBlockMatrix<blDataType>::getNumberOfRows()const
+{
+    return m_diagonalBlocks.size();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSparseBlockMatrix<blDataType>::addToDiagonal(const std::size_t& row,
+                                                           const blDataType& value)
+{
+    for(int i = 0; i < 3; ++i)
+        m_diagonalBlocks[row].m_values[i][i] += value;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSparseBlockMatrix<blDataType>::addBlock(const std::size_t& row,
+                                                      const std::size_t& column,
+                                                      const blDataType (&block)[3][3],
+                                                      const blDataType& scale)
+{
+    blBlock* target;
+
+    if(row == column)
+    {
+        target = &m_diagonalBlocks[row];
+    }
+    else
+    {
+        blEntry entry;
+        entry.m_row = row;
+        entry.m_column = column;
+
+        m_entries.push_back(entry);
+
+        target = &m_entries.back().m_block;
+
+        for(int i = 0; i < 3; ++i)
+            for(int j = 0; j < 3; ++j)
+                target->m_values[i][j] = 0;
+    }
+
+    for(int i = 0; i < 3; ++i)
+        for(int j = 0; j < 3; ++j)
+            target->m_values[i][j] += block[i][j] * scale;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSparseBlockMatrix<blDataType>::finalize()
+{
+    // Step 1:  Sort the blocks
+    //          by row and column
+
+    std::sort(m_entries.begin(),
+              m_entries.end(),
+              [](const blEntry& entry1,const blEntry& entry2)
+              {
+                  return entry1.m_row < entry2.m_row ||
+                         (entry1.m_row == entry2.m_row && entry1.m_column < entry2.m_column);
+              });
+
+    // Step 2:  Add up the blocks
+    //          at the same row and
+    //          column, many springs
+    //          can join the same two
+    //          bodies
+
+    std::size_t numberOfEntries = 0;
+
+    for(std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if(numberOfEntries > 0 &&
+           m_entries[numberOfEntries - 1].m_row == m_entries[i].m_row &&
+           m_entries[numberOfEntries - 1].m_column == m_entries[i].m_column)
+        {
+            for(int j = 0; j < 3; ++j)
+                for(int k = 0; k < 3; ++k)
+                    m_entries[numberOfEntries - 1].m_block.m_values[j][k] += m_entries[i].m_block.m_values[j][k];
+        }
+        else
+        {
+            m_entries[numberOfEntries] = m_entries[i];
+            ++numberOfEntries;
+        }
+    }
+
+    m_entries.resize(numberOfEntries);
+
+    // Step 3:  Count the blocks
+    //          of each row and turn
+    //          the counts into starts
+
+    std::fill(m_rowStarts.begin(),m_rowStarts.end(),0);
+
+    for(std::size_t i = 0; i < m_entries.size(); ++i)
+        ++m_rowStarts[m_entries[i].m_row + 1];
+
+    for(std::size_t row = 1; row < m_rowStarts.size(); ++row)
+        m_rowStarts[row] += m_rowStarts[row - 1];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const typename blSparseBlockMatrix<blDataType>::blBlock& blSparseBlockMatrix<blDataType>::getDiagonalBlock(const std::size_t& row)const
+{
+    return m_diagonalBlocks[row];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSparseBlockMatrix<blDataType>::multiply(const std::vector<blVectorType>& x,
+                                                      std::vector<blVectorType>& y,
+                                                      const std::size_t& beginRow,
+                                                      const std::size_t& endRow)const
+{
+    for(std::size_t row = beginRow; row < endRow; ++row)
+    {
+        blVectorType sum = multiplyBlock(m_diagonalBlocks[row],x[row]);
+
+        for(std::size_t i = m_rowStarts[row]; i < m_rowStarts[row + 1]; ++i)
+            sum += multiplyBlock(m_entries[i].m_block,x[m_entries[i].m_column]);
+
+        y[row] = sum;
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blSparseBlockMatrix<blDataType>::blVectorType blSparseBlockMatrix<blDataType>::multiplyBlock(const blBlock& block,
+                                                                                                           const blVectorType& x)
+{
+    return blVectorType(block.m_values[0][0] * x.x() + block.m_values[0][1] * x.y() + block.m_values[0][2] * x.z(),
+                        block.m_values[1][0] * x.x() + block.m_values[1][1] * x.y() + block.m_values[1][2] * x.z(),
+                        block.m_values[2][0] * x.x() + block.m_values[2][1] * x.y() + block.m_values[2][2] * x.z());
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_SPARSEBLOCKMATRIX_HPP
@@ -0,0 +1,325 @@
+#ifndef BL_SPATIALHASHGRID_HPP
+#define BL_SPATIALHASHGRID_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blSpatialHashGrid.hpp
+// CLASS:           blSpatialHashGrid
+// BASE CLASS:      None
+//
+// PURPOSE:         A broadphase that drops the boxes into the cells
+//                  of a uniform grid, hashed into a fixed number of
+//                  buckets, and only tests boxes sharing a cell
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blAABB
+//
+// NOTES:           - Works best for crowds of similarly sized bodies,
+//                    with the cell size close to the size of a body
+//                  - A pair of boxes sharing more than one cell is
+//                    only reported by the cell holding the lower corner
+//                    of their overlap, so pairs are never repeated, and
+//                    cells that collide in the same bucket are told
+//                    apart by their coordinates
+//                  - Pairs are returned as indices into the array of
+//                    boxes, with the smaller index first
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blSpatialHashGrid
+{
+public: // Public typedefs
+
+    typedef std::pair<std::size_t,std::size_t>          blPairType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blSpatialHashGrid(const blDataType& cellSize = 1);
+
+    // Destructor
+
+    ~blSpatialHashGrid()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // set/get the size of
+    // the grid's cells
+
+    void                                                setCellSize(const blDataType& cellSize);
+    const blDataType&                                   getCellSize()const;
+
+    // Function used to
+    // find all the pairs
+    // of overlapping boxes
+
+    void                                                findPairs(const std::vector< blAABB<blDataType> >& boxes,
+                                                                  std::vector<blPairType>& pairs);
+
+protected: // Protected functions
+
+    // Functions used to get
+    // the cell coordinate of
+    // a value and the bucket
+    // of a cell
+
+    int                                                 getCellCoordinate(const blDataType& value)const;
+
+    std::size_t                                         getBucket(const int& x,
+                                                                  const int& y,
+                                                                  const int& z)const;
+
+private: // Private variables
+
+    // The size of
+    // the cells
+
+    blDataType                                          m_cellSize;
+
+    // Number of buckets
+    // (a power of two)
+
+    std::size_t                                         m_numberOfBuckets;
+
+    // The cell holding
+    // each box's lower
+    // corner
+
+    std::vector<int>                                    m_lowerCells;
+
+    // Every (box,cell) entry,
+    // first in the order they
+    // were found and then
+    // sorted by bucket
+
+    std::vector<std::size_t>                            m_entryBoxes;
+    std::vector<int>                                    m_entryCells;
+    std::vector<std::size_t>                            m_entryBuckets;
+    std::vector<std::size_t>                            m_bucketStarts;
+    std::vector<std::size_t>                            m_sortedBoxes;
+    std::vector<int>                                    m_sortedCells;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blSpatialHashGrid<blDataType>::blSpatialHashGrid(const blDataType& cellSize)
+{
+    m_cellSize = 1;
+    m_numberOfBuckets = 0;
+
+    setCellSize(cellSize);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSpatialHashGrid<blDataType>::setCellSize(const blDataType& cellSize)
+{
+    if(cellSize > 0)
+        m_cellSize = cellSize;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const blDataType& blSpatialHashGrid<blDataType>::getCellSize()const
+{
+    return m_cellSize;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline int blSpatialHashGrid<blDataType>::getCellCoordinate(const blDataType& value)const
+{
+    return static_cast<int>(std::floor(value / m_cellSize));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blSpatialHashGrid<blDataType>::getBucket(const int& x,
+                                                            const int& y,
+                                                            const int& z)const
+{
+    std::size_t hash = (static_cast<std::size_t>(x) * 73856093u) ^
+                       (static_cast<std::size_t>(y) * 19349663u) ^
+                       (static_cast<std::size_t>(z) * 83492791u);
+
+    return hash & (m_numberOfBuckets - 1);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSpatialHashGrid<blDataType>::findPairs(const std::vector< blAABB<blDataType> >& boxes,
+                                                     std::vector<blPairType>& pairs)
+{
+    pairs.clear();
+
+    m_entryBoxes.clear();
+    m_entryCells.clear();
+
+    m_lowerCells.resize(3 * boxes.size());
+
+    // Step 1:  Find every cell
+    //          touched by every box
+
+    for(std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        int lowerX = getCellCoordinate(boxes[i].getLowerBound().x());
+        int lowerY = getCellCoordinate(boxes[i].getLowerBound().y());
+        int lowerZ = getCellCoordinate(boxes[i].getLowerBound().z());
+        int upperX = getCellCoordinate(boxes[i].getUpperBound().x());
+        int upperY = getCellCoordinate(boxes[i].getUpperBound().y());
+        int upperZ = getCellCoordinate(boxes[i].getUpperBound().z());
+
+        m_lowerCells[3 * i] = lowerX;
+        m_lowerCells[3 * i + 1] = lowerY;
+        m_lowerCells[3 * i + 2] = lowerZ;
+
+        for(int x = lowerX; x <= upperX; ++x)
+        {
+            for(int y = lowerY; y <= upperY; ++y)
+            {
+                for(int z = lowerZ; z <= upperZ; ++z)
+                {
+                    m_entryBoxes.push_back(i);
+                    m_entryCells.push_back(x);
+                    m_entryCells.push_back(y);
+                    m_entryCells.push_back(z);
+                }
+            }
+        }
+    }
+
+    std::size_t numberOfEntries = m_entryBoxes.size();
+
+    // Step 2:  Size the table
+    //          to at least twice
+    //          the entries
+
+    m_numberOfBuckets = 16;
+
+    while(m_numberOfBuckets < 2 * numberOfEntries)
+        m_numberOfBuckets <<= 1;
+
+    // Step 3:  Sort the entries
+    //          by bucket with a
+    //          counting sort, copying
+    //          them so that each
+    //          bucket's entries sit
+    //          next to each other
+
+    m_entryBuckets.resize(numberOfEntries);
+    m_bucketStarts.assign(m_numberOfBuckets + 1,0);
+
+    for(std::size_t i = 0; i < numberOfEntries; ++i)
+    {
+        m_entryBuckets[i] = getBucket(m_entryCells[3 * i],m_entryCells[3 * i + 1],m_entryCells[3 * i + 2]);
+        ++m_bucketStarts[m_entryBuckets[i] + 1];
+    }
+
+    for(std::size_t i = 0; i < m_numberOfBuckets; ++i)
+        m_bucketStarts[i + 1] += m_bucketStarts[i];
+
+    m_sortedBoxes.resize(numberOfEntries);
+    m_sortedCells.resize(3 * numberOfEntries);
+
+    for(std::size_t i = 0; i < numberOfEntries; ++i)
+    {
+        std::size_t position = m_bucketStarts[m_entryBuckets[i]]++;
+
+        m_sortedBoxes[position] = m_entryBoxes[i];
+        m_sortedCells[3 * position] = m_entryCells[3 * i];
+        m_sortedCells[3 * position + 1] = m_entryCells[3 * i + 1];
+        m_sortedCells[3 * position + 2] = m_entryCells[3 * i + 2];
+    }
+
+    // Step 4:  Test the boxes
+    //          sharing a cell, after
+    //          the counting sort each
+    //          bucket's start is now
+    //          its end
+
+    std::size_t bucketStart = 0;
+
+    for(std::size_t bucket = 0; bucket < m_numberOfBuckets; ++bucket)
+    {
+        std::size_t bucketEnd = m_bucketStarts[bucket];
+
+        for(std::size_t i = bucketStart; i + 1 < bucketEnd; ++i)
+        {
+            const int* cell1 = &m_sortedCells[3 * i];
+            std::size_t box1 = m_sortedBoxes[i];
+
+            for(std::size_t j = i + 1; j < bucketEnd; ++j)
+            {
+                const int* cell2 = &m_sortedCells[3 * j];
+                std::size_t box2 = m_sortedBoxes[j];
+
+                // Skip entries of
+                // other cells that
+                // ended up in the
+                // same bucket
+
+                if(cell1[0] != cell2[0] || cell1[1] != cell2[1] || cell1[2] != cell2[2])
+                    continue;
+
+                // Only the cell holding
+                // the overlap's lower
+                // corner reports the pair
+
+                if(std::max(m_lowerCells[3 * box1],m_lowerCells[3 * box2]) != cell1[0] ||
+                   std::max(m_lowerCells[3 * box1 + 1],m_lowerCells[3 * box2 + 1]) != cell1[1] ||
+                   std::max(m_lowerCells[3 * box1 + 2],m_lowerCells[3 * box2 + 2]) != cell1[2])
+                {
+                    continue;
+                }
+
+                if(boxes[box1].overlaps(boxes[box2]))
+                    pairs.push_back(blPairType(std::min(box1,box2),std::max(box1,box2)));
+            }
+        }
+
+        bucketStart = bucketEnd;
+    }
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_SPATIALHASHGRID_HPP
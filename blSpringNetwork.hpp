@@ -0,0 +1,796 @@
+#ifndef BL_SPRINGNETWORK_HPP
+#define BL_SPRINGNETWORK_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blSpringNetwork.hpp
+// CLASS:           blSpringNetwork
+// BASE CLASS:      None
+//
+// PURPOSE:         A structure-of-arrays network of polynomial springs
+//                  (like blPolySpring) between the bodies of a
+//                  blRigidBodyWorld, whose forces are all evaluated
+//                  in one batched pass instead of one virtual call
+//                  per spring
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blRigidBodyWorld -- The bodies the springs
+//                    connect, referenced by their handles
+//                  - blSimdPack, blScalarPack, blVector3dArray
+//                  - blExecutor -- Used to split the passes
+//                    between threads
+//
+// NOTES:           - Every spring keeps numOfCoeffs coefficients,
+//                    extra coefficients are ignored and missing ones
+//                    are zero, so a cubic spring [c0][c1][c2][c3] gives
+//                    force = c0 + c1*x + c2*x*x + c3*x*x*x, evaluated with
+//                    Horner's method as c0 + x*(c1 + x*(c2 + x*c3))
+//                  - Unlike blPolySpring, the anchors are offsets in
+//                    body coordinates that are not scaled by the body's
+//                    size, since blRigidBodyWorld keeps no sizes
+//                  - A pass has three steps, gathering the anchors of
+//                    every spring in system coordinates, evaluating
+//                    all springs with SIMD registers, and adding the
+//                    forces/torques to the bodies
+//                  - The last step runs body by body over a table of
+//                    the springs touching each body, so no two threads
+//                    ever write the same body and the sums come out
+//                    the same for any number of threads
+//                  - Springs attached to removed bodies apply no force,
+//                    even after the world reuses the removed body's
+//                    handle slot, since the old handle's generation
+//                    no longer matches
+//                  - The springs only hold plain data (integer handles,
+//                    anchors, lengths and coefficients), so the network
+//                    can be copied or written out as is
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs = 4>
+class blSpringNetwork
+{
+public: // Public typedefs
+
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+    typedef typename blRigidBodyWorld<blDataType>::blBodyHandle    blBodyHandle;
+
+    typedef blSimdPack<blDataType>                      blPackType;
+    typedef blScalarPack<blDataType>                    blTailPackType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blSpringNetwork();
+
+    // Destructor
+
+    ~blSpringNetwork()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // add/remove springs,
+    // removing a spring moves
+    // the last spring into
+    // its place
+
+    std::size_t                                         addSpring(const blBodyHandle& bodyHandle1,
+                                                                  const blBodyHandle& bodyHandle2,
+                                                                  const blVectorType& anchor1,
+                                                                  const blVectorType& anchor2,
+                                                                  const blDataType& naturalLength,
+                                                                  const std::vector<blDataType>& coeffs);
+
+    void                                                removeSpring(const std::size_t& springIndex);
+
+    void                                                clear();
+    void                                                reserve(const std::size_t& numberOfSprings);
+
+    std::size_t                                         getNumberOfSprings()const;
+
+    // Functions used to
+    // query a spring
+
+    const blBodyHandle&                                 getBodyHandle1(const std::size_t& springIndex)const;
+    const blBodyHandle&                                 getBodyHandle2(const std::size_t& springIndex)const;
+    blVectorType                                        getAnchor1(const std::size_t& springIndex)const;
+    blVectorType                                        getAnchor2(const std::size_t& springIndex)const;
+
+    // Functions used to
+    // set/get a spring's
+    // natural length and
+    // coefficients
+
+    void                                                setNaturalLength(const std::size_t& springIndex,
+                                                                         const blDataType& naturalLength);
+    const blDataType&                                   getNaturalLength(const std::size_t& springIndex)const;
+
+    void                                                setCoeffs(const std::size_t& springIndex,
+                                                                  const std::vector<blDataType>& coeffs);
+    std::vector<blDataType>                             getCoeffs(const std::size_t& springIndex)const;
+
+    // Functions used to
+    // set/get the executor
+    // used to split the
+    // passes between threads
+
+    void                                                setExecutor(const std::shared_ptr<blExecutor>& executor);
+    const std::shared_ptr<blExecutor>&                  getExecutor()const;
+
+    // Function used to
+    // calculate the forces
+    // of all the springs and
+    // add them (and their
+    // torques) to the bodies
+
+    void                                                calculateAndApplyForcesAndTorques(blRigidBodyWorld<blDataType>& world);
+
+    // Function used to get
+    // the force every spring
+    // applied to its first
+    // body in the last pass,
+    // the second body got
+    // the opposite one
+
+    const blVector3dArray<blDataType>&                  getForces()const;
+
+protected: // Protected functions
+
+    // Function used to
+    // rotate a vector by
+    // a unit quaternion
+
+    static blVectorType                                 rotateVector(const blDataType& qw,
+                                                                     const blDataType& qx,
+                                                                     const blDataType& qy,
+                                                                     const blDataType& qz,
+                                                                     const blVectorType& vector);
+
+    // The steps of
+    // a pass over the
+    // springs [beginIndex,endIndex)
+
+    void                                                gatherAnchors(const blRigidBodyWorld<blDataType>& world,
+                                                                      const std::size_t& beginIndex,
+                                                                      const std::size_t& endIndex);
+
+    void                                                evaluateSprings(const std::size_t& beginIndex,
+                                                                        const std::size_t& endIndex);
+
+    // The spring kernel
+    // written once for any
+    // pack type, processes
+    // the springs starting
+    // at index i
+
+    template<typename blPack>
+    void                                                springsKernel(const std::size_t& i);
+
+    // Functions used to
+    // build the table of
+    // springs touching each
+    // body and to add their
+    // forces to the bodies
+    // with handle slots in
+    // [beginSlot,endSlot)
+
+    void                                                buildIncidences();
+
+    void                                                applyForcesAndTorques(blRigidBodyWorld<blDataType>& world,
+                                                                              const std::size_t& beginSlot,
+                                                                              const std::size_t& endSlot)const;
+
+    bool                                                isParallel()const;
+
+private: // Private variables
+
+    // The springs' bodies,
+    // anchors, natural lengths
+    // and coefficients, one
+    // array per coefficient
+
+    std::vector<blBodyHandle>                           m_bodyHandles1;
+    std::vector<blBodyHandle>                           m_bodyHandles2;
+
+    blVector3dArray<blDataType>                         m_anchors1;
+    blVector3dArray<blDataType>                         m_anchors2;
+
+    std::vector<blDataType>                             m_naturalLengths;
+    std::vector<blDataType>                             m_coeffs[numOfCoeffs];
+
+    // The anchors rotated into
+    // system coordinates, the
+    // vector from the first
+    // anchor to the second and
+    // the resulting forces and
+    // torques of the last pass
+
+    blVector3dArray<blDataType>                         m_arms1;
+    blVector3dArray<blDataType>                         m_arms2;
+    blVector3dArray<blDataType>                         m_distances;
+
+    blVector3dArray<blDataType>                         m_forces;
+    blVector3dArray<blDataType>                         m_torques1;
+    blVector3dArray<blDataType>                         m_torques2;
+
+    // The springs touching
+    // the body in handle slot
+    // h are m_incidences from
+    // m_incidenceStarts[h] to
+    // m_incidenceStarts[h + 1],
+    // stored as 2*spring + end
+
+    std::vector<std::size_t>                            m_incidenceStarts;
+    std::vector<std::size_t>                            m_incidences;
+    bool                                                m_areIncidencesDirty;
+
+    // The executor
+
+    std::shared_ptr<blExecutor>                         m_executor;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline blSpringNetwork<blDataType,numOfCoeffs>::blSpringNetwork()
+{
+    m_areIncidencesDirty = true;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline std::size_t blSpringNetwork<blDataType,numOfCoeffs>::addSpring(const blBodyHandle& bodyHandle1,
+                                                                      const blBodyHandle& bodyHandle2,
+                                                                      const blVectorType& anchor1,
+                                                                      const blVectorType& anchor2,
+                                                                      const blDataType& naturalLength,
+                                                                      const std::vector<blDataType>& coeffs)
+{
+    std::size_t springIndex = m_naturalLengths.size();
+
+    m_bodyHandles1.push_back(bodyHandle1);
+    m_bodyHandles2.push_back(bodyHandle2);
+    m_anchors1.push_back(anchor1);
+    m_anchors2.push_back(anchor2);
+    m_naturalLengths.push_back(naturalLength);
+
+    for(int k = 0; k < numOfCoeffs; ++k)
+        m_coeffs[k].push_back(0);
+
+    setCoeffs(springIndex,coeffs);
+
+    m_areIncidencesDirty = true;
+
+    return springIndex;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::removeSpring(const std::size_t& springIndex)
+{
+    if(springIndex >= m_naturalLengths.size())
+        return;
+
+    std::size_t lastIndex = m_naturalLengths.size() - 1;
+
+    if(springIndex != lastIndex)
+    {
+        m_bodyHandles1[springIndex] = m_bodyHandles1[lastIndex];
+        m_bodyHandles2[springIndex] = m_bodyHandles2[lastIndex];
+        m_anchors1.copyVector(lastIndex,springIndex);
+        m_anchors2.copyVector(lastIndex,springIndex);
+        m_naturalLengths[springIndex] = m_naturalLengths[lastIndex];
+
+        for(int k = 0; k < numOfCoeffs; ++k)
+            m_coeffs[k][springIndex] = m_coeffs[k][lastIndex];
+    }
+
+    m_bodyHandles1.pop_back();
+    m_bodyHandles2.pop_back();
+    m_anchors1.pop_back();
+    m_anchors2.pop_back();
+    m_naturalLengths.pop_back();
+
+    for(int k = 0; k < numOfCoeffs; ++k)
+        m_coeffs[k].pop_back();
+
+    m_areIncidencesDirty = true;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::clear()
+{
+    m_bodyHandles1.clear();
+    m_bodyHandles2.clear();
+    m_anchors1.clear();
+    m_anchors2.clear();
+    m_naturalLengths.clear();
+
+    for(int k = 0; k < numOfCoeffs; ++k)
+        m_coeffs[k].clear();
+
+    m_areIncidencesDirty = true;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::reserve(const std::size_t& numberOfSprings)
+{
+    m_bodyHandles1.reserve(numberOfSprings);
+    m_bodyHandles2.reserve(numberOfSprings);
+    m_anchors1.reserve(numberOfSprings);
+    m_anchors2.reserve(numberOfSprings);
+    m_naturalLengths.reserve(numberOfSprings);
+
+    for(int k = 0; k < numOfCoeffs; ++k)
+        m_coeffs[k].reserve(numberOfSprings);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline std::size_t blSpringNetwork<blDataType,numOfCoeffs>::getNumberOfSprings()const
+{
+    return m_naturalLengths.size();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline const typename blSpringNetwork<blDataType,numOfCoeffs>::blBodyHandle& blSpringNetwork<blDataType,numOfCoeffs>::getBodyHandle1(const std::size_t& springIndex)const
+{
+    return m_bodyHandles1[springIndex];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline const typename blSpringNetwork<blDataType,numOfCoeffs>::blBodyHandle& blSpringNetwork<blDataType,numOfCoeffs>::getBodyHandle2(const std::size_t& springIndex)const
+{
+    return m_bodyHandles2[springIndex];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline typename blSpringNetwork<blDataType,numOfCoeffs>::blVectorType blSpringNetwork<blDataType,numOfCoeffs>::getAnchor1(const std::size_t& springIndex)const
+{
+    return m_anchors1.getVector(springIndex);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline typename blSpringNetwork<blDataType,numOfCoeffs>::blVectorType blSpringNetwork<blDataType,numOfCoeffs>::getAnchor2(const std::size_t& springIndex)const
+{
+    return m_anchors2.getVector(springIndex);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::setNaturalLength(const std::size_t& springIndex,
+                                                                      const blDataType& naturalLength)
+{
+    m_naturalLengths[springIndex] = naturalLength;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline const blDataType& blSpringNetwork<blDataType,numOfCoeffs>::getNaturalLength(const std::size_t& springIndex)const
+{
+    return m_naturalLengths[springIndex];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::setCoeffs(const std::size_t& springIndex,
+                                                               const std::vector<blDataType>& coeffs)
+{
+    for(int k = 0; k < numOfCoeffs; ++k)
+        m_coeffs[k][springIndex] = (std::size_t(k) < coeffs.size() ? coeffs[k] : blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline std::vector<blDataType> blSpringNetwork<blDataType,numOfCoeffs>::getCoeffs(const std::size_t& springIndex)const
+{
+    std::vector<blDataType> coeffs(numOfCoeffs);
+
+    for(int k = 0; k < numOfCoeffs; ++k)
+        coeffs[k] = m_coeffs[k][springIndex];
+
+    return coeffs;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::setExecutor(const std::shared_ptr<blExecutor>& executor)
+{
+    m_executor = executor;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline const std::shared_ptr<blExecutor>& blSpringNetwork<blDataType,numOfCoeffs>::getExecutor()const
+{
+    return m_executor;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline const blVector3dArray<blDataType>& blSpringNetwork<blDataType,numOfCoeffs>::getForces()const
+{
+    return m_forces;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline bool blSpringNetwork<blDataType,numOfCoeffs>::isParallel()const
+{
+    return m_executor && m_executor->getNumberOfThreads() > 1;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::calculateAndApplyForcesAndTorques(blRigidBodyWorld<blDataType>& world)
+{
+    std::size_t numberOfSprings = m_naturalLengths.size();
+
+    if(numberOfSprings == 0)
+        return;
+
+    m_arms1.resize(numberOfSprings);
+    m_arms2.resize(numberOfSprings);
+    m_distances.resize(numberOfSprings);
+    m_forces.resize(numberOfSprings);
+    m_torques1.resize(numberOfSprings);
+    m_torques2.resize(numberOfSprings);
+
+    if(m_areIncidencesDirty)
+        buildIncidences();
+
+    std::size_t numberOfSlots = m_incidenceStarts.size() - 1;
+
+    // Gathering and evaluating
+    // only writes the range's own
+    // springs, adding the forces
+    // only writes the range's
+    // own bodies
+
+    if(isParallel())
+    {
+        const blRigidBodyWorld<blDataType>& constWorld = world;
+
+        m_executor->parallelFor(numberOfSprings,
+                                [this,&constWorld](const std::size_t& beginIndex,const std::size_t& endIndex)
+                                {
+                                    gatherAnchors(constWorld,beginIndex,endIndex);
+                                    evaluateSprings(beginIndex,endIndex);
+                                });
+
+        m_executor->parallelFor(numberOfSlots,
+                                [this,&world](const std::size_t& beginSlot,const std::size_t& endSlot)
+                                {
+                                    applyForcesAndTorques(world,beginSlot,endSlot);
+                                });
+    }
+    else
+    {
+        gatherAnchors(world,0,numberOfSprings);
+        evaluateSprings(0,numberOfSprings);
+
+        applyForcesAndTorques(world,0,numberOfSlots);
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline typename blSpringNetwork<blDataType,numOfCoeffs>::blVectorType blSpringNetwork<blDataType,numOfCoeffs>::rotateVector(const blDataType& qw,
+                                                                                                                           const blDataType& qx,
+                                                                                                                           const blDataType& qy,
+                                                                                                                           const blDataType& qz,
+                                                                                                                           const blVectorType& vector)
+{
+    // q*v*q^-1 = v + 2*qw*(u x v) + 2*u x (u x v),
+    // with u = (qx,qy,qz)
+
+    blVectorType u(qx,qy,qz);
+
+    blVectorType uCrossV = crossProduct(u,vector);
+
+    return vector + uCrossV * (blDataType(2) * qw) + crossProduct(u,uCrossV) * blDataType(2);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::gatherAnchors(const blRigidBodyWorld<blDataType>& world,
+                                                                   const std::size_t& beginIndex,
+                                                                   const std::size_t& endIndex)
+{
+    const blVector3dArray<blDataType>& positions = world.getPositions();
+    const blQuaternionArray<blDataType>& rotQtns = world.getRotQtns();
+
+    for(std::size_t i = beginIndex; i < endIndex; ++i)
+    {
+        if(!world.isHandleValid(m_bodyHandles1[i]) || !world.isHandleValid(m_bodyHandles2[i]))
+        {
+            // No distance,
+            // no force
+
+            m_arms1.setVector(i,blVectorType(0,0,0));
+            m_arms2.setVector(i,blVectorType(0,0,0));
+            m_distances.setVector(i,blVectorType(0,0,0));
+
+            continue;
+        }
+
+        std::size_t body1 = world.getBodyIndex(m_bodyHandles1[i]);
+        std::size_t body2 = world.getBodyIndex(m_bodyHandles2[i]);
+
+        blVectorType arm1 = rotateVector(rotQtns.w()[body1],rotQtns.x()[body1],rotQtns.y()[body1],rotQtns.z()[body1],
+                                         m_anchors1.getVector(i));
+
+        blVectorType arm2 = rotateVector(rotQtns.w()[body2],rotQtns.x()[body2],rotQtns.y()[body2],rotQtns.z()[body2],
+                                         m_anchors2.getVector(i));
+
+        m_arms1.setVector(i,arm1);
+        m_arms2.setVector(i,arm2);
+        m_distances.setVector(i,(positions.getVector(body2) + arm2) - (positions.getVector(body1) + arm1));
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::evaluateSprings(const std::size_t& beginIndex,
+                                                                     const std::size_t& endIndex)
+{
+    std::size_t i = beginIndex;
+
+    for(; i + blPackType::width <= endIndex; i += blPackType::width)
+        springsKernel<blPackType>(i);
+
+    for(; i < endIndex; ++i)
+        springsKernel<blTailPackType>(i);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+template<typename blPack>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::springsKernel(const std::size_t& i)
+{
+    typedef typename blPack::blRegisterType R;
+
+    R dx = blPack::load(m_distances.x().data() + i);
+    R dy = blPack::load(m_distances.y().data() + i);
+    R dz = blPack::load(m_distances.z().data() + i);
+
+    // The spring's length,
+    // kept away from zero
+    // (where the distance
+    // and so the force are
+    // zero anyway)
+
+    R length = blPack::sqrt(blPack::max(blPack::mulAdd(dx,dx,blPack::mulAdd(dy,dy,blPack::mul(dz,dz))),
+                                        blPack::set1(std::numeric_limits<blDataType>::min())));
+
+    R elongation = blPack::sub(length,blPack::load(m_naturalLengths.data() + i));
+
+    // The force's magnitude
+    // with Horner's method
+
+    R force = blPack::load(m_coeffs[numOfCoeffs - 1].data() + i);
+
+    for(int k = numOfCoeffs - 2; k >= 0; --k)
+        force = blPack::mulAdd(force,elongation,blPack::load(m_coeffs[k].data() + i));
+
+    // The force on the first
+    // body points along the
+    // spring, the second body
+    // gets the opposite one
+
+    R scale = blPack::div(force,length);
+
+    R fx = blPack::mul(dx,scale);
+    R fy = blPack::mul(dy,scale);
+    R fz = blPack::mul(dz,scale);
+
+    blPack::store(m_forces.x().data() + i,fx);
+    blPack::store(m_forces.y().data() + i,fy);
+    blPack::store(m_forces.z().data() + i,fz);
+
+    // The torques, arm1 x force
+    // and arm2 x -force
+
+    R ax = blPack::load(m_arms1.x().data() + i);
+    R ay = blPack::load(m_arms1.y().data() + i);
+    R az = blPack::load(m_arms1.z().data() + i);
+
+    blPack::store(m_torques1.x().data() + i,blPack::sub(blPack::mul(ay,fz),blPack::mul(az,fy)));
+    blPack::store(m_torques1.y().data() + i,blPack::sub(blPack::mul(az,fx),blPack::mul(ax,fz)));
+    blPack::store(m_torques1.z().data() + i,blPack::sub(blPack::mul(ax,fy),blPack::mul(ay,fx)));
+
+    ax = blPack::load(m_arms2.x().data() + i);
+    ay = blPack::load(m_arms2.y().data() + i);
+    az = blPack::load(m_arms2.z().data() + i);
+
+    blPack::store(m_torques2.x().data() + i,blPack::sub(blPack::mul(az,fy),blPack::mul(ay,fz)));
+    blPack::store(m_torques2.y().data() + i,blPack::sub(blPack::mul(ax,fz),blPack::mul(az,fx)));
+    blPack::store(m_torques2.z().data() + i,blPack::sub(blPack::mul(ay,fx),blPack::mul(ax,fy)));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::buildIncidences()
+{
+    std::size_t numberOfSprings = m_naturalLengths.size();
+
+    // Step 1:  Count the springs
+    //          touching each
+    //          handle slot
+
+    std::size_t numberOfSlots = 0;
+
+    for(std::size_t i = 0; i < numberOfSprings; ++i)
+    {
+        numberOfSlots = std::max(numberOfSlots,
+                                 std::max(blRigidBodyWorld<blDataType>::getHandleSlot(m_bodyHandles1[i]),
+                                          blRigidBodyWorld<blDataType>::getHandleSlot(m_bodyHandles2[i])) + 1);
+    }
+
+    m_incidenceStarts.assign(numberOfSlots + 1,0);
+
+    for(std::size_t i = 0; i < numberOfSprings; ++i)
+    {
+        ++m_incidenceStarts[blRigidBodyWorld<blDataType>::getHandleSlot(m_bodyHandles1[i]) + 1];
+        ++m_incidenceStarts[blRigidBodyWorld<blDataType>::getHandleSlot(m_bodyHandles2[i]) + 1];
+    }
+
+    for(std::size_t h = 0; h < numberOfSlots; ++h)
+        m_incidenceStarts[h + 1] += m_incidenceStarts[h];
+
+    // Step 2:  List them in
+    //          spring order
+
+    m_incidences.resize(2 * numberOfSprings);
+
+    std::vector<std::size_t> positions(m_incidenceStarts.begin(),m_incidenceStarts.end() - 1);
+
+    for(std::size_t i = 0; i < numberOfSprings; ++i)
+    {
+        m_incidences[positions[blRigidBodyWorld<blDataType>::getHandleSlot(m_bodyHandles1[i])]++] = 2 * i;
+        m_incidences[positions[blRigidBodyWorld<blDataType>::getHandleSlot(m_bodyHandles2[i])]++] = 2 * i + 1;
+    }
+
+    m_areIncidencesDirty = false;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType,int numOfCoeffs>
+inline void blSpringNetwork<blDataType,numOfCoeffs>::applyForcesAndTorques(blRigidBodyWorld<blDataType>& world,
+                                                                           const std::size_t& beginSlot,
+                                                                           const std::size_t& endSlot)const
+{
+    blVector3dArray<blDataType>& totalForces = world.getTotalForces();
+    blVector3dArray<blDataType>& totalTorques = world.getTotalTorques();
+
+    for(std::size_t h = beginSlot; h < endSlot; ++h)
+    {
+        // A slot can hold springs
+        // to a removed body and to
+        // the body that reused the
+        // slot, only the ones with
+        // a valid handle count
+
+        bool hasValidHandle = false;
+        blBodyHandle bodyHandle = 0;
+
+        blVectorType force(0,0,0);
+        blVectorType torque(0,0,0);
+
+        for(std::size_t j = m_incidenceStarts[h]; j < m_incidenceStarts[h + 1]; ++j)
+        {
+            std::size_t springIndex = m_incidences[j] / 2;
+
+            const blBodyHandle& springHandle = (m_incidences[j] % 2 == 0 ? m_bodyHandles1[springIndex] : m_bodyHandles2[springIndex]);
+
+            if(!world.isHandleValid(springHandle))
+                continue;
+
+            hasValidHandle = true;
+            bodyHandle = springHandle;
+
+            if(m_incidences[j] % 2 == 0)
+            {
+                force += m_forces.getVector(springIndex);
+                torque += m_torques1.getVector(springIndex);
+            }
+            else
+            {
+                force -= m_forces.getVector(springIndex);
+                torque += m_torques2.getVector(springIndex);
+            }
+        }
+
+        if(!hasValidHandle)
+            continue;
+
+        std::size_t bodyIndex = world.getBodyIndex(bodyHandle);
+
+        totalForces.addToVector(bodyIndex,force);
+        totalTorques.addToVector(bodyIndex,torque);
+    }
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_SPRINGNETWORK_HPP
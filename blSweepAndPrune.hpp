@@ -0,0 +1,379 @@
+#ifndef BL_SWEEPANDPRUNE_HPP
+#define BL_SWEEPANDPRUNE_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blSweepAndPrune.hpp
+// CLASS:           blSweepAndPrune
+// BASE CLASS:      None
+//
+// PURPOSE:         A broadphase that keeps the boxes' end points
+//                  sorted along one axis and sweeps through them
+//                  to find the pairs of boxes that overlap
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - blAABB
+//
+// NOTES:           - The sorted end points are kept from one update
+//                    to the next and re-sorted with an insertion sort,
+//                    which is close to linear when bodies only move a
+//                    little between steps (coherent scenes)
+//                  - When the number of boxes changes the order from
+//                    the last update means nothing, so the end points
+//                    are sorted from scratch with std::sort instead
+//                  - Pairs are returned as indices into the array of
+//                    boxes, with the smaller index first
+//                  - The sort axis should be the one along which the
+//                    bodies are most spread out
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blSweepAndPrune
+{
+public: // Public typedefs
+
+    typedef std::pair<std::size_t,std::size_t>          blPairType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blSweepAndPrune(const int& sortAxis = 0);
+
+    // Destructor
+
+    ~blSweepAndPrune()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // set/get the axis
+    // (0,1,2 for x,y,z)
+    // along which the end
+    // points are sorted
+
+    void                                                setSortAxis(const int& sortAxis);
+    const int&                                          getSortAxis()const;
+
+    // Function used to
+    // update the boxes and
+    // re-sort the end points
+
+    void                                                update(const std::vector< blAABB<blDataType> >& boxes);
+
+    // Function used to
+    // find all the pairs of
+    // overlapping boxes since
+    // the last update
+
+    void                                                findPairs(std::vector<blPairType>& pairs);
+
+    // Function used to
+    // forget all the boxes
+
+    void                                                clear();
+
+protected: // Protected functions
+
+private: // Private variables
+
+    // The axis used
+    // for sorting
+
+    int                                                 m_sortAxis;
+
+    // The bounds of the boxes
+    // from the last update, one
+    // array per axis, so that the
+    // sweep reads them straight
+    // from memory
+
+    std::vector<blDataType>                             m_lowerBounds[3];
+    std::vector<blDataType>                             m_upperBounds[3];
+
+    // The sorted end points,
+    // each id is boxIndex*2
+    // for a lower bound and
+    // boxIndex*2 + 1 for an
+    // upper bound
+
+    std::vector<blDataType>                             m_endPointValues;
+    std::vector<std::size_t>                            m_endPointIDs;
+
+    // Boxes open during the
+    // sweep, along with their
+    // bounds on the other two
+    // axes, packed together so
+    // the sweep reads them in
+    // order
+
+    std::vector<std::size_t>                            m_activeBoxes;
+    std::vector<std::size_t>                            m_activePositions;
+    std::vector<blDataType>                             m_activeBounds;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blSweepAndPrune<blDataType>::blSweepAndPrune(const int& sortAxis)
+{
+    setSortAxis(sortAxis);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSweepAndPrune<blDataType>::setSortAxis(const int& sortAxis)
+{
+    m_sortAxis = std::min(std::max(sortAxis,0),2);
+
+    // The end points have
+    // to be sorted again
+    // from scratch
+
+    clear();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const int& blSweepAndPrune<blDataType>::getSortAxis()const
+{
+    return m_sortAxis;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSweepAndPrune<blDataType>::clear()
+{
+    for(int axis = 0; axis < 3; ++axis)
+    {
+        m_lowerBounds[axis].clear();
+        m_upperBounds[axis].clear();
+    }
+
+    m_endPointValues.clear();
+    m_endPointIDs.clear();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSweepAndPrune<blDataType>::update(const std::vector< blAABB<blDataType> >& boxes)
+{
+    // Step 1:  If the number of
+    //          boxes changed we start
+    //          over from an unsorted
+    //          list of end points
+
+    bool isSortingFromScratch = (boxes.size() != m_lowerBounds[0].size());
+
+    if(isSortingFromScratch)
+    {
+        m_endPointIDs.resize(2 * boxes.size());
+
+        for(std::size_t i = 0; i < m_endPointIDs.size(); ++i)
+            m_endPointIDs[i] = i;
+    }
+
+    // Step 2:  Copy the bounds
+
+    for(int axis = 0; axis < 3; ++axis)
+    {
+        m_lowerBounds[axis].resize(boxes.size());
+        m_upperBounds[axis].resize(boxes.size());
+    }
+
+    for(std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        m_lowerBounds[0][i] = boxes[i].getLowerBound().x();
+        m_lowerBounds[1][i] = boxes[i].getLowerBound().y();
+        m_lowerBounds[2][i] = boxes[i].getLowerBound().z();
+        m_upperBounds[0][i] = boxes[i].getUpperBound().x();
+        m_upperBounds[1][i] = boxes[i].getUpperBound().y();
+        m_upperBounds[2][i] = boxes[i].getUpperBound().z();
+    }
+
+    // Step 3:  Starting over we
+    //          sort the end points
+    //          with std::sort, the
+    //          insertion sort is only
+    //          cheap when the order
+    //          from the last update
+    //          is nearly right
+
+    if(isSortingFromScratch)
+    {
+        const std::vector<blDataType>& lowerBounds = m_lowerBounds[m_sortAxis];
+        const std::vector<blDataType>& upperBounds = m_upperBounds[m_sortAxis];
+
+        std::sort(m_endPointIDs.begin(),
+                  m_endPointIDs.end(),
+                  [&lowerBounds,&upperBounds](const std::size_t& endPointA,const std::size_t& endPointB)
+                  {
+                      blDataType valueA = (endPointA & 1) ? upperBounds[endPointA >> 1] : lowerBounds[endPointA >> 1];
+                      blDataType valueB = (endPointB & 1) ? upperBounds[endPointB >> 1] : lowerBounds[endPointB >> 1];
+
+                      return (valueA < valueB ||
+                              (valueA == valueB && !(endPointA & 1) && (endPointB & 1)));
+                  });
+    }
+
+    // Step 4:  Refresh the
+    //          end point values
+
+    m_endPointValues.resize(m_endPointIDs.size());
+
+    for(std::size_t i = 0; i < m_endPointIDs.size(); ++i)
+    {
+        std::size_t boxIndex = m_endPointIDs[i] >> 1;
+
+        m_endPointValues[i] = (m_endPointIDs[i] & 1) ? m_upperBounds[m_sortAxis][boxIndex] : m_lowerBounds[m_sortAxis][boxIndex];
+    }
+
+    // Step 5:  Insertion sort, lower
+    //          bounds go before upper
+    //          bounds with the same
+    //          value so that touching
+    //          boxes count as overlapping
+
+    if(isSortingFromScratch)
+        return;
+
+    for(std::size_t i = 1; i < m_endPointValues.size(); ++i)
+    {
+        blDataType value = m_endPointValues[i];
+        std::size_t endPointID = m_endPointIDs[i];
+
+        std::size_t j = i;
+
+        while(j > 0 &&
+              (m_endPointValues[j - 1] > value ||
+               (m_endPointValues[j - 1] == value && (m_endPointIDs[j - 1] & 1) && !(endPointID & 1))))
+        {
+            m_endPointValues[j] = m_endPointValues[j - 1];
+            m_endPointIDs[j] = m_endPointIDs[j - 1];
+            --j;
+        }
+
+        m_endPointValues[j] = value;
+        m_endPointIDs[j] = endPointID;
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blSweepAndPrune<blDataType>::findPairs(std::vector<blPairType>& pairs)
+{
+    pairs.clear();
+
+    m_activeBoxes.clear();
+    m_activeBounds.clear();
+    m_activePositions.resize(m_lowerBounds[0].size());
+
+    // The two axes
+    // left to check
+
+    const std::vector<blDataType>& lowerBounds1 = m_lowerBounds[(m_sortAxis + 1) % 3];
+    const std::vector<blDataType>& upperBounds1 = m_upperBounds[(m_sortAxis + 1) % 3];
+    const std::vector<blDataType>& lowerBounds2 = m_lowerBounds[(m_sortAxis + 2) % 3];
+    const std::vector<blDataType>& upperBounds2 = m_upperBounds[(m_sortAxis + 2) % 3];
+
+    for(std::size_t i = 0; i < m_endPointIDs.size(); ++i)
+    {
+        std::size_t boxIndex = m_endPointIDs[i] >> 1;
+
+        if(!(m_endPointIDs[i] & 1))
+        {
+            // A box opens, it
+            // overlaps along the
+            // sort axis with all
+            // the open boxes, so
+            // we check the rest
+
+            const blDataType lower1 = lowerBounds1[boxIndex];
+            const blDataType upper1 = upperBounds1[boxIndex];
+            const blDataType lower2 = lowerBounds2[boxIndex];
+            const blDataType upper2 = upperBounds2[boxIndex];
+
+            const std::size_t numberOfActiveBoxes = m_activeBoxes.size();
+            const blDataType* activeBounds = numberOfActiveBoxes > 0 ? &m_activeBounds[0] : nullptr;
+
+            for(std::size_t j = 0; j < numberOfActiveBoxes; ++j, activeBounds += 4)
+            {
+                if(lower1 <= activeBounds[1] && activeBounds[0] <= upper1 &&
+                   lower2 <= activeBounds[3] && activeBounds[2] <= upper2)
+                {
+                    std::size_t activeBoxIndex = m_activeBoxes[j];
+
+                    pairs.push_back(blPairType(std::min(boxIndex,activeBoxIndex),std::max(boxIndex,activeBoxIndex)));
+                }
+            }
+
+            m_activePositions[boxIndex] = m_activeBoxes.size();
+            m_activeBoxes.push_back(boxIndex);
+
+            m_activeBounds.push_back(lower1);
+            m_activeBounds.push_back(upper1);
+            m_activeBounds.push_back(lower2);
+            m_activeBounds.push_back(upper2);
+        }
+        else
+        {
+            // A box closes, we
+            // move the last open
+            // box into its spot
+            // and drop it
+
+            std::size_t position = m_activePositions[boxIndex];
+            std::size_t lastPosition = m_activeBoxes.size() - 1;
+            std::size_t lastBoxIndex = m_activeBoxes[lastPosition];
+
+            m_activeBoxes[position] = lastBoxIndex;
+            m_activePositions[lastBoxIndex] = position;
+
+            for(std::size_t k = 0; k < 4; ++k)
+                m_activeBounds[4 * position + k] = m_activeBounds[4 * lastPosition + k];
+
+            m_activeBoxes.pop_back();
+            m_activeBounds.resize(4 * lastPosition);
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_SWEEPANDPRUNE_HPP
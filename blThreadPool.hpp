@@ -0,0 +1,310 @@
+#ifndef BL_THREADPOOL_HPP
+#define BL_THREADPOOL_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blThreadPool.hpp
+// CLASS:           blThreadPool
+// BASE CLASS:      blExecutor
+//
+// PURPOSE:         Based on blExecutor, a pool of worker threads
+//                  that run the chunks of a parallelFor loop
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - std::thread, std::mutex, std::condition_variable
+//                  - std::atomic
+//
+// NOTES:           - The range is always split in the same contiguous
+//                    chunks for a given number of items and threads,
+//                    which chunk runs on which thread is not fixed
+//                  - The calling thread takes part in the work, and
+//                    a parallelFor called from inside a task runs
+//                    serially on that thread instead of waiting on
+//                    the pool, so nested loops can't deadlock
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+class blThreadPool : public blExecutor
+{
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blThreadPool(const std::size_t& numberOfThreads = std::thread::hardware_concurrency());
+
+    // Destructor
+
+    ~blThreadPool();
+
+private: // Non-copyable
+
+    blThreadPool(const blThreadPool&);
+    blThreadPool&                                       operator=(const blThreadPool&);
+
+public: // Public functions
+
+    // Function used to
+    // run a task over the
+    // range [0,numberOfItems)
+    // using all the threads
+
+    virtual void                                        parallelFor(const std::size_t& numberOfItems,
+                                                                    const blRangeTaskType& task);
+
+    // Function used to
+    // get the number of
+    // threads, counting
+    // the calling thread
+
+    virtual std::size_t                                 getNumberOfThreads()const;
+
+protected: // Protected functions
+
+    // The loop run by
+    // every worker thread
+
+    void                                                workerLoop();
+
+    // Function used to
+    // grab and run chunks
+    // until there are none
+    // left
+
+    void                                                runChunks();
+
+    // Flag telling whether
+    // the current thread is
+    // already running a task
+
+    static bool&                                        isInsideTask();
+
+private: // Private variables
+
+    // The worker threads
+
+    std::vector<std::thread>                            m_workers;
+
+    // Mutex and conditions
+    // used to wake up workers
+    // and to wait for them
+
+    std::mutex                                          m_mutex;
+    std::mutex                                          m_parallelForMutex;
+    std::condition_variable                             m_wakeCondition;
+    std::condition_variable                             m_doneCondition;
+
+    // The current job
+
+    const blRangeTaskType*                              m_task;
+    std::size_t                                         m_numberOfItems;
+    std::size_t                                         m_numberOfChunks;
+    std::atomic<std::size_t>                            m_nextChunk;
+    std::atomic<std::size_t>                            m_remainingChunks;
+
+    // Bookkeeping of the
+    // workers and jobs
+
+    std::size_t                                         m_generation;
+    std::size_t                                         m_activeWorkers;
+    bool                                                m_shouldStop;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline blThreadPool::blThreadPool(const std::size_t& numberOfThreads)
+                                  : m_task(nullptr),
+                                    m_numberOfItems(0),
+                                    m_numberOfChunks(0),
+                                    m_nextChunk(0),
+                                    m_remainingChunks(0),
+                                    m_generation(0),
+                                    m_activeWorkers(0),
+                                    m_shouldStop(false)
+{
+    // The calling thread
+    // counts as one of the
+    // threads, so we only
+    // spawn the rest
+
+    for(std::size_t i = 1; i < numberOfThreads; ++i)
+        m_workers.push_back(std::thread(&blThreadPool::workerLoop,this));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline blThreadPool::~blThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldStop = true;
+    }
+
+    m_wakeCondition.notify_all();
+
+    for(std::size_t i = 0; i < m_workers.size(); ++i)
+        m_workers[i].join();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline std::size_t blThreadPool::getNumberOfThreads()const
+{
+    return m_workers.size() + 1;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline bool& blThreadPool::isInsideTask()
+{
+    static thread_local bool insideTask = false;
+    return insideTask;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blThreadPool::parallelFor(const std::size_t& numberOfItems,
+                                      const blRangeTaskType& task)
+{
+    if(numberOfItems == 0)
+        return;
+
+    // Nested loops and
+    // tiny loops run right
+    // here on this thread
+
+    if(isInsideTask() || m_workers.empty() || numberOfItems == 1)
+    {
+        task(0,numberOfItems);
+        return;
+    }
+
+    std::lock_guard<std::mutex> parallelForLock(m_parallelForMutex);
+
+    // Step 1:  Publish
+    //          the job
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_task = &task;
+        m_numberOfItems = numberOfItems;
+        m_numberOfChunks = std::min(numberOfItems,getNumberOfThreads());
+        m_nextChunk = 0;
+        m_remainingChunks = m_numberOfChunks;
+        ++m_generation;
+    }
+
+    m_wakeCondition.notify_all();
+
+    // Step 2:  Help out
+    //          with the work
+
+    isInsideTask() = true;
+    runChunks();
+    isInsideTask() = false;
+
+    // Step 3:  Wait for all
+    //          chunks to be done
+    //          and for all workers
+    //          to let go of the job
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_doneCondition.wait(lock,[this]{return m_remainingChunks == 0 && m_activeWorkers == 0;});
+
+    m_task = nullptr;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blThreadPool::workerLoop()
+{
+    isInsideTask() = true;
+
+    std::size_t seenGeneration = 0;
+
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_wakeCondition.wait(lock,[this,&seenGeneration]{return m_shouldStop || m_generation != seenGeneration;});
+
+            if(m_shouldStop)
+                return;
+
+            seenGeneration = m_generation;
+
+            if(m_task == nullptr)
+                continue;
+
+            ++m_activeWorkers;
+        }
+
+        runChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_activeWorkers;
+        }
+
+        m_doneCondition.notify_all();
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blThreadPool::runChunks()
+{
+    while(true)
+    {
+        std::size_t chunk = m_nextChunk.fetch_add(1);
+
+        if(chunk >= m_numberOfChunks)
+            break;
+
+        std::size_t beginIndex = (chunk * m_numberOfItems) / m_numberOfChunks;
+        std::size_t endIndex = ((chunk + 1) * m_numberOfItems) / m_numberOfChunks;
+
+        (*m_task)(beginIndex,endIndex);
+
+        if(m_remainingChunks.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_doneCondition.notify_all();
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_THREADPOOL_HPP
@@ -0,0 +1,316 @@
+#ifndef BL_VECTOR3DARRAY_HPP
+#define BL_VECTOR3DARRAY_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blVector3dArray.hpp
+// CLASS:           blVector3dArray
+// BASE CLASS:      None
+//
+// PURPOSE:         A structure-of-arrays container of 3d vectors,
+//                  where the x, y and z components of all the
+//                  vectors are stored in three separate contiguous
+//                  arrays
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    blMathAPI::blVector3d -- From the blMathAPI used to
+//                                           get/set single vectors
+//                  std::vector -- Used to store each component
+//
+// NOTES:           - Used by blRigidBodyWorld so that integration
+//                    loops only stream through the components
+//                    they actually need
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+class blVector3dArray
+{
+public: // Public typedefs
+
+    typedef blMathAPI::blVector3d<blDataType>           blVectorType;
+
+public: // Constructors and destructors
+
+    // Default constructor
+
+    blVector3dArray(const std::size_t& numberOfVectors = 0);
+
+    // Destructor
+
+    ~blVector3dArray()
+    {
+    }
+
+public: // Public functions
+
+    // Functions used to
+    // get/change the
+    // number of vectors
+
+    std::size_t                                         size()const;
+    void                                                resize(const std::size_t& numberOfVectors);
+    void                                                reserve(const std::size_t& numberOfVectors);
+    void                                                clear();
+
+    // Functions used to
+    // add/remove vectors
+    // at the end of the
+    // arrays
+
+    void                                                push_back(const blVectorType& vector);
+    void                                                pop_back();
+
+    // Functions used to
+    // get/set/change a
+    // single vector
+
+    blVectorType                                        getVector(const std::size_t& index)const;
+    void                                                setVector(const std::size_t& index,
+                                                                  const blVectorType& vector);
+    void                                                addToVector(const std::size_t& index,
+                                                                    const blVectorType& vector);
+
+    // Function used to
+    // copy one vector
+    // onto another one
+
+    void                                                copyVector(const std::size_t& fromIndex,
+                                                                   const std::size_t& toIndex);
+
+    // Function used to
+    // zero out all the
+    // vectors
+
+    void                                                setToZero();
+
+    // Functions used to
+    // get the component
+    // arrays
+
+    std::vector<blDataType>&                            x();
+    std::vector<blDataType>&                            y();
+    std::vector<blDataType>&                            z();
+
+    const std::vector<blDataType>&                      x()const;
+    const std::vector<blDataType>&                      y()const;
+    const std::vector<blDataType>&                      z()const;
+
+private: // Private variables
+
+    // The component
+    // arrays
+
+    std::vector<blDataType>                             m_x;
+    std::vector<blDataType>                             m_y;
+    std::vector<blDataType>                             m_z;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline blVector3dArray<blDataType>::blVector3dArray(const std::size_t& numberOfVectors)
+{
+    resize(numberOfVectors);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::size_t blVector3dArray<blDataType>::size()const
+{
+    return m_x.size();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blVector3dArray<blDataType>::resize(const std::size_t& numberOfVectors)
+{
+    m_x.resize(numberOfVectors,0);
+    m_y.resize(numberOfVectors,0);
+    m_z.resize(numberOfVectors,0);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blVector3dArray<blDataType>::reserve(const std::size_t& numberOfVectors)
+{
+    m_x.reserve(numberOfVectors);
+    m_y.reserve(numberOfVectors);
+    m_z.reserve(numberOfVectors);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blVector3dArray<blDataType>::clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blVector3dArray<blDataType>::push_back(const blVectorType& vector)
+{
+    m_x.push_back(vector.x());
+    m_y.push_back(vector.y());
+    m_z.push_back(vector.z());
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blVector3dArray<blDataType>::pop_back()
+{
+    m_x.pop_back();
+    m_y.pop_back();
+    m_z.pop_back();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline typename blVector3dArray<blDataType>::blVectorType blVector3dArray<blDataType>::getVector(const std::size_t& index)const
+{
+    return blVectorType(m_x[index],m_y[index],m_z[index]);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blVector3dArray<blDataType>::setVector(const std::size_t& index,
+                                                   const blVectorType& vector)
+{
+    m_x[index] = vector.x();
+    m_y[index] = vector.y();
+    m_z[index] = vector.z();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blVector3dArray<blDataType>::addToVector(const std::size_t& index,
+                                                     const blVectorType& vector)
+{
+    m_x[index] += vector.x();
+    m_y[index] += vector.y();
+    m_z[index] += vector.z();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blVector3dArray<blDataType>::copyVector(const std::size_t& fromIndex,
+                                                    const std::size_t& toIndex)
+{
+    m_x[toIndex] = m_x[fromIndex];
+    m_y[toIndex] = m_y[fromIndex];
+    m_z[toIndex] = m_z[fromIndex];
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline void blVector3dArray<blDataType>::setToZero()
+{
+    std::fill(m_x.begin(),m_x.end(),blDataType(0));
+    std::fill(m_y.begin(),m_y.end(),blDataType(0));
+    std::fill(m_z.begin(),m_z.end(),blDataType(0));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blVector3dArray<blDataType>::x()
+{
+    return m_x;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blVector3dArray<blDataType>::y()
+{
+    return m_y;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline std::vector<blDataType>& blVector3dArray<blDataType>::z()
+{
+    return m_z;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blVector3dArray<blDataType>::x()const
+{
+    return m_x;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blVector3dArray<blDataType>::y()const
+{
+    return m_y;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+template<typename blDataType>
+inline const std::vector<blDataType>& blVector3dArray<blDataType>::z()const
+{
+    return m_z;
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_VECTOR3DARRAY_HPP
@@ -68,6 +68,18 @@ public: // Constructors and destructors
     template<typename blDataType2>
     blVelocity(const blVelocity<blDataType2>& velocity);
 
+    // Copy and move
+    // constructors
+
+    blVelocity(const blVelocity<blDataType>& velocity) = default;
+    blVelocity(blVelocity<blDataType>&& velocity) = default;
+
+    // Copy and move
+    // assignments
+
+    blVelocity<blDataType>&                             operator=(const blVelocity<blDataType>& velocity) = default;
+    blVelocity<blDataType>&                             operator=(blVelocity<blDataType>&& velocity) = default;
+
     // Destructor
 
     ~blVelocity()
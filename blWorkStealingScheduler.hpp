@@ -0,0 +1,488 @@
+#ifndef BL_WORKSTEALINGSCHEDULER_HPP
+#define BL_WORKSTEALINGSCHEDULER_HPP
+
+
+//-------------------------------------------------------------------
+// FILE:            blWorkStealingScheduler.hpp
+// CLASS:           blWorkStealingScheduler
+// BASE CLASS:      blExecutor
+//
+// PURPOSE:         Based on blExecutor, a pool of worker threads each
+//                  with its own queue of ranges, idle workers steal
+//                  ranges from the others so uneven tasks still keep
+//                  every thread busy
+//
+// AUTHOR:          Vincenzo Barbato
+//                  http://www.barbatolabs.com
+//                  navyenzo@gmail.com
+//
+// LISENSE:         MIT-LICENCE
+//                  http://www.opensource.org/licenses/mit-license.php
+//
+// DEPENDENCIES:    - std::thread, std::mutex, std::condition_variable
+//                  - std::atomic, std::deque
+//
+// NOTES:           - A range bigger than the grain size is split in
+//                    half, the second half is pushed on the worker's
+//                    queue and the first half is split again, so big
+//                    ranges are left at the front of the queues where
+//                    thieves take them from
+//                  - A worker takes the ranges it pushed last (still
+//                    hot in its cache) and steals the oldest ones
+//                    from the others
+//                  - A parallelFor called from inside a task pushes
+//                    its ranges on the same queues, and while waiting
+//                    for them the thread keeps running other ranges,
+//                    so nested loops run in parallel too
+//                  - The calling thread takes part in the work, other
+//                    threads calling parallelFor at the same time wait
+//                    for their turn
+//                  - Which range runs on which thread is not fixed, so
+//                    tasks must not depend on it
+//
+// DATE CREATED:    Oct/17/2026
+// DATE UPDATED:
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Includes and libs needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+// Enums needed for this file
+//-------------------------------------------------------------------
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+class blWorkStealingScheduler : public blExecutor
+{
+public: // Constructors and destructors
+
+    // Default constructor, a
+    // grain size of zero picks
+    // one for every loop
+
+    blWorkStealingScheduler(const std::size_t& numberOfThreads = std::thread::hardware_concurrency(),
+                            const std::size_t& grainSize = 0);
+
+    // Destructor
+
+    ~blWorkStealingScheduler();
+
+private: // Non-copyable
+
+    blWorkStealingScheduler(const blWorkStealingScheduler&);
+    blWorkStealingScheduler&                            operator=(const blWorkStealingScheduler&);
+
+public: // Public functions
+
+    // Function used to
+    // run a task over the
+    // range [0,numberOfItems)
+    // using all the threads
+
+    virtual void                                        parallelFor(const std::size_t& numberOfItems,
+                                                                    const blRangeTaskType& task);
+
+    // Function used to
+    // get the number of
+    // threads, counting
+    // the calling thread
+
+    virtual std::size_t                                 getNumberOfThreads()const;
+
+    // Functions used to
+    // set/get the size under
+    // which ranges are not
+    // split any further
+
+    void                                                setGrainSize(const std::size_t& grainSize);
+    const std::size_t&                                  getGrainSize()const;
+
+private: // Private types
+
+    // A parallelFor call
+
+    struct blJob
+    {
+        const blRangeTaskType*                          m_task;
+        std::size_t                                     m_grainSize;
+        std::atomic<std::size_t>                        m_remainingItems;
+    };
+
+    // A piece of a job
+    // waiting to be run
+
+    struct blRange
+    {
+        blJob*                                          m_job;
+        std::size_t                                     m_beginIndex;
+        std::size_t                                     m_endIndex;
+    };
+
+    // A worker's queue
+
+    struct blWorkerQueue
+    {
+        std::mutex                                      m_mutex;
+        std::deque<blRange>                             m_ranges;
+    };
+
+protected: // Protected functions
+
+    // The loop run by
+    // every worker thread
+
+    void                                                workerLoop(const std::size_t& workerIndex);
+
+    // Function used to split
+    // a range down to the grain
+    // size, queueing the rest,
+    // and to run what's left
+
+    void                                                runRange(blRange range,
+                                                                 const std::size_t& workerIndex);
+
+    // Functions used to take
+    // a range from the worker's
+    // own queue or to steal
+    // one from the others
+
+    bool                                                popRange(const std::size_t& workerIndex,
+                                                                 blRange& range);
+
+    bool                                                stealRange(const std::size_t& workerIndex,
+                                                                   blRange& range);
+
+    // Function used to run
+    // one range from anywhere,
+    // returns false if there
+    // was none
+
+    bool                                                runAnyRange(const std::size_t& workerIndex);
+
+    // Function used to run
+    // ranges until a job is
+    // done
+
+    void                                                helpUntilDone(const blJob& job,
+                                                                      const std::size_t& workerIndex);
+
+    // The index of the worker
+    // running on the current
+    // thread (nullWorker if none)
+
+    static std::size_t&                                 currentWorkerIndex();
+
+    static const std::size_t                            nullWorker = std::size_t(-1);
+
+private: // Private variables
+
+    // The worker threads
+    // and their queues (the
+    // first queue belongs to
+    // the calling thread)
+
+    std::vector<std::thread>                            m_workers;
+    std::vector< std::unique_ptr<blWorkerQueue> >       m_queues;
+
+    // Mutex and condition
+    // used to put idle workers
+    // to sleep between loops
+
+    std::mutex                                          m_mutex;
+    std::mutex                                          m_parallelForMutex;
+    std::condition_variable                             m_wakeCondition;
+
+    // Bookkeeping
+
+    std::size_t                                         m_grainSize;
+    std::atomic<std::size_t>                            m_numberOfActiveLoops;
+    bool                                                m_shouldStop;
+};
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline blWorkStealingScheduler::blWorkStealingScheduler(const std::size_t& numberOfThreads,
+                                                        const std::size_t& grainSize)
+                                                        : m_grainSize(grainSize),
+                                                          m_numberOfActiveLoops(0),
+                                                          m_shouldStop(false)
+{
+    std::size_t totalNumberOfThreads = std::max(numberOfThreads,std::size_t(1));
+
+    for(std::size_t i = 0; i < totalNumberOfThreads; ++i)
+        m_queues.push_back(std::unique_ptr<blWorkerQueue>(new blWorkerQueue()));
+
+    // The calling thread
+    // counts as one of the
+    // threads, so we only
+    // spawn the rest
+
+    for(std::size_t i = 1; i < totalNumberOfThreads; ++i)
+        m_workers.push_back(std::thread(&blWorkStealingScheduler::workerLoop,this,i));
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline blWorkStealingScheduler::~blWorkStealingScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shouldStop = true;
+    }
+
+    m_wakeCondition.notify_all();
+
+    for(std::size_t i = 0; i < m_workers.size(); ++i)
+        m_workers[i].join();
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline std::size_t blWorkStealingScheduler::getNumberOfThreads()const
+{
+    return m_workers.size() + 1;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blWorkStealingScheduler::setGrainSize(const std::size_t& grainSize)
+{
+    m_grainSize = grainSize;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline const std::size_t& blWorkStealingScheduler::getGrainSize()const
+{
+    return m_grainSize;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline std::size_t& blWorkStealingScheduler::currentWorkerIndex()
+{
+    static thread_local std::size_t workerIndex = nullWorker;
+    return workerIndex;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blWorkStealingScheduler::parallelFor(const std::size_t& numberOfItems,
+                                                 const blRangeTaskType& task)
+{
+    if(numberOfItems == 0)
+        return;
+
+    if(m_workers.empty() || numberOfItems == 1)
+    {
+        task(0,numberOfItems);
+        return;
+    }
+
+    // Step 1:  Set up the job,
+    //          by default about eight
+    //          ranges per thread
+
+    blJob job;
+
+    job.m_task = &task;
+    job.m_grainSize = (m_grainSize > 0) ? m_grainSize : std::max(numberOfItems / (8 * getNumberOfThreads()),std::size_t(1));
+    job.m_remainingItems = numberOfItems;
+
+    blRange range = {&job,0,numberOfItems};
+
+    // Step 2:  A nested loop
+    //          runs on the worker
+    //          that called it
+
+    std::size_t workerIndex = currentWorkerIndex();
+
+    if(workerIndex != nullWorker)
+    {
+        runRange(range,workerIndex);
+        helpUntilDone(job,workerIndex);
+        return;
+    }
+
+    // Step 3:  Otherwise this
+    //          thread becomes the
+    //          first worker and wakes
+    //          up the others
+
+    std::lock_guard<std::mutex> parallelForLock(m_parallelForMutex);
+
+    currentWorkerIndex() = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_numberOfActiveLoops;
+    }
+
+    m_wakeCondition.notify_all();
+
+    runRange(range,0);
+    helpUntilDone(job,0);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_numberOfActiveLoops;
+    }
+
+    currentWorkerIndex() = nullWorker;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blWorkStealingScheduler::workerLoop(const std::size_t& workerIndex)
+{
+    currentWorkerIndex() = workerIndex;
+
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_wakeCondition.wait(lock,[this]{return m_shouldStop || m_numberOfActiveLoops > 0;});
+
+            if(m_shouldStop)
+                return;
+        }
+
+        // Keep looking for work
+        // while a loop is running
+
+        while(m_numberOfActiveLoops > 0)
+        {
+            if(!runAnyRange(workerIndex))
+                std::this_thread::yield();
+        }
+    }
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blWorkStealingScheduler::runRange(blRange range,
+                                              const std::size_t& workerIndex)
+{
+    blJob* job = range.m_job;
+
+    // Step 1:  Split off and
+    //          queue the second
+    //          half until the range
+    //          is small enough
+
+    while(range.m_endIndex - range.m_beginIndex > job->m_grainSize)
+    {
+        std::size_t middleIndex = range.m_beginIndex + (range.m_endIndex - range.m_beginIndex) / 2;
+
+        blRange secondHalf = {job,middleIndex,range.m_endIndex};
+
+        {
+            std::lock_guard<std::mutex> lock(m_queues[workerIndex]->m_mutex);
+            m_queues[workerIndex]->m_ranges.push_back(secondHalf);
+        }
+
+        range.m_endIndex = middleIndex;
+    }
+
+    // Step 2:  Run it, the
+    //          job can be gone
+    //          right after we
+    //          count it as done
+
+    (*job->m_task)(range.m_beginIndex,range.m_endIndex);
+
+    job->m_remainingItems.fetch_sub(range.m_endIndex - range.m_beginIndex);
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline bool blWorkStealingScheduler::popRange(const std::size_t& workerIndex,
+                                              blRange& range)
+{
+    blWorkerQueue& queue = *m_queues[workerIndex];
+
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+    if(queue.m_ranges.empty())
+        return false;
+
+    range = queue.m_ranges.back();
+    queue.m_ranges.pop_back();
+
+    return true;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline bool blWorkStealingScheduler::stealRange(const std::size_t& workerIndex,
+                                                blRange& range)
+{
+    std::size_t numberOfQueues = m_queues.size();
+
+    for(std::size_t i = 1; i < numberOfQueues; ++i)
+    {
+        blWorkerQueue& queue = *m_queues[(workerIndex + i) % numberOfQueues];
+
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+        if(!queue.m_ranges.empty())
+        {
+            range = queue.m_ranges.front();
+            queue.m_ranges.pop_front();
+
+            return true;
+        }
+    }
+
+    return false;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline bool blWorkStealingScheduler::runAnyRange(const std::size_t& workerIndex)
+{
+    blRange range;
+
+    if(!popRange(workerIndex,range) && !stealRange(workerIndex,range))
+        return false;
+
+    runRange(range,workerIndex);
+
+    return true;
+}
+//-------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------
+inline void blWorkStealingScheduler::helpUntilDone(const blJob& job,
+                                                   const std::size_t& workerIndex)
+{
+    while(job.m_remainingItems > 0)
+    {
+        if(!runAnyRange(workerIndex))
+            std::this_thread::yield();
+    }
+}
+//-------------------------------------------------------------------
+
+
+#endif // BL_WORKSTEALINGSCHEDULER_HPP